@@ -32,7 +32,7 @@ public:
     // Creature
     bool CanCreatureGossipHello(Player* player, Creature* creature) override
     {
-        if (sEluna->OnGossipHello(player, creature))
+        if (Eluna::GetStateFor(creature)->OnGossipHello(player, creature))
             return true;
 
         return false;
@@ -40,7 +40,7 @@ public:
 
     bool CanCreatureGossipSelect(Player* player, Creature* creature, uint32 sender, uint32 action) override
     {
-        if (sEluna->OnGossipSelect(player, creature, sender, action))
+        if (Eluna::GetStateFor(creature)->OnGossipSelect(player, creature, sender, action))
             return true;
 
         return false;
@@ -48,7 +48,7 @@ public:
 
     bool CanCreatureGossipSelectCode(Player* player, Creature* creature, uint32 sender, uint32 action, const char* code) override
     {
-        if (sEluna->OnGossipSelectCode(player, creature, sender, action, code))
+        if (Eluna::GetStateFor(creature)->OnGossipSelectCode(player, creature, sender, action, code))
             return true;
 
         return false;
@@ -56,7 +56,7 @@ public:
 
     void OnCreatureAddWorld(Creature* creature) override
     {
-        sEluna->OnAddToWorld(creature);
+        Eluna::GetStateFor(creature)->OnAddToWorld(creature);
 
         if (creature->IsGuardian() && creature->ToTempSummon() && creature->ToTempSummon()->GetSummonerGUID().IsPlayer())
             sEluna->OnPetAddedToWorld(creature->ToTempSummon()->GetSummonerUnit()->ToPlayer(), creature);
@@ -64,18 +64,18 @@ public:
 
     void OnCreatureRemoveWorld(Creature* creature) override
     {
-        sEluna->OnRemoveFromWorld(creature);
+        Eluna::GetStateFor(creature)->OnRemoveFromWorld(creature);
     }
 
     bool CanCreatureQuestAccept(Player* player, Creature* creature, Quest const* quest) override
     {
-        sEluna->OnQuestAccept(player, creature, quest);
+        Eluna::GetStateFor(creature)->OnQuestAccept(player, creature, quest);
         return false;
     }
 
     bool CanCreatureQuestReward(Player* player, Creature* creature, Quest const* quest, uint32 opt) override
     {
-        if (sEluna->OnQuestReward(player, creature, quest, opt))
+        if (Eluna::GetStateFor(creature)->OnQuestReward(player, creature, quest, opt))
         {
             ClearGossipMenuFor(player);
             return true;
@@ -86,7 +86,7 @@ public:
 
     CreatureAI* GetCreatureAI(Creature* creature) const override
     {
-        if (CreatureAI* luaAI = sEluna->GetAI(creature))
+        if (CreatureAI* luaAI = Eluna::GetStateFor(creature)->GetAI(creature))
             return luaAI;
 
         return nullptr;
@@ -100,25 +100,25 @@ public:
 
     void OnGameObjectAddWorld(GameObject* go) override
     {
-        sEluna->OnAddToWorld(go);
+        Eluna::GetStateFor(go)->OnAddToWorld(go);
     }
 
     void OnGameObjectRemoveWorld(GameObject* go) override
     {
-        sEluna->OnRemoveFromWorld(go);
+        Eluna::GetStateFor(go)->OnRemoveFromWorld(go);
     }
 
     void OnGameObjectUpdate(GameObject* go, uint32 diff) override
     {
-        sEluna->UpdateAI(go, diff);
+        Eluna::GetStateFor(go)->UpdateAI(go, diff);
     }
 
     bool CanGameObjectGossipHello(Player* player, GameObject* go) override
     {
-        if (sEluna->OnGossipHello(player, go))
+        if (Eluna::GetStateFor(go)->OnGossipHello(player, go))
             return true;
 
-        if (sEluna->OnGameObjectUse(player, go))
+        if (Eluna::GetStateFor(go)->OnGameObjectUse(player, go))
             return true;
 
         return false;
@@ -126,33 +126,33 @@ public:
 
     void OnGameObjectDamaged(GameObject* go, Player* player) override
     {
-        sEluna->OnDamaged(go, player);
+        Eluna::GetStateFor(go)->OnDamaged(go, player);
     }
 
     void OnGameObjectDestroyed(GameObject* go, Player* player) override
     {
-        sEluna->OnDestroyed(go, player);
+        Eluna::GetStateFor(go)->OnDestroyed(go, player);
     }
 
     void OnGameObjectLootStateChanged(GameObject* go, uint32 state, Unit* /*unit*/) override
     {
-        sEluna->OnLootStateChanged(go, state);
+        Eluna::GetStateFor(go)->OnLootStateChanged(go, state);
     }
 
     void OnGameObjectStateChanged(GameObject* go, uint32 state) override
     {
-        sEluna->OnGameObjectStateChanged(go, state);
+        Eluna::GetStateFor(go)->OnGameObjectStateChanged(go, state);
     }
 
     bool CanGameObjectQuestAccept(Player* player, GameObject* go, Quest const* quest) override
     {
-        sEluna->OnQuestAccept(player, go, quest);
+        Eluna::GetStateFor(go)->OnQuestAccept(player, go, quest);
         return false;
     }
 
     bool CanGameObjectGossipSelect(Player* player, GameObject* go, uint32 sender, uint32 action) override
     {
-        if (sEluna->OnGossipSelect(player, go, sender, action))
+        if (Eluna::GetStateFor(go)->OnGossipSelect(player, go, sender, action))
             return true;
 
         return false;
@@ -160,7 +160,7 @@ public:
 
     bool CanGameObjectGossipSelectCode(Player* player, GameObject* go, uint32 sender, uint32 action, const char* code) override
     {
-        if (sEluna->OnGossipSelectCode(player, go, sender, action, code))
+        if (Eluna::GetStateFor(go)->OnGossipSelectCode(player, go, sender, action, code))
             return true;
 
         return false;
@@ -168,10 +168,10 @@ public:
 
     bool CanGameObjectQuestReward(Player* player, GameObject* go, Quest const* quest, uint32 opt) override
     {
-        if (sEluna->OnQuestAccept(player, go, quest))
+        if (Eluna::GetStateFor(go)->OnQuestAccept(player, go, quest))
             return false;
 
-        if (sEluna->OnQuestReward(player, go, quest, opt))
+        if (Eluna::GetStateFor(go)->OnQuestReward(player, go, quest, opt))
             return false;
 
         return true;
@@ -179,7 +179,7 @@ public:
 
     GameObjectAI* GetGameObjectAI(GameObject* go) const override
     {
-        sEluna->OnSpawn(go);
+        Eluna::GetStateFor(go)->OnSpawn(go);
         return nullptr;
     }
 };
@@ -248,37 +248,43 @@ public:
     void OnBeforeCreateInstanceScript(InstanceMap* instanceMap, InstanceScript** instanceData, bool /*load*/, std::string /*data*/, uint32 /*completedEncounterMask*/) override
     {
         if (instanceData)
-            *instanceData = sEluna->GetInstanceData(instanceMap);
+            *instanceData = Eluna::GetStateFor(instanceMap)->GetInstanceData(instanceMap);
     }
 
     void OnDestroyInstance(MapInstanced* /*mapInstanced*/, Map* map) override
     {
-        sEluna->FreeInstanceId(map->GetInstanceId());
+        Eluna::GetStateFor(map)->FreeInstanceId(map->GetInstanceId());
     }
 
     void OnCreateMap(Map* map) override
     {
-        sEluna->OnCreate(map);
+        Eluna::CreateMapState(map);
+        Eluna::GetStateFor(map)->OnCreate(map);
     }
 
     void OnDestroyMap(Map* map) override
     {
-        sEluna->OnDestroy(map);
+        Eluna::GetStateFor(map)->OnDestroy(map);
+        Eluna::DestroyMapState(map);
     }
 
     void OnPlayerEnterAll(Map* map, Player* player) override
     {
-        sEluna->OnPlayerEnter(map, player);
+        Eluna::GetStateFor(map)->OnPlayerEnter(map, player);
     }
 
     void OnPlayerLeaveAll(Map* map, Player* player) override
     {
-        sEluna->OnPlayerLeave(map, player);
+        Eluna::GetStateFor(map)->OnPlayerLeave(map, player);
     }
 
     void OnMapUpdate(Map* map, uint32 diff) override
     {
-        sEluna->OnUpdate(map, diff);
+        Eluna* E = Eluna::GetStateFor(map);
+        if (E != sEluna)
+            E->OnMapStateUpdate(diff);
+        E->eventMgr->UpdateProcessors(map, diff);
+        E->OnUpdate(map, diff);
     }
 };
 
@@ -542,9 +548,9 @@ public:
     void GetDialogStatus(Player* player, Object* questgiver) override
     {
         if (questgiver->GetTypeId() == TYPEID_GAMEOBJECT)
-            sEluna->GetDialogStatus(player, questgiver->ToGameObject());
+            Eluna::GetStateFor(questgiver->ToGameObject())->GetDialogStatus(player, questgiver->ToGameObject());
         else if (questgiver->GetTypeId() == TYPEID_UNIT)
-            sEluna->GetDialogStatus(player, questgiver->ToCreature());
+            Eluna::GetStateFor(questgiver->ToCreature())->GetDialogStatus(player, questgiver->ToCreature());
     }
 };
 
@@ -1048,7 +1054,7 @@ public:
         WORLDOBJECTHOOK_ON_WORLD_OBJECT_DESTROY,
         WORLDOBJECTHOOK_ON_WORLD_OBJECT_CREATE,
         WORLDOBJECTHOOK_ON_WORLD_OBJECT_SET_MAP,
-        WORLDOBJECTHOOK_ON_WORLD_OBJECT_UPDATE
+        WORLDOBJECTHOOK_ON_WORLD_OBJECT_RESET_MAP
     }) { }
 
     void OnWorldObjectDestroy(WorldObject* object) override
@@ -1062,15 +1068,27 @@ public:
         object->elunaEvents = nullptr;
     }
 
-    void OnWorldObjectSetMap(WorldObject* object, Map* /*map*/) override
+    // The processor is created by the first RegisterEvent and ticked by its map, see OnMapUpdate
+    void OnWorldObjectSetMap(WorldObject* object, Map* map) override
     {
         if (!object->elunaEvents)
-            object->elunaEvents = new ElunaEventProcessor(&Eluna::GEluna, object);
+            return;
+
+        // Timed events belong to a Lua state, so they don't follow the object to a map with another state
+        Eluna* state = Eluna::GetStateFor(map);
+        if (object->elunaEvents->GetState() != state)
+        {
+            if (uint32 removed = object->elunaEvents->MoveToState(state))
+                ELUNA_LOG_ERROR("[Eluna]: Removed {} timed events of {} moving to map {}, the map runs in another Lua state", removed, object->GetGUID().ToString(), map->GetId());
+        }
+
+        object->elunaEvents->SetMap(map);
     }
 
-    void OnWorldObjectUpdate(WorldObject* object, uint32 diff) override
+    void OnWorldObjectResetMap(WorldObject* object) override
     {
-        object->elunaEvents->Update(diff);
+        if (object->elunaEvents)
+            object->elunaEvents->SetMap(nullptr);
     }
 };
 
@@ -7,10 +7,14 @@
 #ifndef _BINDING_MAP_H
 #define _BINDING_MAP_H
 
+#include <algorithm>
+#include <atomic>
+#include <bitset>
 #include <memory>
 #include "Common.h"
 #include "ElunaUtility.h"
 #include <type_traits>
+#include <vector>
 
 extern "C"
 {
@@ -18,72 +22,648 @@ extern "C"
 #include "lauxlib.h"
 };
 
+template<typename T> struct EventKey;
+
+// Upper bound for event IDs of any key type, see the *_EVENT_COUNT enums in Hooks.h.
+static const uint32 BINDING_MAX_EVENT_ID = 128;
+
+/*
+ * Hook arguments that bindings can be filtered by, see `BindingFilter`.
+ */
+enum BindingFilterKind
+{
+    BINDING_FILTER_ENTRY,   // Entry of the creature, gameobject or item, or the area trigger ID
+    BINDING_FILTER_SPELL,   // Spell ID
+    BINDING_FILTER_ZONE,    // Zone ID
+    BINDING_FILTER_MAP,     // Map ID
+    BINDING_FILTER_OPCODE,  // Packet opcode
+    BINDING_FILTER_SECURITY,// Account security level, only set by `RegisterCommand`
+    BINDING_FILTER_COUNT
+};
+
+/*
+ * The part of a `BindingMap` that settles the shots of pushed bindings, without knowing its key type.
+ */
+class BindingShots
+{
+public:
+    virtual ~BindingShots() { }
+
+    // Uses up the shot held for binding `id` by `PushRefsFor` if its handler was `called`, otherwise gives it back
+    virtual void SettleShot(uint64 id, bool called) = 0;
+};
+
+// A handler pushed by `PushRefsFor` for a hook, see `Eluna::SetupStack`
+struct PushedBinding
+{
+    uint64 id;
+    BindingShots* shots;    // The map holding a shot of the binding, NULL for bindings without a limit
+    bool stopOnResult;
+
+    PushedBinding(uint64 id, BindingShots* shots, bool stopOnResult) :
+        id(id),
+        shots(shots),
+        stopOnResult(stopOnResult)
+    { }
+
+    // Settles the shot of the binding, once it is known whether the handler is called
+    void Settle(bool called) const
+    {
+        if (shots)
+            shots->SettleShot(id, called);
+    }
+};
+
+/*
+ * The filterable arguments of a single hook call.
+ */
+struct BindingFilterArgs
+{
+    uint32 values[BINDING_FILTER_COUNT];
+    uint8 kinds; // Bit mask of the `BindingFilterKind`s that have a value
+
+    BindingFilterArgs() :
+        kinds(0)
+    { }
+
+    BindingFilterArgs& Set(BindingFilterKind kind, uint32 value)
+    {
+        values[kind] = value;
+        kinds |= 1 << kind;
+        return *this;
+    }
+};
+
+/*
+ * The argument values a binding is registered for.
+ *
+ * A binding with a filter is only pushed for a hook call if, for every kind
+ *   in the filter, the call's argument of that kind is one of the listed values.
+ */
+struct BindingFilter
+{
+    std::vector<uint32> values[BINDING_FILTER_COUNT];
+    uint8 kinds; // Bit mask of the `BindingFilterKind`s that have values
+
+    BindingFilter() :
+        kinds(0)
+    { }
+
+    void Add(BindingFilterKind kind, uint32 value)
+    {
+        values[kind].push_back(value);
+        kinds |= 1 << kind;
+    }
+
+    bool Matches(const BindingFilterArgs* args) const
+    {
+        if (!args || (args->kinds & kinds) != kinds)
+            return false;
+
+        for (uint32 kind = 0; kind < BINDING_FILTER_COUNT; ++kind)
+        {
+            if (!(kinds & (1 << kind)))
+                continue;
+            if (std::find(values[kind].begin(), values[kind].end(), args->values[kind]) == values[kind].end())
+                return false;
+        }
+        return true;
+    }
+
+    /*
+     * The kind the binding is bucketed by in the filter presence bitmap of its `BindingMap`.
+     *
+     * Any kind of the filter works, since a matching call always has a value for all of them.
+     */
+    uint32 GetBucketKind() const
+    {
+        uint32 kind = 0;
+        while (!(kinds & (1 << kind)))
+            ++kind;
+        return kind;
+    }
+};
+
+/*
+ * Whether `K` identifies its bindings by event ID alone.
+ *
+ * For such keys the per-event presence bit is exact, so `HasBindingsFor`
+ *   never has to look any further.
+ */
+template<typename K>
+struct is_event_key : std::false_type { };
+
+template<typename T>
+struct is_event_key< EventKey<T> > : std::true_type { };
+
+/*
+ * Storage of the binding lists of a `BindingMap`, keyed by `K`.
+ *
+ * The generic version is a flat open-addressing hash table (linear probing,
+ *   backward shift deletion), used for `EntryKey` and `UniqueObjectKey`.
+ *   Lists are stored inline in the slots, so a lookup touches one or two
+ *   cache lines instead of chasing hash nodes.
+ */
+template<typename K, typename List, bool = is_event_key<K>::value>
+class BindingStorage
+{
+private:
+    struct Slot
+    {
+        K key;
+        List list;
+        bool occupied;
+
+        Slot() :
+            key(),
+            list(),
+            occupied(false)
+        { }
+    };
+
+    static const uint32 MIN_CAPACITY = 16;
+
+    std::vector<Slot> slots;
+    uint32 count;
+
+    uint32 GetHome(const K& key) const
+    {
+        uint64 hash = static_cast<uint64>(std::hash<K>()(key));
+        return static_cast<uint32>((hash * 0x9E3779B97F4A7C15ULL) >> 32) & (slots.size() - 1);
+    }
+
+    // Returns the slot holding `key`, or the empty slot where it would be inserted.
+    uint32 Probe(const K& key) const
+    {
+        uint32 mask = slots.size() - 1;
+        uint32 i = GetHome(key);
+        while (slots[i].occupied && !std::equal_to<K>()(slots[i].key, key))
+            i = (i + 1) & mask;
+        return i;
+    }
+
+    void Grow()
+    {
+        std::vector<Slot> old(slots.size() * 2);
+        old.swap(slots);
+
+        for (auto itr = old.begin(); itr != old.end(); ++itr)
+        {
+            if (!itr->occupied)
+                continue;
+
+            Slot& slot = slots[Probe(itr->key)];
+            slot.key = itr->key;
+            slot.list.swap(itr->list);
+            slot.occupied = true;
+        }
+    }
+
+public:
+    BindingStorage() :
+        slots(MIN_CAPACITY),
+        count(0)
+    { }
+
+    /*
+     * Returns the list for `key`, or NULL if there is none.
+     */
+    List* Find(const K& key)
+    {
+        Slot& slot = slots[Probe(key)];
+        return slot.occupied ? &slot.list : NULL;
+    }
+
+    /*
+     * Returns the list for `key`, creating an empty one if needed.
+     *
+     * The returned reference is invalidated by the next `Get` or `Erase`.
+     */
+    List& Get(const K& key)
+    {
+        // Keep the load factor at or below 1/2 so probe sequences stay short
+        if ((count + 1) * 2 > slots.size())
+            Grow();
+
+        Slot& slot = slots[Probe(key)];
+        if (!slot.occupied)
+        {
+            slot.key = key;
+            slot.occupied = true;
+            ++count;
+        }
+        return slot.list;
+    }
+
+    /*
+     * Removes the list for `key`, if any.
+     */
+    void Erase(const K& key)
+    {
+        uint32 mask = slots.size() - 1;
+        uint32 hole = Probe(key);
+        if (!slots[hole].occupied)
+            return;
+
+        // Shift following entries of the cluster back into the hole,
+        //   unless that would move them in front of their home slot.
+        for (uint32 i = (hole + 1) & mask; slots[i].occupied; i = (i + 1) & mask)
+        {
+            uint32 home = GetHome(slots[i].key);
+            bool between = hole <= i ? (hole < home && home <= i) : (hole < home || home <= i);
+            if (between)
+                continue;
+
+            slots[hole].key = slots[i].key;
+            slots[hole].list.swap(slots[i].list);
+            hole = i;
+        }
+
+        slots[hole].list.clear();
+        slots[hole].occupied = false;
+        --count;
+    }
+
+    /*
+     * Calls `f` on every stored list.
+     */
+    template<typename F>
+    void ForEach(F f)
+    {
+        for (auto itr = slots.begin(); itr != slots.end(); ++itr)
+            if (itr->occupied)
+                f(itr->list);
+    }
+
+    /*
+     * Removes all lists.
+     */
+    void Clear()
+    {
+        std::vector<Slot>(MIN_CAPACITY).swap(slots);
+        count = 0;
+    }
+};
+
+/*
+ * Event-indexed storage for `EventKey` bindings.
+ *
+ * Event IDs are small enum values, so the lists live in a fixed array
+ *   indexed directly by the event ID and no hashing is done at all.
+ */
+template<typename K, typename List>
+class BindingStorage<K, List, true>
+{
+private:
+    List lists[BINDING_MAX_EVENT_ID];
+
+    static uint32 GetIndex(const K& key)
+    {
+        uint32 index = static_cast<uint32>(key.event_id);
+        ASSERT(index < BINDING_MAX_EVENT_ID);
+        return index;
+    }
+
+public:
+    List* Find(const K& key)
+    {
+        List& list = lists[GetIndex(key)];
+        return list.empty() ? NULL : &list;
+    }
+
+    List& Get(const K& key)
+    {
+        return lists[GetIndex(key)];
+    }
+
+    void Erase(const K& key)
+    {
+        lists[GetIndex(key)].clear();
+    }
+
+    template<typename F>
+    void ForEach(F f)
+    {
+        for (uint32 i = 0; i < BINDING_MAX_EVENT_ID; ++i)
+            if (!lists[i].empty())
+                f(lists[i]);
+    }
+
+    void Clear()
+    {
+        for (uint32 i = 0; i < BINDING_MAX_EVENT_ID; ++i)
+            lists[i].clear();
+    }
+};
+
 
 /*
  * A set of bindings from keys of type `K` to Lua references.
  */
 template<typename K>
-class BindingMap : public ElunaUtil::Lockable
+class BindingMap : public ElunaUtil::Lockable, public BindingShots
 {
+public:
+    typedef std::bitset<BINDING_MAX_EVENT_ID> EventMask;
+
 private:
+    // Number of slots in the hashed key presence filter. Must be a power of two.
+    static const uint32 KEY_PRESENCE_SLOTS = 1 << 15;
+    // Number of slots in the hashed filter argument presence filter. Must be a power of two.
+    static const uint32 FILTER_PRESENCE_SLOTS = 1 << 15;
+
     lua_State* L;
+    // Name of the hook type, used by the hook profiler
+    const char* name;
     uint64 maxBindingID;
 
+    /*
+     * A single binding. Bindings are stored by value and contiguously in their
+     *   key's `BindingList`, so pushing them does not take a cache miss per binding.
+     *
+     * The function reference is released by the `BindingMap` when the binding is removed.
+     */
     struct Binding
     {
         uint64 id;
-        lua_State* L;
         uint32 remainingShots;
+        uint32 pendingShots;    // Shots held by pushes whose handler is not called or skipped yet
+        int32 priority;
         int functionReference;
+        bool stopOnResult;
+        std::shared_ptr<const BindingFilter> filter;
 
-        Binding(lua_State* L, uint64 id, int functionReference, uint32 remainingShots) :
+        Binding(uint64 id, int functionReference, uint32 remainingShots, int32 priority, bool stopOnResult, std::shared_ptr<const BindingFilter> filter) :
             id(id),
-            L(L),
             remainingShots(remainingShots),
-            functionReference(functionReference)
+            pendingShots(0),
+            priority(priority),
+            functionReference(functionReference),
+            stopOnResult(stopOnResult),
+            filter(filter)
         { }
-
-        ~Binding()
-        {
-            luaL_unref(L, LUA_REGISTRYINDEX, functionReference);
-        }
     };
 
-    typedef std::vector< std::unique_ptr<Binding> > BindingList;
+    typedef std::vector<Binding> BindingList;
 
-    std::unordered_map<K, BindingList> bindings;
+    BindingStorage<K, BindingList> bindings;
     /*
      * This table is for fast removal of bindings by ID.
      *
      * Instead of having to look through (potentially) every BindingList to find
      *   the Binding with the right ID, this allows you to go directly to the
-     *   BindingList that might have the Binding with that ID.
+     *   key whose BindingList might have the Binding with that ID.
+     */
+    std::unordered_map<uint64, K> id_lookup_table;
+
+    /*
+     * The events that have bindings, per owner of a key.
+     *
+     * The owner of a key is the key with its event ID zeroed, e.g. the entry
+     *   of an `EntryKey`. This lets callers find out whether e.g. a creature
+     *   entry has any bindings at all with a single lookup.
+     *
+     * Not maintained for keys that consist of the event ID alone.
+     */
+    std::unordered_map<K, EventMask> ownerMasks;
+
+    static K GetOwnerKey(K key)
+    {
+        key.event_id = decltype(key.event_id)();
+        return key;
+    }
+
+    /*
+     * Presence bitmaps that let `HasBindingsFor` answer "no" without taking the lock.
+     *
+     * `eventPresence` has one bit per event ID, set while any binding for that event exists.
+     * `keyPresence` is a counting filter over hashed keys: a clear bit means the key
+     *   certainly has no bindings, a set bit means it might (hash collisions are possible).
+     *
+     * The bits are only written while holding the lock, from the counters below.
+     */
+    std::atomic<uint64> eventPresence[BINDING_MAX_EVENT_ID / 64];
+    std::atomic<uint64> keyPresence[KEY_PRESENCE_SLOTS / 64];
+    uint32 eventCounts[BINDING_MAX_EVENT_ID];
+    std::unordered_map<uint32, uint32> keyCounts;
+
+    /*
+     * Presence bitmaps that let `HasBindingsFor` reject calls whose arguments match no filter.
      *
-     * However, you must be careful not to store pointers to BindingLists
-     *   that no longer exist (see `void Clear(const K& key)` implementation).
+     * `unfilteredPresence` has one bit per event ID, set while the event has a binding without a filter.
+     * `filterPresence` is a counting filter over hashed (event ID, kind, value) triples, each filtered
+     *   binding is counted for every value of its bucket kind (see `BindingFilter::GetBucketKind`).
      */
-    std::unordered_map<uint64, BindingList*> id_lookup_table;
+    std::atomic<uint64> unfilteredPresence[BINDING_MAX_EVENT_ID / 64];
+    std::atomic<uint64> filterPresence[FILTER_PRESENCE_SLOTS / 64];
+    uint32 unfilteredCounts[BINDING_MAX_EVENT_ID];
+    std::unordered_map<uint32, uint32> filterCounts;
+
+    static uint32 GetEventIndex(const K& key)
+    {
+        uint32 index = static_cast<uint32>(key.event_id);
+        ASSERT(index < BINDING_MAX_EVENT_ID);
+        return index;
+    }
+
+    static uint32 GetKeySlot(const K& key)
+    {
+        // Fibonacci hashing spreads the (often identity) std::hash over the filter
+        uint64 hash = static_cast<uint64>(std::hash<K>()(key));
+        return static_cast<uint32>((hash * 0x9E3779B97F4A7C15ULL) >> 49) & (KEY_PRESENCE_SLOTS - 1);
+    }
+
+    static uint32 GetFilterSlot(uint32 event, uint32 kind, uint32 value)
+    {
+        uint64 hash = (uint64(event) << 40) ^ (uint64(kind) << 32) ^ value;
+        return static_cast<uint32>((hash * 0x9E3779B97F4A7C15ULL) >> 49) & (FILTER_PRESENCE_SLOTS - 1);
+    }
+
+    static bool TestBit(const std::atomic<uint64>* bits, uint32 index)
+    {
+        return (bits[index / 64].load(std::memory_order_relaxed) & (uint64(1) << (index % 64))) != 0;
+    }
+
+    static void SetBit(std::atomic<uint64>* bits, uint32 index, bool value)
+    {
+        if (value)
+            bits[index / 64].fetch_or(uint64(1) << (index % 64), std::memory_order_relaxed);
+        else
+            bits[index / 64].fetch_and(~(uint64(1) << (index % 64)), std::memory_order_relaxed);
+    }
+
+    /*
+     * Account for `count` new bindings for `key`. Lock must be held.
+     */
+    void MarkPresent(const K& key, uint32 count = 1)
+    {
+        uint32 event = GetEventIndex(key);
+        if ((eventCounts[event] += count) == count)
+            SetBit(eventPresence, event, true);
+
+        if (is_event_key<K>::value)
+            return;
+
+        uint32 slot = GetKeySlot(key);
+        uint32& slotCount = keyCounts[slot];
+        if ((slotCount += count) == count)
+            SetBit(keyPresence, slot, true);
+    }
+
+    /*
+     * Account for `count` removed bindings for `key`. Lock must be held.
+     */
+    void MarkAbsent(const K& key, uint32 count = 1)
+    {
+        uint32 event = GetEventIndex(key);
+        ASSERT(eventCounts[event] >= count);
+        if ((eventCounts[event] -= count) == 0)
+            SetBit(eventPresence, event, false);
+
+        if (is_event_key<K>::value)
+            return;
+
+        uint32 slot = GetKeySlot(key);
+        auto itr = keyCounts.find(slot);
+        ASSERT(itr != keyCounts.end() && itr->second >= count);
+        if ((itr->second -= count) == 0)
+        {
+            keyCounts.erase(itr);
+            SetBit(keyPresence, slot, false);
+        }
+    }
+
+    /*
+     * Account for the filter of a new (`present`) or removed binding for `key`. Lock must be held.
+     */
+    void MarkFilter(const K& key, const Binding& binding, bool present)
+    {
+        uint32 event = GetEventIndex(key);
+        if (!binding.filter)
+        {
+            if (present ? (++unfilteredCounts[event] == 1) : (--unfilteredCounts[event] == 0))
+                SetBit(unfilteredPresence, event, present);
+            return;
+        }
+
+        uint32 kind = binding.filter->GetBucketKind();
+        const std::vector<uint32>& values = binding.filter->values[kind];
+        for (auto itr = values.begin(); itr != values.end(); ++itr)
+        {
+            uint32 slot = GetFilterSlot(event, kind, *itr);
+            if (present)
+            {
+                if (++filterCounts[slot] == 1)
+                    SetBit(filterPresence, slot, true);
+                continue;
+            }
+
+            auto count = filterCounts.find(slot);
+            ASSERT(count != filterCounts.end() && count->second > 0);
+            if (--count->second == 0)
+            {
+                filterCounts.erase(count);
+                SetBit(filterPresence, slot, false);
+            }
+        }
+    }
+
+    /*
+     * Forget all presence information. Lock must be held.
+     */
+    void ResetPresence()
+    {
+        for (uint32 i = 0; i < BINDING_MAX_EVENT_ID / 64; ++i)
+            eventPresence[i].store(0, std::memory_order_relaxed);
+        for (uint32 i = 0; i < KEY_PRESENCE_SLOTS / 64; ++i)
+            keyPresence[i].store(0, std::memory_order_relaxed);
+        for (uint32 i = 0; i < BINDING_MAX_EVENT_ID; ++i)
+            eventCounts[i] = 0;
+        keyCounts.clear();
+
+        for (uint32 i = 0; i < BINDING_MAX_EVENT_ID / 64; ++i)
+            unfilteredPresence[i].store(0, std::memory_order_relaxed);
+        for (uint32 i = 0; i < FILTER_PRESENCE_SLOTS / 64; ++i)
+            filterPresence[i].store(0, std::memory_order_relaxed);
+        for (uint32 i = 0; i < BINDING_MAX_EVENT_ID; ++i)
+            unfilteredCounts[i] = 0;
+        filterCounts.clear();
+    }
+
+    /*
+     * Remove the (empty or released) binding list of `key`. Lock must be held.
+     */
+    void EraseKey(const K& key)
+    {
+        bindings.Erase(key);
+
+        if (is_event_key<K>::value)
+            return;
+
+        auto itr = ownerMasks.find(GetOwnerKey(key));
+        if (itr == ownerMasks.end())
+            return;
+
+        itr->second.reset(GetEventIndex(key));
+        if (itr->second.none())
+            ownerMasks.erase(itr);
+    }
+
+    /*
+     * Release the Lua references of every binding in `list`. Lock must be held.
+     */
+    void UnrefAll(BindingList& list)
+    {
+        for (auto itr = list.begin(); itr != list.end(); ++itr)
+            luaL_unref(L, LUA_REGISTRYINDEX, itr->functionReference);
+    }
 
 public:
-    BindingMap(lua_State* L) :
+    BindingMap(lua_State* L, const char* name) :
         L(L),
+        name(name),
         maxBindingID(0)
-    { }
+    {
+        ResetPresence();
+    }
+
+    const char* GetName() const { return name; }
+
+    ~BindingMap()
+    {
+        Guard guard(GetLock());
+
+        bindings.ForEach([this](BindingList& list) { UnrefAll(list); });
+    }
 
     /*
-     * Insert a new binding from `key` to `ref`, which lasts for `shots`-many pushes.
+     * Insert a new binding from `key` to `ref`, which lasts for `shots`-many calls.
      *
      * If `shots` is 0, it will never automatically expire, but can still be
      *   removed with `Clear` or `Remove`.
+     *
+     * Lists are kept sorted by ascending `priority`. Hooks call the pushed functions
+     *   from the top of the stack down, so bindings with a higher priority are called
+     *   first, and among equal priorities the newest binding is called first.
+     *
+     * `stopOnResult` is reported to `PushRefsFor` callers, see `Eluna::CallFunctions`.
+     *
+     * If `filter` is given, the binding is only pushed for calls whose arguments match it.
      */
-    uint64 Insert(const K& key, int ref, uint32 shots)
+    uint64 Insert(const K& key, int ref, uint32 shots, int32 priority = 0, bool stopOnResult = false, std::shared_ptr<const BindingFilter> filter = nullptr)
     {
         Guard guard(GetLock());
 
         uint64 id = (++maxBindingID);
-        BindingList& list = bindings[key];
-        list.push_back(std::unique_ptr<Binding>(new Binding(L, id, ref, shots)));
-        id_lookup_table[id] = &list;
+        BindingList& list = bindings.Get(key);
+        auto pos = std::upper_bound(list.begin(), list.end(), priority,
+            [](int32 value, const Binding& binding) { return value < binding.priority; });
+        pos = list.insert(pos, Binding(id, ref, shots, priority, stopOnResult, filter));
+        id_lookup_table.emplace(id, key);
+        MarkPresent(key);
+        MarkFilter(key, *pos, true);
+        if (!is_event_key<K>::value)
+            ownerMasks[GetOwnerKey(key)].set(GetEventIndex(key));
         return id;
     }
 
@@ -94,23 +674,22 @@ public:
     {
         Guard guard(GetLock());
 
-        if (bindings.empty())
+        BindingList* list = bindings.Find(key);
+        if (!list)
             return;
 
-        auto iter = bindings.find(key);
-        if (iter == bindings.end())
-            return;
-
-        BindingList& list = iter->second;
-
-        // Remove all pointers to `list` from `id_lookup_table`.
-        for (auto i = list.begin(); i != list.end(); ++i)
+        // Remove all IDs of `list` from `id_lookup_table`.
+        for (auto i = list->begin(); i != list->end(); ++i)
         {
-            std::unique_ptr<Binding>& binding = *i;
-            id_lookup_table.erase(binding->id);
+            id_lookup_table.erase(i->id);
+            MarkFilter(key, *i, false);
         }
 
-        bindings.erase(key);
+        if (!list->empty())
+            MarkAbsent(key, list->size());
+
+        UnrefAll(*list);
+        EraseKey(key);
     }
 
     /*
@@ -120,11 +699,14 @@ public:
     {
         Guard guard(GetLock());
 
-        if (bindings.empty())
+        if (id_lookup_table.empty())
             return;
 
+        bindings.ForEach([this](BindingList& list) { UnrefAll(list); });
+        bindings.Clear();
         id_lookup_table.clear();
-        bindings.clear();
+        ownerMasks.clear();
+        ResetPresence();
     }
 
     /*
@@ -133,81 +715,230 @@ public:
      * If `id` in invalid, nothing is removed.
      */
     void Remove(uint64 id)
+    {
+        Guard guard(GetLock());
+        RemoveBinding(id);
+    }
+
+    void SettleShot(uint64 id, bool called) override
     {
         Guard guard(GetLock());
 
+        // The binding may have been removed while its handler was waiting
         auto iter = id_lookup_table.find(id);
         if (iter == id_lookup_table.end())
             return;
 
-        BindingList* list = iter->second;
-        auto i = list->begin();
+        BindingList* list = bindings.Find(iter->second);
+        if (!list)
+            return;
 
-        for (; i != list->end(); ++i)
+        for (auto i = list->begin(); i != list->end(); ++i)
         {
-            std::unique_ptr<Binding>& binding = *i;
-            if (binding->id == id)
-                break;
+            if (i->id != id)
+                continue;
+
+            --i->pendingShots;
+            if (called && --i->remainingShots == 0)
+                RemoveBinding(id);
+            return;
         }
+    }
 
-        if (i != list->end())
-            list->erase(i);
+    /*
+     * Remove the binding with `id`. Lock must be held.
+     */
+    void RemoveBinding(uint64 id)
+    {
+        auto iter = id_lookup_table.find(id);
+        if (iter == id_lookup_table.end())
+            return;
 
         // Unconditionally erase the ID in the lookup table because
         //   it was either already invalid, or it's no longer valid.
-        id_lookup_table.erase(id);
+        K key = iter->second;
+        id_lookup_table.erase(iter);
+
+        BindingList* list = bindings.Find(key);
+        if (!list)
+            return;
+
+        for (auto i = list->begin(); i != list->end(); ++i)
+        {
+            if (i->id != id)
+                continue;
+
+            luaL_unref(L, LUA_REGISTRYINDEX, i->functionReference);
+            MarkFilter(key, *i, false);
+            list->erase(i);
+            MarkAbsent(key);
+            break;
+        }
+
+        if (list->empty())
+            EraseKey(key);
     }
 
     /*
      * Check whether `key` has any bindings.
+     *
+     * A negative answer is usually given from the presence bitmaps
+     *   with a single relaxed atomic load and without locking.
      */
     bool HasBindingsFor(const K& key)
     {
-        Guard guard(GetLock());
+        if (!TestBit(eventPresence, GetEventIndex(key)))
+            return false;
+
+        // The event bit is exact for keys that consist of the event ID alone
+        if (is_event_key<K>::value)
+            return true;
 
-        if (bindings.empty())
+        if (!TestBit(keyPresence, GetKeySlot(key)))
             return false;
 
-        auto result = bindings.find(key);
-        if (result == bindings.end())
+        Guard guard(GetLock());
+
+        BindingList* list = bindings.Find(key);
+        return list && !list->empty();
+    }
+
+    /*
+     * Check whether `key` may have bindings whose filters match `args`.
+     *
+     * Calls whose arguments match no filter are usually rejected without locking,
+     *   unless the event also has bindings without a filter.
+     */
+    bool HasBindingsFor(const K& key, const BindingFilterArgs& args)
+    {
+        uint32 event = GetEventIndex(key);
+        if (!TestBit(eventPresence, event))
             return false;
 
-        BindingList& list = result->second;
-        return !list.empty();
+        if (!TestBit(unfilteredPresence, event))
+        {
+            bool matches = false;
+            for (uint32 kind = 0; kind < BINDING_FILTER_COUNT && !matches; ++kind)
+                if (args.kinds & (1 << kind))
+                    matches = TestBit(filterPresence, GetFilterSlot(event, kind, args.values[kind]));
+            if (!matches)
+                return false;
+        }
+
+        return HasBindingsFor(key);
     }
 
     /*
-     * Push all Lua references for `key` onto the stack.
+     * Check whether `key` has a binding that `PushRefsFor` would push for `args`.
+     *
+     * Unlike `HasBindingsFor`, the filters of the bindings are checked, so the answer is exact.
      */
-    void PushRefsFor(const K& key)
+    bool HasMatchingBindingsFor(const K& key, const BindingFilterArgs& args)
     {
+        if (!HasBindingsFor(key, args))
+            return false;
+
         Guard guard(GetLock());
 
-        if (bindings.empty())
-            return;
+        BindingList* list = bindings.Find(key);
+        if (!list)
+            return false;
 
-        auto result = bindings.find(key);
-        if (result == bindings.end())
-            return;
+        for (auto itr = list->begin(); itr != list->end(); ++itr)
+            if (!itr->filter || itr->filter->Matches(&args))
+                return true;
+        return false;
+    }
 
-        BindingList& list = result->second;
-        for (auto i = list.begin(); i != list.end();)
+    /*
+     * Get the set of event IDs that have bindings for the owner of `key`,
+     *   i.e. for `key` with its event ID ignored.
+     *
+     * This replaces looping over every event ID with `HasBindingsFor`.
+     */
+    EventMask GetEventMask(const K& key)
+    {
+        EventMask mask;
+
+        bool any = false;
+        for (uint32 i = 0; i < BINDING_MAX_EVENT_ID / 64 && !any; ++i)
+            any = eventPresence[i].load(std::memory_order_relaxed) != 0;
+        if (!any)
+            return mask;
+
+        Guard guard(GetLock());
+
+        if (is_event_key<K>::value)
         {
-            std::unique_ptr<Binding>& binding = (*i);
-            auto i_prev = (i++);
+            for (uint32 i = 0; i < BINDING_MAX_EVENT_ID; ++i)
+                if (eventCounts[i])
+                    mask.set(i);
+            return mask;
+        }
 
-            lua_rawgeti(L, LUA_REGISTRYINDEX, binding->functionReference);
+        auto itr = ownerMasks.find(GetOwnerKey(key));
+        if (itr != ownerMasks.end())
+            mask = itr->second;
+        return mask;
+    }
 
-            if (binding->remainingShots > 0)
-            {
-                binding->remainingShots -= 1;
+    /*
+     * Push all Lua references for `key` onto the stack.
+     *
+     * Bindings with a filter are only pushed if it matches `args`, and don't use up shots otherwise.
+     * If `pushed` is given, every pushed binding is appended to it. Their shots are only held then,
+     *   the caller settles them with `PushedBinding::Settle` once it calls or skips the handler,
+     *   so a handler skipped by one registered with `stopOnResult` keeps its shot. Bindings whose
+     *   remaining shots are all held are not pushed. Without `pushed`, shots are used up right away.
+     */
+    void PushRefsFor(const K& key, std::vector<PushedBinding>* pushed = NULL, const BindingFilterArgs* args = NULL)
+    {
+        Guard guard(GetLock());
+
+        BindingList* list = bindings.Find(key);
+        if (!list)
+            return;
 
-                if (binding->remainingShots == 0)
+        // Expired bindings are compacted out in the same pass
+        auto out = list->begin();
+        for (auto i = list->begin(); i != list->end(); ++i)
+        {
+            // Bindings that don't match, or whose shots are all held by dispatches, are kept but not pushed
+            bool push = (!i->filter || i->filter->Matches(args)) && (!i->remainingShots || i->pendingShots < i->remainingShots);
+            if (push)
+            {
+                lua_rawgeti(L, LUA_REGISTRYINDEX, i->functionReference);
+                if (pushed)
+                {
+                    BindingShots* shots = NULL;
+                    if (i->remainingShots)
+                    {
+                        ++i->pendingShots;
+                        shots = this;
+                    }
+                    pushed->push_back(PushedBinding(i->id, shots, i->stopOnResult));
+                }
+                else if (i->remainingShots > 0 && --i->remainingShots == 0)
                 {
-                    id_lookup_table.erase(binding->id);
-                    list.erase(i_prev);
+                    // The function is on the stack now, so its reference can be released
+                    luaL_unref(L, LUA_REGISTRYINDEX, i->functionReference);
+                    id_lookup_table.erase(i->id);
+                    MarkFilter(key, *i, false);
+                    MarkAbsent(key);
+                    continue;
                 }
             }
+
+            if (out != i)
+                *out = *i;
+            ++out;
+        }
+
+        if (out != list->end())
+        {
+            list->erase(out, list->end());
+            if (list->empty())
+                EraseKey(key);
         }
     }
 };
@@ -237,6 +968,11 @@ struct EntryKey
     T event_id;
     uint32 entry;
 
+    EntryKey() :
+        event_id(),
+        entry(0)
+    { }
+
     EntryKey(T event_id, uint32 entry) :
         event_id(event_id),
         entry(entry)
@@ -254,6 +990,12 @@ struct UniqueObjectKey
     ObjectGuid guid;
     uint32 instance_id;
 
+    UniqueObjectKey() :
+        event_id(),
+        guid(),
+        instance_id(0)
+    { }
+
     UniqueObjectKey(T event_id, ObjectGuid guid, uint32 instance_id) :
         event_id(event_id),
         guid(guid),
@@ -261,6 +1003,27 @@ struct UniqueObjectKey
     { }
 };
 
+/*
+ * A `BindingMap` key type for event ID/string prefix bindings
+ *   (currently just addon messages, see `Eluna::OnAddonMessage`).
+ */
+template <typename T>
+struct PrefixKey
+{
+    T event_id;
+    std::string prefix;
+
+    PrefixKey() :
+        event_id(),
+        prefix()
+    { }
+
+    PrefixKey(T event_id, const char* prefix, size_t length) :
+        event_id(event_id),
+        prefix(prefix, length)
+    { }
+};
+
 class hash_helper
 {
 public:
@@ -338,6 +1101,16 @@ namespace std
         }
     };
 
+    template<typename T>
+    struct equal_to < PrefixKey<T> >
+    {
+        bool operator()(PrefixKey<T> const& lhs, PrefixKey<T> const& rhs) const
+        {
+            return lhs.event_id == rhs.event_id
+                && lhs.prefix == rhs.prefix;
+        }
+    };
+
     template<typename T>
     struct hash < EventKey<T> >
     {
@@ -370,6 +1143,17 @@ namespace std
             return hash_helper::hash(k.event_id, k.instance_id, k.guid.GetRawValue());
         }
     };
+
+    template<typename T>
+    struct hash < PrefixKey<T> >
+    {
+        typedef PrefixKey<T> argument_type;
+
+        hash_helper::result_type operator()(argument_type const& k) const
+        {
+            return hash_helper::hash(k.event_id, k.prefix);
+        }
+    };
 }
 
 #endif // _BINDING_MAP_H
@@ -0,0 +1,218 @@
+/*
+* Copyright (C) 2010 - 2016 Eluna Lua Engine <http://emudevs.com/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#ifndef _COMMAND_TRIE_H
+#define _COMMAND_TRIE_H
+
+#include <atomic>
+#include <cctype>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "Common.h"
+#include "ElunaUtility.h"
+#include "BindingMap.h"
+#include "Hooks.h"
+
+/*
+ * The chat commands registered with `RegisterCommand`, as a trie of command tokens.
+ *
+ * Tokens are stored lowercase and matched case-insensitively against the command text,
+ *   without copying it. The node that ends a command holds the key of the command's
+ *   handlers in `Eluna::CommandBindings`, which are filtered by security level.
+ */
+class CommandTrie : public ElunaUtil::Lockable
+{
+public:
+    typedef PrefixKey<Hooks::PlayerEvents> Key;
+
+private:
+    struct Node
+    {
+        // Sorted by token
+        std::vector< std::pair<std::string, std::unique_ptr<Node> > > children;
+        Key key;
+        bool command;
+
+        Node() :
+            command(false)
+        { }
+    };
+
+    Node root;
+    std::atomic<uint32> commandCount;
+
+    static bool IsSpace(char c)
+    {
+        return std::isspace(static_cast<unsigned char>(c)) != 0;
+    }
+
+    static char ToLower(char c)
+    {
+        return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+
+    // Compares the lowercase `token` with `length` characters of `text`, ignoring the case of `text`
+    static int Compare(const std::string& token, const char* text, size_t length)
+    {
+        size_t common = std::min(token.size(), length);
+        for (size_t i = 0; i < common; ++i)
+        {
+            char c = ToLower(text[i]);
+            if (token[i] != c)
+                return token[i] < c ? -1 : 1;
+        }
+        if (token.size() == length)
+            return 0;
+        return token.size() < length ? -1 : 1;
+    }
+
+    static Node* FindChild(const Node* node, const char* token, size_t length)
+    {
+        auto itr = std::lower_bound(node->children.begin(), node->children.end(), std::make_pair(token, length),
+            [](const std::pair<std::string, std::unique_ptr<Node> >& child, const std::pair<const char*, size_t>& value)
+            {
+                return Compare(child.first, value.first, value.second) < 0;
+            });
+        if (itr == node->children.end() || Compare(itr->first, token, length) != 0)
+            return NULL;
+        return itr->second.get();
+    }
+
+public:
+    CommandTrie() :
+        commandCount(0)
+    { }
+
+    /*
+     * Splits `text` at whitespace and calls `f(token, length)` for every token
+     *   until it returns false. Returns the text after the last accepted token.
+     */
+    template<typename F>
+    static const char* Tokenize(const char* text, F f)
+    {
+        while (true)
+        {
+            while (*text && IsSpace(*text))
+                ++text;
+            if (!*text)
+                return text;
+
+            const char* end = text;
+            while (*end && !IsSpace(*end))
+                ++end;
+            if (!f(text, static_cast<size_t>(end - text)))
+                return text;
+            text = end;
+        }
+    }
+
+    /*
+     * Returns the key the handlers of the command `path` are bound to,
+     *   which is the lowercase path with its tokens separated by single spaces.
+     */
+    static Key GetKey(const char* path)
+    {
+        std::string normalized;
+        Tokenize(path, [&normalized](const char* token, size_t length)
+        {
+            if (!normalized.empty())
+                normalized += ' ';
+            for (size_t i = 0; i < length; ++i)
+                normalized += ToLower(token[i]);
+            return true;
+        });
+        return Key(Hooks::PLAYER_EVENT_ON_COMMAND, normalized.data(), normalized.size());
+    }
+
+    /*
+     * Adds the command `path`. Adding an existing command does nothing.
+     */
+    void Insert(const char* path)
+    {
+        Guard guard(GetLock());
+
+        Node* node = &root;
+        Tokenize(path, [&node](const char* token, size_t length)
+        {
+            Node* child = FindChild(node, token, length);
+            if (!child)
+            {
+                std::string lower(token, length);
+                std::transform(lower.begin(), lower.end(), lower.begin(), ToLower);
+                auto pos = std::lower_bound(node->children.begin(), node->children.end(), lower,
+                    [](const std::pair<std::string, std::unique_ptr<Node> >& other, const std::string& value) { return other.first < value; });
+                pos = node->children.insert(pos, std::make_pair(lower, std::unique_ptr<Node>(new Node())));
+                child = pos->second.get();
+            }
+            node = child;
+            return true;
+        });
+
+        if (node == &root)
+            return;
+
+        if (!node->command)
+            ++commandCount;
+        node->key = GetKey(path);
+        node->command = true;
+    }
+
+    /*
+     * Finds the longest registered command that `text` starts with and that `accept(key)` returns true for.
+     *
+     * Commands stay in the trie when their handlers are cancelled, `accept` lets the caller skip those
+     *   so a shorter command can match instead.
+     *
+     * On a match, the command's key is stored in `key` and the text after the command,
+     *   i.e. its arguments, in `args`.
+     */
+    template<typename F>
+    bool Match(const char* text, Key& key, const char*& args, F accept)
+    {
+        if (!commandCount.load(std::memory_order_relaxed))
+            return false;
+
+        Guard guard(GetLock());
+
+        // Collect the commands along the path, the longest is tried first
+        const Node* node = &root;
+        std::vector<std::pair<const Node*, const char*> > matches;
+        Tokenize(text, [&](const char* token, size_t length)
+        {
+            node = FindChild(node, token, length);
+            if (!node)
+                return false;
+            if (node->command)
+                matches.emplace_back(node, token + length);
+            return true;
+        });
+
+        for (auto itr = matches.rbegin(); itr != matches.rend(); ++itr)
+        {
+            if (!accept(itr->first->key))
+                continue;
+
+            key = itr->first->key;
+            args = itr->second;
+            return true;
+        }
+        return false;
+    }
+
+    /*
+     * Removes all commands.
+     */
+    void Clear()
+    {
+        Guard guard(GetLock());
+
+        root.children.clear();
+        commandCount = 0;
+    }
+};
+
+#endif // _COMMAND_TRIE_H
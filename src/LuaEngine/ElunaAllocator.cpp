@@ -0,0 +1,150 @@
+/*
+* Copyright (C) 2010 - 2016 Eluna Lua Engine <http://emudevs.com/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#include "ElunaAllocator.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+ElunaAllocator::ElunaAllocator(size_t limit) :
+    chunkPos(NULL),
+    chunkLeft(0),
+    limit(limit),
+    limited(false),
+    used(0),
+    peak(0),
+    pooled(0),
+    failures(0)
+{
+    for (size_t i = 0; i < CLASS_COUNT; ++i)
+        freeLists[i] = NULL;
+}
+
+ElunaAllocator::~ElunaAllocator()
+{
+    for (auto itr = chunks.begin(); itr != chunks.end(); ++itr)
+        free(*itr);
+}
+
+void* ElunaAllocator::Alloc(void* ud, void* ptr, size_t osize, size_t nsize)
+{
+    ElunaAllocator* allocator = static_cast<ElunaAllocator*>(ud);
+
+    // For new blocks Lua 5.2 and later pass the type of the object in osize
+    if (!ptr)
+        osize = 0;
+
+    if (!nsize)
+    {
+        if (ptr)
+        {
+            allocator->Free(ptr, osize);
+            allocator->used.store(allocator->GetUsed() - osize, std::memory_order_relaxed);
+        }
+        return NULL;
+    }
+
+    size_t used = allocator->GetUsed();
+    if (nsize > osize && allocator->limited && allocator->limit && used + (nsize - osize) > allocator->limit)
+    {
+        allocator->failures.fetch_add(1, std::memory_order_relaxed);
+        return NULL;
+    }
+
+    void* block = ptr ? allocator->Reallocate(ptr, osize, nsize) : allocator->Allocate(nsize);
+    if (!block)
+        return NULL;
+
+    used = used - osize + nsize;
+    allocator->used.store(used, std::memory_order_relaxed);
+    if (used > allocator->GetPeak())
+        allocator->peak.store(used, std::memory_order_relaxed);
+    return block;
+}
+
+void* ElunaAllocator::Allocate(size_t size)
+{
+    if (size > MAX_POOLED)
+        return malloc(size);
+
+    size_t sizeClass = GetClass(size);
+    if (FreeBlock* block = freeLists[sizeClass])
+    {
+        freeLists[sizeClass] = block->next;
+        return block;
+    }
+
+    size_t blockSize = (sizeClass + 1) * GRANULARITY;
+    if (chunkLeft < blockSize)
+    {
+        // The rest of the chunk is a block of a smaller class
+        if (chunkLeft)
+            Free(chunkPos, chunkLeft);
+
+        char* chunk = static_cast<char*>(malloc(CHUNK_SIZE));
+        if (!chunk)
+            return NULL;
+
+        // Lua is C, exceptions must not escape into it
+        try
+        {
+            chunks.push_back(chunk);
+        }
+        catch (const std::bad_alloc&)
+        {
+            free(chunk);
+            chunkPos = NULL;
+            chunkLeft = 0;
+            return NULL;
+        }
+
+        pooled.store(GetPooled() + CHUNK_SIZE, std::memory_order_relaxed);
+        chunkPos = chunk;
+        chunkLeft = CHUNK_SIZE;
+    }
+
+    void* block = chunkPos;
+    chunkPos += blockSize;
+    chunkLeft -= blockSize;
+    return block;
+}
+
+void ElunaAllocator::Free(void* ptr, size_t size)
+{
+    if (size > MAX_POOLED)
+    {
+        free(ptr);
+        return;
+    }
+
+    FreeBlock* block = static_cast<FreeBlock*>(ptr);
+    size_t sizeClass = GetClass(size);
+    block->next = freeLists[sizeClass];
+    freeLists[sizeClass] = block;
+}
+
+void* ElunaAllocator::Reallocate(void* ptr, size_t osize, size_t nsize)
+{
+    if (osize > MAX_POOLED && nsize > MAX_POOLED)
+        return realloc(ptr, nsize);
+
+    if (osize <= MAX_POOLED && nsize <= MAX_POOLED && GetClass(osize) == GetClass(nsize))
+        return ptr;
+
+    void* block = Allocate(nsize);
+    if (!block)
+    {
+        // Lua expects shrinking to never fail. The old block is large enough and is kept,
+        //   it is freed by its new size from now on, which only happens when out of memory.
+        return nsize < osize ? ptr : NULL;
+    }
+
+    memcpy(block, ptr, std::min(osize, nsize));
+    Free(ptr, osize);
+    return block;
+}
@@ -0,0 +1,90 @@
+/*
+* Copyright (C) 2010 - 2016 Eluna Lua Engine <http://emudevs.com/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#ifndef _ELUNA_ALLOCATOR_H
+#define _ELUNA_ALLOCATOR_H
+
+#include <atomic>
+#include <vector>
+#include "Common.h"
+
+/*
+ * The memory allocator of a Lua state, passed to `lua_newstate`.
+ *
+ * Small blocks come from pools of fixed size classes carved out of large chunks, so most
+ *   tables, strings and closures never reach malloc. Each state has its own allocator and a state
+ *   is only used under its lock, so the pools need no synchronization of their own.
+ *
+ * The bytes in use are always accounted. The limit is only enforced while it is set with `SetLimited`,
+ *   which Eluna does while handlers run inside a protected call, see `Eluna::MemoryLimitScope`.
+ *   A refused allocation then raises a "not enough memory" error in the handler. Allocations made
+ *   outside of handlers, such as hooks pushing their arguments, are never refused, an error there
+ *   would not be protected and would abort the server. That memory is the headroom above `limit`.
+ *   Pool chunks are kept until the state is closed.
+ */
+class ElunaAllocator
+{
+public:
+    // Blocks up to this size are pooled, in classes of `GRANULARITY` bytes
+    static const size_t MAX_POOLED = 512;
+    static const size_t GRANULARITY = 16;
+    static const size_t CLASS_COUNT = MAX_POOLED / GRANULARITY;
+    static const size_t CHUNK_SIZE = 64 * 1024;
+
+    // `limit` is in bytes, 0 for no limit
+    ElunaAllocator(size_t limit);
+    ~ElunaAllocator();
+
+    // Prevent copy
+    ElunaAllocator(ElunaAllocator const&) = delete;
+    ElunaAllocator& operator=(const ElunaAllocator&) = delete;
+
+    // The `lua_Alloc` function, `ud` is the allocator
+    static void* Alloc(void* ud, void* ptr, size_t osize, size_t nsize);
+
+    // The counters can be read from any thread
+    size_t GetUsed() const { return used.load(std::memory_order_relaxed); }
+    size_t GetPeak() const { return peak.load(std::memory_order_relaxed); }
+    size_t GetPooled() const { return pooled.load(std::memory_order_relaxed); }
+    size_t GetLimit() const { return limit; }
+    uint32 GetFailures() const { return failures.load(std::memory_order_relaxed); }
+
+    // Sets whether `limit` is enforced and returns the previous setting, only under the lock of the state
+    bool SetLimited(bool enforce)
+    {
+        bool previous = limited;
+        limited = enforce;
+        return previous;
+    }
+
+private:
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    static size_t GetClass(size_t size) { return (size - 1) / GRANULARITY; }
+
+    void* Allocate(size_t size);
+    void Free(void* ptr, size_t size);
+    void* Reallocate(void* ptr, size_t osize, size_t nsize);
+
+    FreeBlock* freeLists[CLASS_COUNT];
+    std::vector<void*> chunks;
+    char* chunkPos;
+    size_t chunkLeft;
+
+    size_t limit;
+    bool limited;
+    std::atomic<size_t> used;
+    std::atomic<size_t> peak;
+    // Bytes of the pool chunks, in use or not
+    std::atomic<size_t> pooled;
+    // Allocations refused because of `limit`
+    std::atomic<uint32> failures;
+};
+
+#endif // _ELUNA_ALLOCATOR_H
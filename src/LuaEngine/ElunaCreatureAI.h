@@ -17,8 +17,10 @@ struct ElunaCreatureAI : ScriptedAI
     bool justSpawned;
     // used to delay movementinform hook (WP hook)
     std::vector< std::pair<uint32, uint32> > movepoints;
+    // the Lua state that created this AI, see Eluna::GetStateFor
+    Eluna* E;
 
-    ElunaCreatureAI(Creature* creature) : ScriptedAI(creature), justSpawned(true)
+    ElunaCreatureAI(Eluna* E, Creature* creature) : ScriptedAI(creature), justSpawned(true), E(E)
     {
     }
     ~ElunaCreatureAI() { }
@@ -37,13 +39,13 @@ struct ElunaCreatureAI : ScriptedAI
         {
             for (auto& point : movepoints)
             {
-                if (!sEluna->MovementInform(me, point.first, point.second))
+                if (!E->MovementInform(me, point.first, point.second))
                     ScriptedAI::MovementInform(point.first, point.second);
             }
             movepoints.clear();
         }
 
-        if (!sEluna->UpdateAI(me, diff))
+        if (!E->UpdateAI(me, diff))
         {
             if (!me->HasFlag(UNIT_FIELD_FLAGS, UNIT_FLAG_IMMUNE_TO_NPC))
                 ScriptedAI::UpdateAI(diff);
@@ -54,14 +56,14 @@ struct ElunaCreatureAI : ScriptedAI
     // Called at creature aggro either by MoveInLOS or Attack Start
     void JustEngagedWith(Unit* target) override
     {
-        if (!sEluna->EnterCombat(me, target))
+        if (!E->EnterCombat(me, target))
             ScriptedAI::JustEngagedWith(target);
     }
 
     // Called at any Damage from any attacker (before damage apply)
     void DamageTaken(Unit* attacker, uint32& damage, DamageEffectType damagetype, SpellSchoolMask damageSchoolMask) override
     {
-        if (!sEluna->DamageTaken(me, attacker, damage))
+        if (!E->DamageTaken(me, attacker, damage))
         {
             ScriptedAI::DamageTaken(attacker, damage, damagetype, damageSchoolMask);
         }
@@ -70,28 +72,28 @@ struct ElunaCreatureAI : ScriptedAI
     //Called at creature death
     void JustDied(Unit* killer) override
     {
-        if (!sEluna->JustDied(me, killer))
+        if (!E->JustDied(me, killer))
             ScriptedAI::JustDied(killer);
     }
 
     //Called at creature killing another unit
     void KilledUnit(Unit* victim) override
     {
-        if (!sEluna->KilledUnit(me, victim))
+        if (!E->KilledUnit(me, victim))
             ScriptedAI::KilledUnit(victim);
     }
 
     // Called when the creature summon successfully other creature
     void JustSummoned(Creature* summon) override
     {
-        if (!sEluna->JustSummoned(me, summon))
+        if (!E->JustSummoned(me, summon))
             ScriptedAI::JustSummoned(summon);
     }
 
     // Called when a summoned creature is despawned
     void SummonedCreatureDespawn(Creature* summon) override
     {
-        if (!sEluna->SummonedCreatureDespawn(me, summon))
+        if (!E->SummonedCreatureDespawn(me, summon))
             ScriptedAI::SummonedCreatureDespawn(summon);
     }
 
@@ -106,89 +108,89 @@ struct ElunaCreatureAI : ScriptedAI
     // Called before EnterCombat even before the creature is in combat.
     void AttackStart(Unit* target) override
     {
-        if (!sEluna->AttackStart(me, target))
+        if (!E->AttackStart(me, target))
             ScriptedAI::AttackStart(target);
     }
 
     // Called for reaction at stopping attack at no attackers or targets
     void EnterEvadeMode(EvadeReason /*why*/) override
     {
-        if (!sEluna->EnterEvadeMode(me))
+        if (!E->EnterEvadeMode(me))
             ScriptedAI::EnterEvadeMode();
     }
 
     // Called when creature is spawned or respawned (for reseting variables)
     void JustRespawned() override
     {
-        if (!sEluna->JustRespawned(me))
+        if (!E->JustRespawned(me))
             ScriptedAI::JustRespawned();
     }
 
     // Called at reaching home after evade
     void JustReachedHome() override
     {
-        if (!sEluna->JustReachedHome(me))
+        if (!E->JustReachedHome(me))
             ScriptedAI::JustReachedHome();
     }
 
     // Called at text emote receive from player
     void ReceiveEmote(Player* player, uint32 emoteId) override
     {
-        if (!sEluna->ReceiveEmote(me, player, emoteId))
+        if (!E->ReceiveEmote(me, player, emoteId))
             ScriptedAI::ReceiveEmote(player, emoteId);
     }
 
     // called when the corpse of this creature gets removed
     void CorpseRemoved(uint32& respawnDelay) override
     {
-        if (!sEluna->CorpseRemoved(me, respawnDelay))
+        if (!E->CorpseRemoved(me, respawnDelay))
             ScriptedAI::CorpseRemoved(respawnDelay);
     }
 
     void MoveInLineOfSight(Unit* who) override
     {
-        if (!sEluna->MoveInLineOfSight(me, who))
+        if (!E->MoveInLineOfSight(me, who))
             ScriptedAI::MoveInLineOfSight(who);
     }
 
     // Called when hit by a spell
     void SpellHit(Unit* caster, SpellInfo const* spell) override
     {
-        if (!sEluna->SpellHit(me, caster, spell))
+        if (!E->SpellHit(me, caster, spell))
             ScriptedAI::SpellHit(caster, spell);
     }
 
     // Called when spell hits a target
     void SpellHitTarget(Unit* target, SpellInfo const* spell) override
     {
-        if (!sEluna->SpellHitTarget(me, target, spell))
+        if (!E->SpellHitTarget(me, target, spell))
             ScriptedAI::SpellHitTarget(target, spell);
     }
 
     // Called when the creature is summoned successfully by other creature
     void IsSummonedBy(WorldObject* summoner) override
     {
-        if (!summoner->ToUnit() || !sEluna->OnSummoned(me, summoner->ToUnit()))
+        if (!summoner->ToUnit() || !E->OnSummoned(me, summoner->ToUnit()))
             ScriptedAI::IsSummonedBy(summoner);
     }
 
     void SummonedCreatureDies(Creature* summon, Unit* killer) override
     {
-        if (!sEluna->SummonedCreatureDies(me, summon, killer))
+        if (!E->SummonedCreatureDies(me, summon, killer))
             ScriptedAI::SummonedCreatureDies(summon, killer);
     }
 
     // Called when owner takes damage
     void OwnerAttackedBy(Unit* attacker) override
     {
-        if (!sEluna->OwnerAttackedBy(me, attacker))
+        if (!E->OwnerAttackedBy(me, attacker))
             ScriptedAI::OwnerAttackedBy(attacker);
     }
 
     // Called when owner attacks something
     void OwnerAttacked(Unit* target) override
     {
-        if (!sEluna->OwnerAttacked(me, target))
+        if (!E->OwnerAttacked(me, target))
             ScriptedAI::OwnerAttacked(target);
     }
 };
@@ -0,0 +1,87 @@
+/*
+* Copyright (C) 2010 - 2016 Eluna Lua Engine <http://emudevs.com/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#include "ElunaDeferredHook.h"
+#include "ElunaIncludes.h"
+#include "LuaEngine.h"
+
+DeferredArg::DeferredArg(bool value) : type(ARG_BOOL), low(value ? 1 : 0), high(0)
+{
+}
+
+DeferredArg::DeferredArg(int32 value) : type(ARG_INT), low(uint32(value)), high(0)
+{
+}
+
+DeferredArg::DeferredArg(uint32 value) : type(ARG_UINT), low(value), high(0)
+{
+}
+
+DeferredArg::DeferredArg(const std::string& value) : type(ARG_STRING), low(0), high(0), str(value)
+{
+}
+
+DeferredArg::DeferredArg(ObjectGuid value) : type(ARG_GUID), low(uint32(value.GetRawValue())), high(uint32(value.GetRawValue() >> 32))
+{
+}
+
+DeferredArg::DeferredArg(Player const* player) : DeferredArg(player ? player->GET_GUID() : ObjectGuid())
+{
+}
+
+DeferredArg::DeferredArg(Item const* item) : DeferredArg(item ? item->GET_GUID() : ObjectGuid())
+{
+}
+
+DeferredArg::DeferredArg(Group const* group) : DeferredArg(group ? group->GET_GUID() : ObjectGuid())
+{
+}
+
+DeferredArg::DeferredArg(Guild const* guild) : type(guild ? ARG_UINT : ARG_NIL), low(guild ? guild->GetId() : 0), high(0)
+{
+}
+
+DeferredArg::DeferredArg(AchievementEntry const* achievement) : type(achievement ? ARG_UINT : ARG_NIL), low(achievement ? achievement->ID : 0), high(0)
+{
+}
+
+DeferredArg::DeferredArg(Map const* map) : type(map ? ARG_MAP : ARG_NIL), low(map ? map->GetId() : 0), high(map ? map->GetInstanceId() : 0)
+{
+}
+
+void DeferredArg::Push(lua_State* L) const
+{
+    switch (type)
+    {
+        case ARG_BOOL:
+            Eluna::Push(L, low != 0);
+            break;
+        case ARG_INT:
+            Eluna::Push(L, int32(low));
+            break;
+        case ARG_UINT:
+            Eluna::Push(L, low);
+            break;
+        case ARG_STRING:
+            Eluna::Push(L, str);
+            break;
+        case ARG_GUID:
+        {
+            ObjectGuid guid(uint64(low) | (uint64(high) << 32));
+            if (!guid.IsEmpty())
+                Eluna::Push(L, guid);
+            else
+                Eluna::Push(L);
+            break;
+        }
+        case ARG_MAP:
+            Eluna::Push(L, eMapMgr->FindMap(low, high));
+            break;
+        default:
+            Eluna::Push(L);
+            break;
+    }
+}
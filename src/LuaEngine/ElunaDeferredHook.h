@@ -0,0 +1,82 @@
+/*
+* Copyright (C) 2010 - 2016 Eluna Lua Engine <http://emudevs.com/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#ifndef _ELUNA_DEFERRED_HOOK_H
+#define _ELUNA_DEFERRED_HOOK_H
+
+#include <initializer_list>
+#include <string>
+#include <vector>
+#include "Common.h"
+#include "ObjectGuid.h"
+
+struct lua_State;
+struct AchievementEntry;
+class Player;
+class Item;
+class Group;
+class Guild;
+class Map;
+
+/*
+ * A hook argument copied by value, so it stays valid after the hook returns.
+ *
+ * Game objects are captured by GUID or ID instead of by pointer:
+ *   players, items and groups as their GUID, guilds and achievements as their ID.
+ * Maps are looked up again when the argument is pushed, and are nil if unloaded by then.
+ */
+class DeferredArg
+{
+public:
+    DeferredArg(bool value);
+    DeferredArg(int32 value);
+    DeferredArg(uint32 value);
+    DeferredArg(const std::string& value);
+    DeferredArg(ObjectGuid value);
+    DeferredArg(Player const* player);
+    DeferredArg(Item const* item);
+    DeferredArg(Group const* group);
+    DeferredArg(Guild const* guild);
+    DeferredArg(AchievementEntry const* achievement);
+    DeferredArg(Map const* map);
+
+    void Push(lua_State* L) const;
+
+private:
+    enum ArgType : uint8
+    {
+        ARG_NIL,
+        ARG_BOOL,
+        ARG_INT,
+        ARG_UINT,
+        ARG_STRING,
+        ARG_GUID,
+        ARG_MAP
+    };
+
+    ArgType type;
+    uint32 low;
+    uint32 high;
+    std::string str;
+};
+
+/*
+ * A fire-and-forget hook call queued by the thread that fired it,
+ *   to be run later by the thread that updates the Eluna state.
+ */
+struct DeferredHook
+{
+    DeferredHook(uint8 regtype, uint32 event_id, std::initializer_list<DeferredArg> args) :
+        regtype(regtype), event_id(event_id), args(args)
+    {
+    }
+
+    uint8 regtype;
+    uint32 event_id;
+    std::vector<DeferredArg> args;
+};
+
+#endif
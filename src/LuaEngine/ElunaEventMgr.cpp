@@ -14,7 +14,53 @@ extern "C"
 #include "lauxlib.h"
 };
 
-ElunaEventProcessor::ElunaEventProcessor(Eluna** _E, WorldObject* _obj) : m_time(0), obj(_obj), E(_E)
+namespace
+{
+    // Appends `luaEvent` to the circular list that `tail` points into
+    void LinkEvent(LuaEvent*& tail, LuaEvent* luaEvent)
+    {
+        if (tail)
+        {
+            luaEvent->next = tail->next;
+            tail->next = luaEvent;
+        }
+        else
+            luaEvent->next = luaEvent;
+        tail = luaEvent;
+    }
+
+    // Empties the circular list and returns its first event, the returned list ends with NULL
+    LuaEvent* UnlinkEvents(LuaEvent*& tail)
+    {
+        if (!tail)
+            return NULL;
+
+        LuaEvent* head = tail->next;
+        tail->next = NULL;
+        tail = NULL;
+        return head;
+    }
+
+    inline uint32 LowestBit(uint64 bits)
+    {
+        uint32 index = 0;
+        while (!(bits & 1))
+        {
+            bits >>= 1;
+            ++index;
+        }
+        return index;
+    }
+}
+
+ElunaEventProcessor::TimerWheel::TimerWheel()
+{
+    memset(slots, 0, sizeof(slots));
+    memset(occupied, 0, sizeof(occupied));
+}
+
+ElunaEventProcessor::ElunaEventProcessor(Eluna** _E, WorldObject* _obj) : m_time(0), wheelTime(0), eventCount(0), overflowEvents(NULL), freeEvents(NULL), obj(_obj), E(_E),
+    activeMap(NULL), activePrev(NULL), activeNext(NULL)
 {
     // can be called from multiple threads
     if (obj)
@@ -26,105 +72,337 @@ ElunaEventProcessor::ElunaEventProcessor(Eluna** _E, WorldObject* _obj) : m_time
 
 ElunaEventProcessor::~ElunaEventProcessor()
 {
-    // can be called from multiple threads
+    // The state is gone if it was destroyed before this processor, see ~EventMgr
+    if (E)
     {
-        LOCK_ELUNA;
-        RemoveEvents_internal();
-    }
+        // can be called from multiple threads
+        {
+            LOCK_ELUNA_STATE(*E);
+            RemoveEvents_internal();
+            (*E)->eventMgr->UnlinkProcessor(this);
+        }
 
-    if (obj && Eluna::IsInitialized())
-    {
-        EventMgr::Guard guard((*E)->eventMgr->GetLock());
-        (*E)->eventMgr->processors.erase(this);
+        if (obj && Eluna::IsInitialized())
+        {
+            EventMgr::Guard guard((*E)->eventMgr->GetLock());
+            (*E)->eventMgr->processors.erase(this);
+        }
     }
+
+    for (std::vector<LuaEvent*>::const_iterator it = slabs.begin(); it != slabs.end(); ++it)
+        delete[] *it;
 }
 
 void ElunaEventProcessor::Update(uint32 diff)
 {
     m_time += diff;
-    for (EventList::iterator it = eventList.begin(); it != eventList.end() && it->first <= m_time; it = eventList.begin())
+    if (!eventCount)
     {
-        LuaEvent* luaEvent = it->second;
-        eventList.erase(it);
-
-        if (luaEvent->state != LUAEVENT_STATE_ERASE)
-            eventMap.erase(luaEvent->funcRef);
+        wheelTime = m_time;
+        return;
+    }
 
-        if (luaEvent->state == LUAEVENT_STATE_RUN)
+    while (eventCount)
+    {
+        uint32 index = WheelSlot(wheelTime, 0);
+        uint64 due = wheel->occupied[0] >> index;
+        if (!due)
         {
-            uint32 delay = luaEvent->delay;
-            bool remove = luaEvent->repeats == 1;
-            if (!remove)
-                AddEvent(luaEvent); // Reschedule before calling incase RemoveEvents used
+            // Nothing left in this rotation, skip to where events move down from the higher levels
+            uint64 next = NextCascadeTime();
+            if (next > m_time)
+                break;
+            SetWheelTime(next);
+            continue;
+        }
 
-            // Call the timed event
-            (*E)->OnTimedEvent(luaEvent->funcRef, delay, luaEvent->repeats ? luaEvent->repeats-- : luaEvent->repeats, obj);
+        uint64 time = wheelTime + LowestBit(due);
+        if (time > m_time)
+            break;
+        wheelTime = time;
 
-            if (!remove)
-                continue;
+        uint32 slot = WheelSlot(time, 0);
+        LuaEvent* luaEvent = UnlinkEvents(wheel->slots[0][slot]);
+        wheel->occupied[0] &= ~(uint64(1) << slot);
+
+        while (luaEvent)
+        {
+            // RunEvent can reschedule the event, which reuses `next`
+            LuaEvent* next = luaEvent->next;
+            --eventCount;
+            RunEvent(luaEvent);
+            luaEvent = next;
         }
 
-        // Event should be deleted (executed last time or set to be aborted)
-        RemoveEvent(luaEvent);
+        // Events added with no delay while running go to the same slot, run them before moving on.
+        // The wheel stays at the current time, events added after this update with no delay run on the next one.
+        if (time < m_time && !(wheel->occupied[0] & (uint64(1) << slot)))
+            SetWheelTime(time + 1);
+    }
+
+    if (wheelTime < m_time)
+        SetWheelTime(m_time);
+
+    if (!eventCount && activeMap)
+        (*E)->eventMgr->UnlinkProcessor(this);
+}
+
+void ElunaEventProcessor::RunEvent(LuaEvent* luaEvent)
+{
+    if (luaEvent->state != LUAEVENT_STATE_ERASE)
+        UnindexEvent(luaEvent->funcRef);
+
+    if (luaEvent->state == LUAEVENT_STATE_RUN)
+    {
+        uint32 delay = luaEvent->delay;
+        bool remove = luaEvent->repeats == 1;
+        if (!remove)
+            AddEvent(luaEvent); // Reschedule before calling incase RemoveEvents used
+
+        // Call the timed event
+        (*E)->OnTimedEvent(luaEvent->funcRef, delay, luaEvent->repeats ? luaEvent->repeats-- : luaEvent->repeats, obj);
+
+        if (!remove)
+            return;
     }
+
+    // Event should be deleted (executed last time or set to be aborted)
+    RemoveEvent(luaEvent);
 }
 
 void ElunaEventProcessor::SetStates(LuaEventState state)
 {
-    for (EventList::iterator it = eventList.begin(); it != eventList.end(); ++it)
-        it->second->SetState(state);
+    for (std::vector<LuaEvent*>::const_iterator it = slabs.begin(); it != slabs.end(); ++it)
+        for (LuaEvent* luaEvent = *it; luaEvent != *it + EVENT_SLAB_SIZE; ++luaEvent)
+            if (luaEvent->used)
+                luaEvent->SetState(state);
     if (state == LUAEVENT_STATE_ERASE)
-        eventMap.clear();
+    {
+        while (!eventMap.empty())
+            UnindexEvent(eventMap.begin()->first);
+    }
 }
 
 void ElunaEventProcessor::RemoveEvents_internal()
 {
-    //if (!final)
-    //{
-    //    for (EventList::iterator it = eventList.begin(); it != eventList.end(); ++it)
-    //        it->second->to_Abort = true;
-    //    return;
-    //}
+    for (std::vector<LuaEvent*>::const_iterator it = slabs.begin(); it != slabs.end(); ++it)
+        for (LuaEvent* luaEvent = *it; luaEvent != *it + EVENT_SLAB_SIZE; ++luaEvent)
+            if (luaEvent->used)
+                RemoveEvent(luaEvent);
 
-    for (EventList::iterator it = eventList.begin(); it != eventList.end(); ++it)
-        RemoveEvent(it->second);
-
-    eventList.clear();
-    eventMap.clear();
+    wheel.reset();
+    overflowEvents = NULL;
+    eventCount = 0;
+    while (!eventMap.empty())
+        UnindexEvent(eventMap.begin()->first);
 }
 
 void ElunaEventProcessor::SetState(int eventId, LuaEventState state)
 {
-    if (eventMap.find(eventId) != eventMap.end())
-        eventMap[eventId]->SetState(state);
+    EventMap::const_iterator it = eventMap.find(eventId);
+    if (it != eventMap.end())
+        it->second->SetState(state);
     if (state == LUAEVENT_STATE_ERASE)
-        eventMap.erase(eventId);
+        UnindexEvent(eventId);
 }
 
 void ElunaEventProcessor::AddEvent(LuaEvent* luaEvent)
 {
     luaEvent->GenerateDelay();
-    eventList.insert(std::pair<uint64, LuaEvent*>(m_time + luaEvent->delay, luaEvent));
+    luaEvent->due = m_time + luaEvent->delay;
+    Schedule(luaEvent);
     eventMap[luaEvent->funcRef] = luaEvent;
+    (*E)->eventMgr->eventIndex[luaEvent->funcRef] = this;
+}
+
+void ElunaEventProcessor::UnindexEvent(int funcRef)
+{
+    if (!eventMap.erase(funcRef) || !E)
+        return;
+
+    // After a reload the new state can reuse the ID of an event that is still waiting to be erased here
+    EventMgr::EventIndex& eventIndex = (*E)->eventMgr->eventIndex;
+    EventMgr::EventIndex::iterator it = eventIndex.find(funcRef);
+    if (it != eventIndex.end() && it->second == this)
+        eventIndex.erase(it);
 }
 
 void ElunaEventProcessor::AddEvent(int funcRef, uint32 min, uint32 max, uint32 repeats)
 {
-    AddEvent(new LuaEvent(funcRef, min, max, repeats));
+    AddEvent(NewEvent(funcRef, min, max, repeats));
+
+    if (obj && !activeMap && obj->FindMap())
+        (*E)->eventMgr->LinkProcessor(this, obj->FindMap());
+}
+
+void ElunaEventProcessor::SetMap(Map* map)
+{
+    if (!E || map == activeMap)
+        return;
+
+    LOCK_ELUNA_STATE(*E);
+    (*E)->eventMgr->UnlinkProcessor(this);
+    if (map && eventCount)
+        (*E)->eventMgr->LinkProcessor(this, map);
+}
+
+uint32 ElunaEventProcessor::MoveToState(Eluna* state)
+{
+    uint32 removed = 0;
+    if (E)
+    {
+        {
+            LOCK_ELUNA_STATE(*E);
+            removed = eventMap.size();
+            RemoveEvents_internal();
+            (*E)->eventMgr->UnlinkProcessor(this);
+        }
+
+        if (obj && Eluna::IsInitialized())
+        {
+            EventMgr::Guard guard((*E)->eventMgr->GetLock());
+            (*E)->eventMgr->processors.erase(this);
+        }
+    }
+
+    E = state ? state->GetStateHandle() : NULL;
+    if (obj && E)
+    {
+        EventMgr::Guard guard((*E)->eventMgr->GetLock());
+        (*E)->eventMgr->processors.insert(this);
+    }
+    return removed;
 }
 
 void ElunaEventProcessor::RemoveEvent(LuaEvent* luaEvent)
 {
     // Unreference if should and if Eluna was not yet uninitialized and if the lua state still exists
-    if (luaEvent->state != LUAEVENT_STATE_ERASE && Eluna::IsInitialized() && (*E)->HasLuaState())
+    if (luaEvent->state != LUAEVENT_STATE_ERASE && E && Eluna::IsInitialized() && (*E)->HasLuaState())
     {
         // Free lua function ref
         luaL_unref((*E)->L, LUA_REGISTRYINDEX, luaEvent->funcRef);
     }
-    delete luaEvent;
+
+    // Return the event to the pool
+    luaEvent->used = false;
+    luaEvent->next = freeEvents;
+    freeEvents = luaEvent;
+}
+
+LuaEvent* ElunaEventProcessor::NewEvent(int funcRef, uint32 min, uint32 max, uint32 repeats)
+{
+    if (!freeEvents)
+    {
+        LuaEvent* slab = new LuaEvent[EVENT_SLAB_SIZE];
+        slabs.push_back(slab);
+        for (uint32 i = EVENT_SLAB_SIZE; i > 0; --i)
+        {
+            slab[i - 1].next = freeEvents;
+            freeEvents = &slab[i - 1];
+        }
+    }
+
+    LuaEvent* luaEvent = freeEvents;
+    freeEvents = luaEvent->next;
+    *luaEvent = LuaEvent(funcRef, min, max, repeats);
+    return luaEvent;
+}
+
+void ElunaEventProcessor::Schedule(LuaEvent* luaEvent)
+{
+    if (!wheel)
+        wheel.reset(new TimerWheel());
+
+    // Events that are already due run on the next slot the wheel reaches
+    uint64 due = std::max(luaEvent->due, wheelTime);
+    uint64 differentBits = due ^ wheelTime;
+
+    uint32 level = 0;
+    while (level < WHEEL_LEVELS && (differentBits >> (WHEEL_BITS * (level + 1))))
+        ++level;
+
+    if (level < WHEEL_LEVELS)
+    {
+        uint32 slot = WheelSlot(due, level);
+        LinkEvent(wheel->slots[level][slot], luaEvent);
+        wheel->occupied[level] |= uint64(1) << slot;
+    }
+    else
+        LinkEvent(overflowEvents, luaEvent);
+
+    ++eventCount;
 }
 
-EventMgr::EventMgr(Eluna** _E) : globalProcessor(new ElunaEventProcessor(_E, NULL)), E(_E)
+/*
+ * Moves the events of the slots the wheel reached at the start of a level 0 rotation down to the lower levels.
+ *
+ * A level's slot is reached when all lower levels are at slot 0, the overflow list when all levels are.
+ */
+void ElunaEventProcessor::Cascade()
+{
+    uint32 top = 1;
+    while (top < WHEEL_LEVELS && !WheelSlot(wheelTime, top))
+        ++top;
+
+    // Top down, so events coming from a higher level are moved again by the levels below it if needed
+    if (top == WHEEL_LEVELS)
+    {
+        LuaEvent* luaEvent = UnlinkEvents(overflowEvents);
+        while (luaEvent)
+        {
+            LuaEvent* next = luaEvent->next;
+            --eventCount;
+            Schedule(luaEvent);
+            luaEvent = next;
+        }
+        top = WHEEL_LEVELS - 1;
+    }
+
+    for (uint32 level = top; level > 0; --level)
+    {
+        uint32 slot = WheelSlot(wheelTime, level);
+        LuaEvent* luaEvent = UnlinkEvents(wheel->slots[level][slot]);
+        wheel->occupied[level] &= ~(uint64(1) << slot);
+
+        while (luaEvent)
+        {
+            LuaEvent* next = luaEvent->next;
+            --eventCount;
+            Schedule(luaEvent);
+            luaEvent = next;
+        }
+    }
+}
+
+/*
+ * Returns the start of the next level 0 rotation that has events moving down into it.
+ */
+uint64 ElunaEventProcessor::NextCascadeTime() const
+{
+    for (uint32 level = 1; level < WHEEL_LEVELS; ++level)
+    {
+        uint32 slot = WheelSlot(wheelTime, level);
+        uint64 later = slot + 1 < WHEEL_SLOTS ? wheel->occupied[level] >> (slot + 1) : 0;
+        if (later)
+        {
+            uint32 shift = WHEEL_BITS * (level + 1);
+            return ((wheelTime >> shift) << shift) | (uint64(slot + 1 + LowestBit(later)) << (WHEEL_BITS * level));
+        }
+    }
+
+    // Only the overflow list is left
+    uint32 shift = WHEEL_BITS * WHEEL_LEVELS;
+    return ((wheelTime >> shift) + 1) << shift;
+}
+
+void ElunaEventProcessor::SetWheelTime(uint64 time)
+{
+    wheelTime = time;
+    if (!WheelSlot(time, 0) && wheel)
+        Cascade();
+}
+
+EventMgr::EventMgr(Eluna** _E) : activeMapCount(0), globalProcessor(new ElunaEventProcessor(_E, NULL)), E(_E), updateNext(NULL)
 {
 }
 
@@ -134,8 +412,18 @@ EventMgr::~EventMgr()
         Guard guard(GetLock());
         if (!processors.empty())
             for (ProcessorSet::const_iterator it = processors.begin(); it != processors.end(); ++it) // loop processors
+            {
                 (*it)->RemoveEvents_internal();
+                // Detach the processor, its object can outlive this state (e.g. a player leaving a map)
+                (*it)->E = NULL;
+                (*it)->activeMap = NULL;
+                (*it)->activePrev = NULL;
+                (*it)->activeNext = NULL;
+            }
         globalProcessor->RemoveEvents_internal();
+        activeProcessors.clear();
+        activeMapCount = 0;
+        eventIndex.clear();
     }
     delete globalProcessor;
     globalProcessor = NULL;
@@ -143,18 +431,83 @@ EventMgr::~EventMgr()
 
 void EventMgr::SetStates(LuaEventState state)
 {
-    Guard guard(GetLock());
-    if (!processors.empty())
-        for (ProcessorSet::const_iterator it = processors.begin(); it != processors.end(); ++it) // loop processors
-            (*it)->SetStates(state);
-    globalProcessor->SetStates(state);
+    // Only the processors holding events are visited, objects without events cost nothing
+    for (EventIndex::const_iterator it = eventIndex.begin(); it != eventIndex.end(); ++it)
+        it->second->eventMap[it->first]->SetState(state);
+
+    if (state == LUAEVENT_STATE_ERASE)
+    {
+        for (EventIndex::const_iterator it = eventIndex.begin(); it != eventIndex.end(); ++it)
+            it->second->eventMap.erase(it->first);
+        eventIndex.clear();
+    }
 }
 
 void EventMgr::SetState(int eventId, LuaEventState state)
 {
-    Guard guard(GetLock());
-    if (!processors.empty())
-        for (ProcessorSet::const_iterator it = processors.begin(); it != processors.end(); ++it) // loop processors
-            (*it)->SetState(eventId, state);
-    globalProcessor->SetState(eventId, state);
+    EventIndex::const_iterator it = eventIndex.find(eventId);
+    if (it != eventIndex.end())
+        it->second->SetState(eventId, state);
+}
+
+void EventMgr::UpdateProcessors(Map const* map, uint32 diff)
+{
+    // A processor linked meanwhile is updated on the next update of its map
+    if (!activeMapCount.load(std::memory_order_relaxed))
+        return;
+
+    LOCK_ELUNA_STATE(*E);
+
+    ActiveProcessorMap::const_iterator it = activeProcessors.find(map);
+    if (it == activeProcessors.end())
+        return;
+
+    // Processors linked during the loop are added in front and wait for the next update,
+    // processors unlinked during the loop are skipped by moving updateNext past them
+    ElunaEventProcessor* processor = it->second;
+    while (processor)
+    {
+        updateNext = processor->activeNext;
+        processor->Update(diff);
+        processor = updateNext;
+    }
+    updateNext = NULL;
+}
+
+void EventMgr::LinkProcessor(ElunaEventProcessor* processor, Map* map)
+{
+    ElunaEventProcessor*& head = activeProcessors[map];
+    activeMapCount.store(activeProcessors.size(), std::memory_order_relaxed);
+    processor->activeMap = map;
+    processor->activePrev = NULL;
+    processor->activeNext = head;
+    if (head)
+        head->activePrev = processor;
+    head = processor;
+}
+
+void EventMgr::UnlinkProcessor(ElunaEventProcessor* processor)
+{
+    if (!processor->activeMap)
+        return;
+
+    if (updateNext == processor)
+        updateNext = processor->activeNext;
+
+    if (processor->activeNext)
+        processor->activeNext->activePrev = processor->activePrev;
+
+    if (processor->activePrev)
+        processor->activePrev->activeNext = processor->activeNext;
+    else if (processor->activeNext)
+        activeProcessors[processor->activeMap] = processor->activeNext;
+    else
+    {
+        activeProcessors.erase(processor->activeMap);
+        activeMapCount.store(activeProcessors.size(), std::memory_order_relaxed);
+    }
+
+    processor->activeMap = NULL;
+    processor->activePrev = NULL;
+    processor->activeNext = NULL;
 }
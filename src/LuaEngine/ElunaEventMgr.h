@@ -10,13 +10,17 @@
 #include "ElunaUtility.h"
 #include "Common.h"
 #include "Util.h"
+#include <atomic>
 #include <map>
+#include <memory>
+#include <vector>
 
 #include "Define.h"
 
 class Eluna;
 class EventMgr;
 class ElunaEventProcessor;
+class Map;
 class WorldObject;
 
 enum LuaEventState
@@ -28,8 +32,13 @@ enum LuaEventState
 
 struct LuaEvent
 {
+    LuaEvent() :
+        min(0), max(0), delay(0), repeats(0), funcRef(0), state(LUAEVENT_STATE_RUN), due(0), next(NULL), used(false)
+    {
+    }
+
     LuaEvent(int _funcRef, uint32 _min, uint32 _max, uint32 _repeats) :
-        min(_min), max(_max), delay(0), repeats(_repeats), funcRef(_funcRef), state(LUAEVENT_STATE_RUN)
+        min(_min), max(_max), delay(0), repeats(_repeats), funcRef(_funcRef), state(LUAEVENT_STATE_RUN), due(0), next(NULL), used(true)
     {
     }
 
@@ -50,6 +59,9 @@ struct LuaEvent
     uint32 repeats; // Amount of repeats to make, 0 for infinite
     int funcRef;    // Lua function reference ID, also used as event ID
     LuaEventState state;    // State for next call
+    uint64 due;     // Processor time of the next call
+    LuaEvent* next; // Next event in the same wheel slot, or in the free list
+    bool used;      // False while the event is in the processor's free list
 };
 
 class ElunaEventProcessor
@@ -57,7 +69,6 @@ class ElunaEventProcessor
     friend class EventMgr;
 
 public:
-    typedef std::multimap<uint64, LuaEvent*> EventList;
     typedef std::unordered_map<int, LuaEvent*> EventMap;
 
     ElunaEventProcessor(Eluna** _E, WorldObject* _obj);
@@ -69,23 +80,83 @@ public:
     // set the event to be removed when executing
     void SetState(int eventId, LuaEventState state);
     void AddEvent(int funcRef, uint32 min, uint32 max, uint32 repeats);
+    // Moves the processor to the active list of the object's new map, or NULL when the object leaves its map
+    void SetMap(Map* map);
+    // Returns the Lua state the events run in, or NULL if it has been destroyed
+    Eluna* GetState() const { return E ? *E : NULL; }
+    // Moves the processor to another Lua state. The events reference functions of the old state and are removed. Returns how many were removed.
+    uint32 MoveToState(Eluna* state);
     EventMap eventMap;
 
 private:
+    /*
+     * Events are kept in a hierarchical timing wheel.
+     *
+     * Level 0 has a slot per millisecond, each higher level has a slot per rotation of the level below it.
+     * An event is stored in the lowest level where its due time and `wheelTime` share all higher bits,
+     *   and moves down a level when the wheel reaches its slot.
+     * Events further away than the top level covers (~4.6 hours) wait in `overflowEvents`.
+     *
+     * Slots are circular lists that point at their last event, so events due at the same time run in the order they were added.
+     */
+    enum
+    {
+        WHEEL_BITS      = 6,
+        WHEEL_SLOTS     = 1 << WHEEL_BITS,
+        WHEEL_LEVELS    = 4,
+        EVENT_SLAB_SIZE = 32
+    };
+
+    struct TimerWheel
+    {
+        TimerWheel();
+
+        LuaEvent* slots[WHEEL_LEVELS][WHEEL_SLOTS];
+        uint64 occupied[WHEEL_LEVELS]; // A bit for every slot that is not empty
+    };
+
     void RemoveEvents_internal();
     void AddEvent(LuaEvent* luaEvent);
+    void UnindexEvent(int funcRef);
     void RemoveEvent(LuaEvent* luaEvent);
-    EventList eventList;
+    void RunEvent(LuaEvent* luaEvent);
+
+    LuaEvent* NewEvent(int funcRef, uint32 min, uint32 max, uint32 repeats);
+    void Schedule(LuaEvent* luaEvent);
+    void Cascade();
+    uint64 NextCascadeTime() const;
+    void SetWheelTime(uint64 time);
+
+    // The slot of `level` that events due at `time` belong to
+    static uint32 WheelSlot(uint64 time, uint32 level) { return uint32(time >> (WHEEL_BITS * level)) & (WHEEL_SLOTS - 1); }
+
     uint64 m_time;
+    uint64 wheelTime;    // Events due before this have been run, never ahead of m_time
+    uint32 eventCount;   // Events in the wheel and the overflow list
+    std::unique_ptr<TimerWheel> wheel; // Allocated with the first event
+    LuaEvent* overflowEvents;
+    std::vector<LuaEvent*> slabs;
+    LuaEvent* freeEvents;
     WorldObject* obj;
     Eluna** E;
+
+    // Links in the active list of `activeMap` while the processor has events, see EventMgr::UpdateProcessors
+    Map* activeMap;
+    ElunaEventProcessor* activePrev;
+    ElunaEventProcessor* activeNext;
 };
 
 class EventMgr : public ElunaUtil::Lockable
 {
 public:
     typedef std::unordered_set<ElunaEventProcessor*> ProcessorSet;
+    typedef std::unordered_map<Map const*, ElunaEventProcessor*> ActiveProcessorMap;
+    typedef std::unordered_map<int, ElunaEventProcessor*> EventIndex;
     ProcessorSet processors;
+    // Heads of the lists of object processors with pending events, per map. Guarded by the state lock.
+    ActiveProcessorMap activeProcessors;
+    // Size of `activeProcessors`, read without the lock so maps without timed events don't take it
+    std::atomic<size_t> activeMapCount;
     ElunaEventProcessor* globalProcessor;
     Eluna** E;
 
@@ -93,12 +164,28 @@ public:
     ~EventMgr();
 
     // Set the state of all timed events
-    // Execute only in safe env
+    // Execute only in safe env, the state lock must be held
     void SetStates(LuaEventState state);
 
-    // Sets the eventId's state in all processors
-    // Execute only in safe env
+    // Sets the eventId's state in the processor holding it
+    // Execute only in safe env, the state lock must be held
     void SetState(int eventId, LuaEventState state);
+
+    // Updates the processors of the objects on `map` that have pending events
+    void UpdateProcessors(Map const* map, uint32 diff);
+
+private:
+    friend class ElunaEventProcessor;
+
+    void LinkProcessor(ElunaEventProcessor* processor, Map* map);
+    void UnlinkProcessor(ElunaEventProcessor* processor);
+
+    // The processor of every event that is in a processor's eventMap, so events can be reached without visiting all processors.
+    // Event IDs are Lua references, which are unique until the event is removed. Guarded by the state lock.
+    EventIndex eventIndex;
+
+    // The next processor UpdateProcessors will update, moved on if it is unlinked meanwhile
+    ElunaEventProcessor* updateNext;
 };
 
 #endif
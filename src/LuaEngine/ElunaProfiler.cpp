@@ -0,0 +1,137 @@
+/*
+* Copyright (C) 2010 - 2016 Eluna Lua Engine <http://emudevs.com/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#include "ElunaProfiler.h"
+
+#include <algorithm>
+#include <chrono>
+
+void LatencyStats::Reset()
+{
+    count = 0;
+    total = 0;
+    max = 0;
+    for (uint32 i = 0; i < BUCKET_COUNT; ++i)
+        buckets[i] = 0;
+}
+
+void LatencyStats::Add(uint64 duration)
+{
+    ++count;
+    total += duration;
+    if (duration > max)
+        max = duration;
+    ++buckets[GetBucket(duration)];
+}
+
+void LatencyStats::Merge(const LatencyStats& other)
+{
+    count += other.count;
+    total += other.total;
+    if (other.max > max)
+        max = other.max;
+    for (uint32 i = 0; i < BUCKET_COUNT; ++i)
+        buckets[i] += other.buckets[i];
+}
+
+uint64 LatencyStats::GetPercentile(double percentile) const
+{
+    if (!count)
+        return 0;
+
+    uint64 rank = static_cast<uint64>(percentile / 100.0 * static_cast<double>(count));
+    if (rank >= count)
+        rank = count - 1;
+
+    uint64 seen = 0;
+    for (uint32 i = 0; i < BUCKET_COUNT; ++i)
+    {
+        seen += buckets[i];
+        if (seen > rank)
+            return std::min(GetBucketLimit(i), max);
+    }
+    return max;
+}
+
+/*
+ * Durations below `SUB_BUCKETS` have a bucket each. Above, the bucket is given
+ *   by the position of the highest set bit and the two bits below it.
+ */
+uint32 LatencyStats::GetBucket(uint64 duration)
+{
+    if (duration < SUB_BUCKETS)
+        return static_cast<uint32>(duration);
+
+    uint32 exponent = 0;
+    for (uint32 shift = 32; shift; shift >>= 1)
+    {
+        if (duration >> (exponent + shift))
+            exponent += shift;
+    }
+
+    uint32 bucket = (exponent - 1) * SUB_BUCKETS + static_cast<uint32>((duration >> (exponent - 2)) & (SUB_BUCKETS - 1));
+    return bucket < BUCKET_COUNT ? bucket : BUCKET_COUNT - 1;
+}
+
+uint64 LatencyStats::GetBucketLimit(uint32 bucket)
+{
+    if (bucket < SUB_BUCKETS)
+        return bucket;
+
+    uint32 exponent = bucket / SUB_BUCKETS + 1;
+    uint64 step = uint64(1) << (exponent - 2);
+    return (SUB_BUCKETS + bucket % SUB_BUCKETS + 1) * step - 1;
+}
+
+uint64 HookProfiler::Now()
+{
+    return static_cast<uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void HookProfiler::RecordHook(const char* type, uint32 event, uint64 duration)
+{
+    Guard guard(GetLock());
+    hooks[HookId(type, event)].Add(duration);
+}
+
+HookProfiler::HandlerStats* HookProfiler::GetHandler(lua_State* L, int index)
+{
+    lua_Debug ar;
+    lua_pushvalue(L, index);
+    lua_getinfo(L, ">S", &ar);
+
+    std::string location = ar.short_src;
+    if (ar.linedefined > 0)
+        location += ":" + std::to_string(ar.linedefined);
+
+    Guard guard(GetLock());
+    HandlerStats& handler = handlers[location];
+    if (handler.location.empty())
+        handler.location = location;
+    return &handler;
+}
+
+void HookProfiler::RecordHandler(HandlerStats* handler, uint64 duration)
+{
+    Guard guard(GetLock());
+    handler->stats.Add(duration);
+}
+
+void HookProfiler::Reset()
+{
+    Guard guard(GetLock());
+    for (HookMap::iterator itr = hooks.begin(); itr != hooks.end(); ++itr)
+        itr->second.Reset();
+    for (HandlerMap::iterator itr = handlers.begin(); itr != handlers.end(); ++itr)
+        itr->second.stats.Reset();
+}
+
+void HookProfiler::Clear()
+{
+    Guard guard(GetLock());
+    hooks.clear();
+    handlers.clear();
+}
@@ -0,0 +1,123 @@
+/*
+* Copyright (C) 2010 - 2016 Eluna Lua Engine <http://emudevs.com/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#ifndef _ELUNA_PROFILER_H
+#define _ELUNA_PROFILER_H
+
+#include <atomic>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include "Common.h"
+#include "ElunaUtility.h"
+
+extern "C"
+{
+#include "lua.h"
+};
+
+/*
+ * Count, total, maximum and a log-linear histogram of durations in nanoseconds.
+ *
+ * Every power of two is split into `SUB_BUCKETS` buckets, so a bucket is at most 25% wide
+ *   and percentiles are estimated to within that.
+ */
+struct LatencyStats
+{
+    static const uint32 SUB_BUCKETS = 4;
+    // Durations of 2^40 ns, about 18 minutes, and more share the last bucket
+    static const uint32 BUCKET_COUNT = 40 * SUB_BUCKETS;
+
+    uint64 count;
+    uint64 total;
+    uint64 max;
+    uint32 buckets[BUCKET_COUNT];
+
+    LatencyStats() { Reset(); }
+
+    void Reset();
+    void Add(uint64 duration);
+    void Merge(const LatencyStats& other);
+
+    // Returns the upper limit of the bucket the `percentile`th duration falls into, at most `max`
+    uint64 GetPercentile(double percentile) const;
+
+    static uint32 GetBucket(uint64 duration);
+    static uint64 GetBucketLimit(uint32 bucket);
+};
+
+/*
+ * Latencies of the hooks and of the handler functions of a Lua state, see `Eluna.HookProfiling`.
+ *
+ * Hooks are identified by the name of their `BindingMap` and the event ID, handlers by where
+ *   their function is defined. Closures created by the same code share their stats, so the stats
+ *   don't grow with the closures a script creates, and a function can't inherit the stats of a
+ *   collected one at the same address. Checking `IsEnabled` is all that is done while profiling is disabled.
+ *
+ * Recording happens on the thread of the state, the stats are read from any thread,
+ *   so the containers are guarded by the lock of the profiler.
+ */
+class HookProfiler : public ElunaUtil::Lockable
+{
+public:
+    struct HandlerStats
+    {
+        std::string location;   // source:line of the function
+        LatencyStats stats;
+    };
+
+    typedef std::pair<const char*, uint32> HookId;
+
+    struct HookIdHash
+    {
+        size_t operator()(const HookId& id) const
+        {
+            return std::hash<const void*>()(id.first) ^ (std::hash<uint32>()(id.second) << 1);
+        }
+    };
+
+    typedef std::unordered_map<HookId, LatencyStats, HookIdHash> HookMap;
+    typedef std::unordered_map<std::string, HandlerStats> HandlerMap;
+
+    HookProfiler() :
+        enabled(false)
+    { }
+
+    bool IsEnabled() const { return enabled.load(std::memory_order_relaxed); }
+    void SetEnabled(bool enable) { enabled.store(enable, std::memory_order_relaxed); }
+
+    // Monotonic time in nanoseconds
+    static uint64 Now();
+
+    void RecordHook(const char* type, uint32 event, uint64 duration);
+
+    /*
+     * Returns the stats of the function at `index` of the stack of `L`, which are
+     *   created on the first call of a function defined there. The stats stay valid until `Clear`.
+     */
+    HandlerStats* GetHandler(lua_State* L, int index);
+    void RecordHandler(HandlerStats* handler, uint64 duration);
+
+    // Zeroes the stats, can be called from any thread
+    void Reset();
+    // Removes the stats, only from the thread of the state, when its functions are gone
+    void Clear();
+
+    // Call `f(hooks, handlers)` with the stats, under the lock of the profiler
+    template<typename F>
+    void Read(F f)
+    {
+        Guard guard(GetLock());
+        f(static_cast<const HookMap&>(hooks), static_cast<const HandlerMap&>(handlers));
+    }
+
+private:
+    std::atomic<bool> enabled;
+    HookMap hooks;
+    HandlerMap handlers;
+};
+
+#endif // _ELUNA_PROFILER_H
@@ -0,0 +1,118 @@
+/*
+* Copyright (C) 2010 - 2016 Eluna Lua Engine <http://emudevs.com/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#include "ElunaSampler.h"
+
+#include <fstream>
+
+bool SamplingProfiler::Start(uint32 seconds, bool timeBased, uint32 period)
+{
+    Guard guard(GetLock());
+
+    if (IsRunning())
+        return false;
+
+    stacks.clear();
+    sampleCount = 0;
+    startTime = ElunaUtil::GetCurrTime();
+    duration = seconds * IN_MILLISECONDS;
+    hookCount = timeBased ? TIME_CHECK_INSTRUCTIONS : period;
+    interval = timeBased ? period : 0;
+
+    ++session;
+    // The parameters are published with the flag, states read them once they see it set
+    running.store(true, std::memory_order_release);
+    return true;
+}
+
+bool SamplingProfiler::Stop()
+{
+    Guard guard(GetLock());
+
+    if (!IsRunning())
+        return false;
+
+    running.store(false, std::memory_order_release);
+    return true;
+}
+
+uint64 SamplingProfiler::GetSampleCount()
+{
+    Guard guard(GetLock());
+    return sampleCount;
+}
+
+// Appends the name of a frame, e.g. `OnLogin (lua_scripts/login.lua:12)`
+static void AppendFrame(std::string& stack, const lua_Debug& ar)
+{
+    size_t start = stack.size();
+
+    if (*ar.what == 'C')
+    {
+        stack += ar.name ? ar.name : "?";
+        stack += " [C]";
+    }
+    else
+    {
+        stack += ar.name ? ar.name : (*ar.what == 'm' ? "main" : "?");
+        stack += " (";
+        stack += ar.short_src;
+        if (ar.linedefined > 0)
+        {
+            stack += ':';
+            stack += std::to_string(ar.linedefined);
+        }
+        stack += ')';
+    }
+
+    // `;` separates the frames of the folded format
+    for (size_t i = start; i < stack.size(); ++i)
+        if (stack[i] == ';')
+            stack[i] = ':';
+}
+
+void SamplingProfiler::Sample(lua_State* L, const std::string& root, uint32 count)
+{
+    lua_Debug frames[MAX_DEPTH];
+    int depth = 0;
+    while (depth < static_cast<int>(MAX_DEPTH) && lua_getstack(L, depth, &frames[depth]))
+    {
+        lua_getinfo(L, "Sn", &frames[depth]);
+        ++depth;
+    }
+
+    // Folded stacks start at the root, the outermost frame
+    std::string stack = root;
+    for (int level = depth - 1; level >= 0; --level)
+    {
+        stack += ';';
+        AppendFrame(stack, frames[level]);
+    }
+
+    Guard guard(GetLock());
+
+    // The hook of a state can outlive the session until the state's next update
+    if (!IsRunning())
+        return;
+
+    stacks[stack] += count;
+    sampleCount += count;
+}
+
+bool SamplingProfiler::WriteFolded(const std::string& path)
+{
+    Guard guard(GetLock());
+
+    std::ofstream file(path.c_str(), std::ios::out | std::ios::trunc);
+    if (!file)
+        return false;
+
+    for (auto itr = stacks.begin(); itr != stacks.end(); ++itr)
+        file << itr->first << ' ' << itr->second << '\n';
+
+    stacks.clear();
+    return file.good();
+}
@@ -0,0 +1,101 @@
+/*
+* Copyright (C) 2010 - 2016 Eluna Lua Engine <http://emudevs.com/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#ifndef _ELUNA_SAMPLER_H
+#define _ELUNA_SAMPLER_H
+
+#include <atomic>
+#include <string>
+#include <unordered_map>
+#include "Common.h"
+#include "ElunaUtility.h"
+
+extern "C"
+{
+#include "lua.h"
+};
+
+/*
+ * A sampling profiler of the Lua code of all states, see `.eluna profile`.
+ *
+ * While a session runs, every state has a count hook installed that samples the Lua call stack,
+ *   either on every call of the hook or once per `interval` microseconds of running Lua code,
+ *   as accounted by `Eluna::SampleHook`.
+ *   The stacks are aggregated as folded stacks, the format read by flamegraph.pl:
+ *   one line per distinct stack, frames from the root separated by `;`, followed by the sample count.
+ *
+ * States install and remove the hook themselves on their update, see `Eluna::UpdateSampling`,
+ *   the samples are collected from all threads under the lock of the profiler. Coroutines created
+ *   during a session are sampled as they inherit the hook, ones created before it are not.
+ *   A coroutine outliving the session removes the hook on its next call.
+ */
+class SamplingProfiler : public ElunaUtil::Lockable
+{
+public:
+    // Instructions between hook calls in time based sessions
+    static const uint32 TIME_CHECK_INSTRUCTIONS = 1000;
+    // Microseconds counted for the instructions between two hook calls at most, longer gaps are time spent outside of Lua
+    static const uint32 MAX_HOOK_GAP = 1000;
+    // Frames sampled from the top of the stack, deeper ones are dropped
+    static const uint32 MAX_DEPTH = 64;
+
+    SamplingProfiler() :
+        session(0),
+        running(false),
+        startTime(0),
+        duration(0),
+        hookCount(0),
+        interval(0),
+        sampleCount(0)
+    { }
+
+    /*
+     * Starts a session of `seconds`. With `timeBased` a sample is taken every `period` microseconds
+     *   of Lua execution, otherwise every `period` Lua instructions.
+     *
+     * Returns false if a session is already running.
+     */
+    bool Start(uint32 seconds, bool timeBased, uint32 period);
+
+    // Ends the session, returns false if none was running
+    bool Stop();
+
+    bool IsRunning() const { return running.load(std::memory_order_acquire); }
+    bool IsExpired() const { return IsRunning() && ElunaUtil::GetTimeDiff(startTime) >= duration; }
+
+    // Identifies the session, so states notice a new one. 0 when none is running.
+    uint32 GetSession() const { return IsRunning() ? session.load(std::memory_order_relaxed) : 0; }
+    // Instruction count to install the hook with
+    uint32 GetHookCount() const { return hookCount; }
+    // Microseconds between samples, 0 to sample on every hook call
+    uint32 GetInterval() const { return interval; }
+    uint64 GetSampleCount();
+
+    /*
+     * Adds `count` samples of the call stack of `L`, with `root` as the outermost frame.
+     */
+    void Sample(lua_State* L, const std::string& root, uint32 count);
+
+    /*
+     * Writes the folded stacks of the last session to `path` and forgets them.
+     *
+     * Returns false if the file could not be written.
+     */
+    bool WriteFolded(const std::string& path);
+
+private:
+    std::atomic<uint32> session;
+    std::atomic<bool> running;
+    uint32 startTime;
+    uint32 duration;    // Milliseconds
+    uint32 hookCount;
+    uint32 interval;
+
+    uint64 sampleCount;
+    std::unordered_map<std::string, uint64> stacks;
+};
+
+#endif // _ELUNA_SAMPLER_H
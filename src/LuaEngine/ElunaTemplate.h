@@ -17,10 +17,13 @@ extern "C"
 #include "ElunaCompat.h"
 #include "ElunaUtility.h"
 #include "SharedDefines.h"
+#include <new>
 
 class ElunaGlobal
 {
 public:
+#ifndef NDEBUG
+    // Checks the amount of results global functions return, release builds call the functions directly
     static int thunk(lua_State* L)
     {
         luaL_Reg* l = static_cast<luaL_Reg*>(lua_touserdata(L, lua_upvalueindex(1)));
@@ -35,6 +38,7 @@ public:
         lua_settop(L, top + expected);
         return expected;
     }
+#endif
 
     static void SetMethods(Eluna* E, luaL_Reg* methodTable)
     {
@@ -46,8 +50,12 @@ public:
         for (; methodTable && methodTable->name && methodTable->func; ++methodTable)
         {
             lua_pushstring(E->L, methodTable->name);
+#ifndef NDEBUG
             lua_pushlightuserdata(E->L, (void*)methodTable);
             lua_pushcclosure(E->L, thunk, 1);
+#else
+            lua_pushcfunction(E->L, methodTable->func);
+#endif
             lua_rawset(E->L, -3);
         }
 
@@ -59,7 +67,7 @@ class ElunaObject
 {
 public:
     template<typename T>
-    ElunaObject(T * obj, bool manageMemory);
+    ElunaObject(Eluna* E, T * obj, bool manageMemory);
 
     ~ElunaObject()
     {
@@ -68,11 +76,19 @@ public:
     // Get wrapped object pointer
     void* GetObj() const { return object; }
     // Returns whether the object is valid or not
-    bool IsValid() const { return !callstackid || callstackid == sEluna->GetCallstackId(); }
+    bool IsValid() const { return !callstackid || callstackid == E->GetCallstackId(); }
+    // Returns whether the object was made valid during the current call stack and will be invalidated at its end
+    bool IsValidForCallstack() const { return callstackid == E->GetCallstackId(); }
     // Returns whether the object can be invalidated or not
     bool CanInvalidate() const { return _invalidate; }
+    // Returns whether the wrapped object is deleted when the userdata is collected
+    bool IsOwner() const { return owner; }
     // Returns pointer to the wrapped object's type name
     const char* GetTypeName() const { return type_name; }
+    // Returns the type ID of the wrapped object's type
+    uint32 GetTypeId() const { return typeId; }
+    // Returns whether the wrapped object is of the type with the given ID or a type derived from it
+    bool IsA(uint32 id) const { return (typeMask >> id) & 1; }
 
     // Sets the object pointer that is wrapped
     void SetObj(void* obj)
@@ -87,7 +103,7 @@ public:
         ASSERT(!valid || (valid && object));
         if (valid)
             if (CanInvalidate())
-                callstackid = sEluna->GetCallstackId();
+                callstackid = E->GetCallstackId();
             else
                 callstackid = 0;
         else
@@ -104,27 +120,85 @@ public:
         if (CanInvalidate())
             callstackid = 1;
     }
+    // Replaces the wrapped object of a view (see ElunaTemplate::PushView) with a copy the userdata owns from now on
+    void Adopt(void* obj)
+    {
+        owner = true;
+        _invalidate = false;
+        SetObj(obj);
+    }
 
 private:
+    // The state the object was pushed to, call stacks are counted per state
+    Eluna* E;
     uint64 callstackid;
     bool _invalidate;
+    bool owner;
     void* object;
     const char* type_name;
+    uint32 typeId;
+    uint64 typeMask;
+
+public:
+    // The most types ElunaTemplate can register, each needs a bit in the type masks
+    static const uint32 MAX_TYPES = 64;
+    // Type IDs handed out so far
+    static uint32 typeCount;
 };
 
+// A method of T, `mfunc` is the ElunaMethod<...>::Call of the method
 template<typename T>
 struct ElunaRegister
 {
     const char* name;
-    int(*mfunc)(lua_State*, T*);
+    lua_CFunction mfunc;
+};
+
+template<auto Method>
+struct ElunaMethod;
+
+/*
+ * Calls `Method` with self, a function is generated per method so the compiler can inline the method into it.
+ *
+ * Methods can return more results than they push, the missing results are nil.
+ * Debug builds also check that methods don't push more results than they return.
+ */
+template<typename T, int(*Method)(lua_State*, T*)>
+struct ElunaMethod<Method>
+{
+    static int Call(lua_State* L)
+    {
+        T* obj = Eluna::CHECKOBJ<T>(L, 1); // get self
+        if (!obj)
+            return 0;
+        int top = lua_gettop(L);
+        int expected = Method(L, obj);
+#ifndef NDEBUG
+        int args = lua_gettop(L) - top;
+        if (args < 0 || args > expected)
+        {
+            ELUNA_LOG_ERROR("[Eluna]: {} returned unexpected amount of arguments {} out of {}. Report to devs", lua_tostring(L, lua_upvalueindex(1)), args, expected);
+            ASSERT(false);
+        }
+#endif
+        lua_settop(L, top + expected);
+        return expected;
+    }
 };
 
 template<typename T>
 class ElunaTemplate
 {
 public:
+    typedef T* (*UpcastFunc)(void*);
+
     static const char* tname;
     static bool manageMemory;
+    // The type ID and the IDs of the base types this type was given the methods of, see SetMethods
+    static uint32 typeId;
+    static uint64 typeMask;
+    // Converts a pointer to an object pushed as the type with the ID of the index to T, for types that are a T
+    static UpcastFunc upcasts[ElunaObject::MAX_TYPES];
 
     // name will be used as type name
     // If gc is true, lua will handle the memory management for object pushed
@@ -145,6 +219,27 @@ public:
         tname = name;
         manageMemory = gc;
 
+        // IDs are shared by all states, they are assigned once when the first state registers the type
+        if (!typeMask)
+        {
+            ASSERT(ElunaObject::typeCount < ElunaObject::MAX_TYPES);
+            typeId = ElunaObject::typeCount++;
+            typeMask = uint64(1) << typeId;
+            upcasts[typeId] = &Upcast<T>;
+        }
+
+        // create the cache of userdata pushed during the current call stack, see Push
+        if (!manageMemory)
+        {
+            lua_pushlightuserdata(E->L, (void*)&tname);
+            lua_newtable(E->L);
+            lua_newtable(E->L);
+            lua_pushstring(E->L, "v");
+            lua_setfield(E->L, -2, "__mode");
+            lua_setmetatable(E->L, -2);
+            lua_rawset(E->L, LUA_REGISTRYINDEX);
+        }
+
         // create metatable for userdata of this type
         luaL_newmetatable(E->L, tname);
         int metatable  = lua_gettop(E->L);
@@ -236,6 +331,11 @@ public:
         ASSERT(tname);
         ASSERT(methodTable);
 
+        // Getting the methods of C makes this type a C for CHECKOBJ
+        ASSERT(ElunaTemplate<C>::typeMask);
+        typeMask |= ElunaTemplate<C>::typeMask;
+        ElunaTemplate<C>::upcasts[typeId] = &Upcast<C>;
+
         // get metatable
         lua_pushstring(E->L, tname);
         lua_rawget(E->L, LUA_REGISTRYINDEX);
@@ -244,14 +344,21 @@ public:
         for (; methodTable && methodTable->name && methodTable->mfunc; ++methodTable)
         {
             lua_pushstring(E->L, methodTable->name);
-            lua_pushlightuserdata(E->L, (void*)methodTable);
-            lua_pushcclosure(E->L, CallMethod, 1);
+#ifndef NDEBUG
+            // The name is only used by the result count check
+            lua_pushstring(E->L, methodTable->name);
+            lua_pushcclosure(E->L, methodTable->mfunc, 1);
+#else
+            lua_pushcfunction(E->L, methodTable->mfunc);
+#endif
             lua_rawset(E->L, -3);
         }
 
         lua_pop(E->L, 1);
     }
 
+    // Objects the core owns are pushed as the same userdata for the rest of the call stack,
+    // they are cached in a weak table by pointer until the userdata is collected or invalidated
     static int Push(lua_State* L, T const* obj)
     {
         if (!obj)
@@ -260,15 +367,56 @@ public:
             return 1;
         }
 
-        // Create new userdata
-        ElunaObject** ptrHold = static_cast<ElunaObject**>(lua_newuserdata(L, sizeof(ElunaObject*)));
-        if (!ptrHold)
+        if (manageMemory)
+            return PushNew(L, obj);
+
+        lua_pushlightuserdata(L, (void*)&tname);
+        lua_rawget(L, LUA_REGISTRYINDEX);
+        // Stack: cache
+        lua_pushlightuserdata(L, const_cast<T*>(obj));
+        lua_rawget(L, -2);
+        // Stack: cache, userdata or nil
+        ElunaObject* elunaObj = static_cast<ElunaObject*>(lua_touserdata(L, -1));
+        if (!elunaObj || !elunaObj->IsValidForCallstack())
+        {
+            lua_pop(L, 1);
+            PushNew(L, obj);
+            lua_pushlightuserdata(L, const_cast<T*>(obj));
+            lua_pushvalue(L, -2);
+            lua_rawset(L, -4);
+        }
+        // Stack: cache, userdata
+        lua_remove(L, -2);
+        return 1;
+    }
+
+    /*
+     * Pushes a view of `obj` for a type whose pushed objects Lua usually owns.
+     *
+     * The view is not cached, does not delete `obj` and is invalidated at the end of the call stack.
+     * Methods that change the object must make it a copy first with ElunaObject::Adopt.
+     */
+    static int PushView(lua_State* L, T const* obj)
+    {
+        if (!obj)
+        {
+            lua_pushnil(L);
+            return 1;
+        }
+        return PushNew(L, obj, false);
+    }
+
+    static int PushNew(lua_State* L, T const* obj, bool owner = manageMemory)
+    {
+        // Create new userdata, the ElunaObject lives in its memory
+        void* memory = lua_newuserdata(L, sizeof(ElunaObject));
+        if (!memory)
         {
             ELUNA_LOG_ERROR("{} could not create new userdata", tname);
             lua_pushnil(L);
             return 1;
         }
-        *ptrHold = new ElunaObject(const_cast<T*>(obj), manageMemory);
+        new (memory) ElunaObject(Eluna::GetEluna(L), const_cast<T*>(obj), owner);
 
         // Set metatable for it
         lua_pushstring(L, tname);
@@ -284,9 +432,15 @@ public:
         return 1;
     }
 
+    template<typename Base>
+    static Base* Upcast(void* obj)
+    {
+        return static_cast<T*>(obj);
+    }
+
     static T* Check(lua_State* L, int narg, bool error = true)
     {
-        ElunaObject* elunaObj = Eluna::CHECKTYPE(L, narg, tname, error);
+        ElunaObject* elunaObj = Eluna::CHECKTYPE(L, narg, tname, typeId, error);
         if (!elunaObj)
             return NULL;
 
@@ -304,7 +458,7 @@ public:
             }
             return NULL;
         }
-        return static_cast<T*>(elunaObj->GetObj());
+        return upcasts[elunaObj->GetTypeId()](elunaObj->GetObj());
     }
 
     static int GetType(lua_State* L)
@@ -322,24 +476,6 @@ public:
         return 0;
     }
 
-    static int CallMethod(lua_State* L)
-    {
-        T* obj = Eluna::CHECKOBJ<T>(L, 1); // get self
-        if (!obj)
-            return 0;
-        ElunaRegister<T>* l = static_cast<ElunaRegister<T>*>(lua_touserdata(L, lua_upvalueindex(1)));
-        int top = lua_gettop(L);
-        int expected = l->mfunc(L, obj);
-        int args = lua_gettop(L) - top;
-        if (args < 0 || args > expected)
-        {
-            ELUNA_LOG_ERROR("[Eluna]: {} returned unexpected amount of arguments {} out of {}. Report to devs", l->name, args, expected);
-            ASSERT(false);
-        }
-        lua_settop(L, top + expected);
-        return expected;
-    }
-
     // Metamethods ("virtual")
 
     // Remember special cases like ElunaTemplate<Vehicle>::CollectGarbage
@@ -347,9 +483,11 @@ public:
     {
         // Get object pointer (and check type, no error)
         ElunaObject* obj = Eluna::CHECKOBJ<ElunaObject>(L, 1, false);
-        if (obj && manageMemory)
+        if (!obj)
+            return 0;
+        if (obj->IsOwner())
             delete static_cast<T*>(obj->GetObj());
-        delete obj;
+        obj->~ElunaObject();
         return 0;
     }
 
@@ -378,12 +516,16 @@ public:
 };
 
 template<typename T>
-ElunaObject::ElunaObject(T * obj, bool manageMemory) : callstackid(1), _invalidate(!manageMemory), object(obj), type_name(ElunaTemplate<T>::tname)
+ElunaObject::ElunaObject(Eluna* E, T * obj, bool manageMemory) : E(E), callstackid(1), _invalidate(!manageMemory), owner(manageMemory), object(obj), type_name(ElunaTemplate<T>::tname),
+    typeId(ElunaTemplate<T>::typeId), typeMask(ElunaTemplate<T>::typeMask)
 {
     SetValid(true);
 }
 
 template<typename T> const char* ElunaTemplate<T>::tname = NULL;
 template<typename T> bool ElunaTemplate<T>::manageMemory = false;
+template<typename T> uint32 ElunaTemplate<T>::typeId = 0;
+template<typename T> uint64 ElunaTemplate<T>::typeMask = 0;
+template<typename T> typename ElunaTemplate<T>::UpcastFunc ElunaTemplate<T>::upcasts[ElunaObject::MAX_TYPES] = {};
 
 #endif
@@ -0,0 +1,114 @@
+/*
+* Copyright (C) 2010 - 2016 Eluna Lua Engine <http://emudevs.com/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#include "ElunaTextMatcher.h"
+#include "ElunaUtility.h"
+
+#include <cctype>
+#include <queue>
+
+static const uint32 NO_STATE = 0xFFFFFFFF;
+
+ElunaTextMatcher::ElunaTextMatcher(bool caseInsensitive) :
+    caseInsensitive(caseInsensitive),
+    classCount(1)
+{
+    for (uint32 i = 0; i < 256; ++i)
+        classes[i] = 0;
+}
+
+void ElunaTextMatcher::AddWord(const char* word, size_t length)
+{
+    ASSERT(length > 0);
+
+    std::string folded(word, length);
+    if (caseInsensitive)
+        for (size_t i = 0; i < folded.size(); ++i)
+            folded[i] = static_cast<char>(std::tolower(static_cast<unsigned char>(folded[i])));
+
+    words.push_back(folded);
+    wordLengths.push_back(static_cast<uint32>(length));
+}
+
+void ElunaTextMatcher::Build()
+{
+    // Give every byte used by a word its own class, the rest stay in class 0
+    uint8 folded[256];
+    for (uint32 i = 0; i < 256; ++i)
+        folded[i] = caseInsensitive ? static_cast<uint8>(std::tolower(static_cast<int>(i))) : static_cast<uint8>(i);
+
+    bool used[256] = { };
+    for (auto itr = words.begin(); itr != words.end(); ++itr)
+        for (size_t i = 0; i < itr->size(); ++i)
+            used[static_cast<uint8>((*itr)[i])] = true;
+
+    classCount = 1;
+    for (uint32 i = 0; i < 256; ++i)
+        if (used[i])
+            classes[i] = static_cast<uint16>(classCount++);
+    for (uint32 i = 0; i < 256; ++i)
+        classes[i] = classes[folded[i]];
+
+    // Build the trie of the words
+    transitions.assign(classCount, NO_STATE);
+    wordOf.assign(1, 0);
+    for (uint32 index = 0; index < words.size(); ++index)
+    {
+        const std::string& word = words[index];
+        uint32 state = 0;
+        for (size_t i = 0; i < word.size(); ++i)
+        {
+            uint32& next = transitions[state * classCount + classes[static_cast<uint8>(word[i])]];
+            if (next == NO_STATE)
+            {
+                next = static_cast<uint32>(wordOf.size());
+                wordOf.push_back(0);
+                transitions.resize(transitions.size() + classCount, NO_STATE);
+            }
+            state = transitions[state * classCount + classes[static_cast<uint8>(word[i])]];
+        }
+        if (!wordOf[state])
+            wordOf[state] = index + 1;
+    }
+
+    // Turn it into the automaton breadth first, missing edges follow the suffix links
+    std::vector<uint32> suffixLink(wordOf.size(), 0);
+    outputLink.assign(wordOf.size(), 0);
+
+    std::queue<uint32> queue;
+    for (uint32 c = 0; c < classCount; ++c)
+    {
+        uint32& next = transitions[c];
+        if (next == NO_STATE)
+            next = 0;
+        else
+            queue.push(next);
+    }
+
+    while (!queue.empty())
+    {
+        uint32 state = queue.front();
+        queue.pop();
+
+        for (uint32 c = 0; c < classCount; ++c)
+        {
+            uint32& next = transitions[state * classCount + c];
+            uint32 fallback = transitions[suffixLink[state] * classCount + c];
+            if (next == NO_STATE)
+            {
+                next = fallback;
+                continue;
+            }
+
+            suffixLink[next] = fallback;
+            outputLink[next] = wordOf[fallback] ? fallback : outputLink[fallback];
+            queue.push(next);
+        }
+    }
+
+    // Only the automaton is needed from now on
+    std::vector<std::string>().swap(words);
+}
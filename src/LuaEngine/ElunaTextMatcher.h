@@ -0,0 +1,87 @@
+/*
+* Copyright (C) 2010 - 2016 Eluna Lua Engine <http://emudevs.com/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#ifndef _ELUNA_TEXT_MATCHER_H
+#define _ELUNA_TEXT_MATCHER_H
+
+#include <string>
+#include <vector>
+#include "Common.h"
+
+/*
+ * A set of words compiled into an Aho-Corasick automaton, see `CreateTextMatcher`.
+ *
+ * A text is scanned for all words in one pass over its bytes, independent of the number of words.
+ *   The automaton is a full transition table over byte classes: bytes that occur in no word share
+ *   one class, so the table stays small and every byte costs two lookups.
+ *
+ * Case-insensitive matching folds ASCII letters through the byte class table,
+ *   the scanned text is never copied.
+ */
+class ElunaTextMatcher
+{
+public:
+    ElunaTextMatcher(bool caseInsensitive);
+
+    /*
+     * Adds a word, before `Build` is called. Words must not be empty.
+     *
+     * If the same word is added more than once, matches report the first index.
+     */
+    void AddWord(const char* word, size_t length);
+
+    /*
+     * Compiles the added words into the automaton.
+     */
+    void Build();
+
+    uint32 GetWordCount() const { return static_cast<uint32>(wordLengths.size()); }
+    uint32 GetWordLength(uint32 index) const { return wordLengths[index]; }
+    bool IsCaseInsensitive() const { return caseInsensitive; }
+
+    /*
+     * Calls `f(index, start, end)` for every occurrence of a word in `text`, in the order the occurrences end.
+     *
+     * `index` is the 0-based index of the word, `start` and `end` are the 0-based offsets
+     *   of its first and one past its last byte. Overlapping occurrences are all reported.
+     *   The scan stops early if `f` returns false.
+     */
+    template<typename F>
+    void Scan(const char* text, size_t length, F f) const
+    {
+        const uint8* bytes = reinterpret_cast<const uint8*>(text);
+        uint32 state = 0;
+        for (size_t i = 0; i < length; ++i)
+        {
+            state = transitions[state * classCount + classes[bytes[i]]];
+            uint32 output = wordOf[state] ? state : outputLink[state];
+            while (output)
+            {
+                uint32 index = wordOf[output] - 1;
+                if (!f(index, i + 1 - wordLengths[index], i + 1))
+                    return;
+                output = outputLink[output];
+            }
+        }
+    }
+
+private:
+    bool caseInsensitive;
+    std::vector<std::string> words;
+
+    // Byte class of every byte, 0 for bytes that occur in no word
+    uint16 classes[256];
+    uint32 classCount;
+    // Next state for each state and byte class, state 0 is the root
+    std::vector<uint32> transitions;
+    // The word each state completes as index + 1, or 0
+    std::vector<uint32> wordOf;
+    // The nearest state on the suffix link chain that completes a word, or 0
+    std::vector<uint32> outputLink;
+    std::vector<uint32> wordLengths;
+};
+
+#endif // _ELUNA_TEXT_MATCHER_H
@@ -7,6 +7,7 @@
 #ifndef _ELUNA_UTIL_H
 #define _ELUNA_UTIL_H
 
+#include <atomic>
 #include <unordered_map>
 #include <unordered_set>
 #include <mutex>
@@ -119,6 +120,69 @@ namespace ElunaUtil
         LockType _lock;
     };
 
+    /*
+     * Lock-free queue with many producers and a single consumer.
+     *
+     * Any thread can `Enqueue`, only one thread at a time may `DequeueAll`.
+     * `DequeueAll` takes everything queued so far in one atomic exchange
+     * and hands it to `f` in the order it was queued.
+     */
+    template<typename T>
+    class MPSCQueue
+    {
+    public:
+        MPSCQueue() : head(NULL) { }
+        ~MPSCQueue() { DequeueAll([](T&) { }); }
+
+        void Enqueue(T&& value)
+        {
+            Node* node = new Node(std::move(value));
+            node->next = head.load(std::memory_order_relaxed);
+            while (!head.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed))
+                ;
+        }
+
+        bool Empty() const { return head.load(std::memory_order_relaxed) == NULL; }
+
+        template<typename F>
+        void DequeueAll(F f)
+        {
+            Node* node = head.exchange(NULL, std::memory_order_acquire);
+
+            // The producers push to the front, reverse to get the queued order back
+            Node* ordered = NULL;
+            while (node)
+            {
+                Node* next = node->next;
+                node->next = ordered;
+                ordered = node;
+                node = next;
+            }
+
+            while (ordered)
+            {
+                Node* next = ordered->next;
+                f(ordered->value);
+                delete ordered;
+                ordered = next;
+            }
+        }
+
+    private:
+        struct Node
+        {
+            explicit Node(T&& value) : value(std::move(value)), next(NULL) { }
+
+            T value;
+            Node* next;
+        };
+
+        std::atomic<Node*> head;
+
+        MPSCQueue(MPSCQueue const&) = delete;
+        MPSCQueue& operator=(MPSCQueue const&) = delete;
+    };
+
     /*
      * Encodes `data` in Base-64 and store the result in `output`.
      */
@@ -9,14 +9,18 @@
 
 #include "LuaEngine.h"
 #include "ElunaUtility.h"
+#include "ElunaProfiler.h"
 
 /*
  * Sets up the stack so that event handlers can be called.
  *
+ * Handlers registered with a filter are only pushed if it matches `filter`.
  * Returns the number of functions that were pushed onto the stack.
+ * The functions of `bindings2` are called before those of `bindings1`,
+ *   priorities only order the handlers within each of them.
  */
 template<typename K1, typename K2>
-int Eluna::SetupStack(BindingMap<K1>* bindings1, BindingMap<K2>* bindings2, const K1& key1, const K2& key2, int number_of_arguments)
+int Eluna::SetupStack(BindingMap<K1>* bindings1, BindingMap<K2>* bindings2, const K1& key1, const K2& key2, int number_of_arguments, const BindingFilterArgs* filter)
 {
     ASSERT(number_of_arguments == this->push_counter);
     ASSERT(key1.event_id == key2.event_id);
@@ -34,9 +38,9 @@ int Eluna::SetupStack(BindingMap<K1>* bindings1, BindingMap<K2>* bindings2, cons
     lua_insert(L, first_argument_index);
     // Stack: event_id, [arguments]
 
-    bindings1->PushRefsFor(key1);
+    bindings1->PushRefsFor(key1, &pushedBindings, filter);
     if (bindings2)
-        bindings2->PushRefsFor(key2);
+        bindings2->PushRefsFor(key2, &pushedBindings, filter);
     // Stack: event_id, [arguments], [functions]
 
     int number_of_functions = lua_gettop(L) - arguments_top;
@@ -63,19 +67,20 @@ void Eluna::ReplaceArgument(T value, uint8 index)
  * Call all event handlers registered to the event ID/entry combination and ignore any results.
  */
 template<typename K1, typename K2>
-void Eluna::CallAllFunctions(BindingMap<K1>* bindings1, BindingMap<K2>* bindings2, const K1& key1, const K2& key2)
+void Eluna::CallAllFunctions(BindingMap<K1>* bindings1, BindingMap<K2>* bindings2, const K1& key1, const K2& key2, const BindingFilterArgs* filter)
 {
     int number_of_arguments = this->push_counter;
     // Stack: [arguments]
 
-    int number_of_functions = SetupStack(bindings1, bindings2, key1, key2, number_of_arguments);
+    int number_of_functions = SetupStack(bindings1, bindings2, key1, key2, number_of_arguments, filter);
     // Stack: event_id, [arguments], [functions]
 
-    while (number_of_functions > 0)
+    if (number_of_functions > 0)
     {
-        CallOneFunction(number_of_functions, number_of_arguments, 0);
-        --number_of_functions;
-        // Stack: event_id, [arguments], [functions - 1]
+        uint64 start = profiler->IsEnabled() ? HookProfiler::Now() : 0;
+        CallFunctions(number_of_functions, number_of_arguments, false, false);
+        if (start)
+            profiler->RecordHook(bindings1->GetName(), key1.event_id, HookProfiler::Now() - start);
     }
     // Stack: event_id, [arguments]
 
@@ -87,29 +92,26 @@ void Eluna::CallAllFunctions(BindingMap<K1>* bindings1, BindingMap<K2>* bindings
  * Call all event handlers registered to the event ID/entry combination,
  *   and returns `default_value` if ALL event handlers returned `default_value`,
  *   otherwise returns the opposite of `default_value`.
+ *
+ * Handlers registered with `stopOnResult` end the dispatch once the result is decided.
  */
 template<typename K1, typename K2>
-bool Eluna::CallAllFunctionsBool(BindingMap<K1>* bindings1, BindingMap<K2>* bindings2, const K1& key1, const K2& key2, bool default_value/* = false*/)
+bool Eluna::CallAllFunctionsBool(BindingMap<K1>* bindings1, BindingMap<K2>* bindings2, const K1& key1, const K2& key2, bool default_value/* = false*/, const BindingFilterArgs* filter/* = NULL*/)
 {
     bool result = default_value;
     // Note: number_of_arguments here does not count in eventID, which is pushed in SetupStack
     int number_of_arguments = this->push_counter;
     // Stack: [arguments]
 
-    int number_of_functions = SetupStack(bindings1, bindings2, key1, key2, number_of_arguments);
+    int number_of_functions = SetupStack(bindings1, bindings2, key1, key2, number_of_arguments, filter);
     // Stack: event_id, [arguments], [functions]
 
-    while (number_of_functions > 0)
+    if (number_of_functions > 0)
     {
-        int r = CallOneFunction(number_of_functions, number_of_arguments, 1);
-        --number_of_functions;
-        // Stack: event_id, [arguments], [functions - 1], result
-
-        if (lua_isboolean(L, r) && (lua_toboolean(L, r) == 1) != default_value)
-            result = !default_value;
-
-        lua_pop(L, 1);
-        // Stack: event_id, [arguments], [functions - 1]
+        uint64 start = profiler->IsEnabled() ? HookProfiler::Now() : 0;
+        result = CallFunctions(number_of_functions, number_of_arguments, true, default_value);
+        if (start)
+            profiler->RecordHook(bindings1->GetName(), key1.event_id, HookProfiler::Now() - start);
     }
     // Stack: event_id, [arguments]
 
@@ -17,7 +17,7 @@
  *         return;
  *
  *     // Lock out any other threads.
- *     LOCK_ELUNA;
+ *     LOCK_ELUNA_STATE(this);
  *
  *     // Push extra arguments, if any.
  *     Push(a);
@@ -35,7 +35,7 @@
  *          return;
  *
  *     // Lock out any other threads.
- *     LOCK_ELUNA;
+ *     LOCK_ELUNA_STATE(this);
  *
  *     // Push extra arguments, if any.
  *     Push(a);
@@ -60,6 +60,11 @@
  *
  *         // Pop the results off the stack.
  *         lua_pop(L, 2);
+ *
+ *         // Optionally, once the result can't change anymore, skip the remaining
+ *         //   handlers if the handler just called was registered with `stop`.
+ *         if (first != 0 && StopsDispatch(n))
+ *             break;
  *     }
  *
  *     // Clean-up the stack. Argument is 3 because we did 3 Pushes.
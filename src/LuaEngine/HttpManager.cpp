@@ -36,7 +36,7 @@ HttpManager::HttpManager()
     condVarMutex(),
     parseUrlRegex("^(([^:/?#]+):)?(//([^/?#]*))?([^?#]*)(\\?([^#]*))?(#(.*))?")
 {
-    StartHttpWorker();
+    // The worker thread is started on the first request, most Lua states never make one
 }
 
 HttpManager::~HttpManager()
@@ -46,6 +46,9 @@ HttpManager::~HttpManager()
 
 void HttpManager::PushRequest(HttpWorkItem* item)
 {
+    if (!startedWorkerThread)
+        StartHttpWorker();
+
     std::unique_lock<std::mutex> lock(condVarMutex);
     workQueue.push(item);
     condVar.notify_one();
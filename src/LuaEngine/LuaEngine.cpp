@@ -7,6 +7,10 @@
 #include "Hooks.h"
 #include "LuaEngine.h"
 #include "BindingMap.h"
+#include "CommandTrie.h"
+#include "ElunaAllocator.h"
+#include "ElunaProfiler.h"
+#include "ElunaSampler.h"
 #include "Chat.h"
 #include "ElunaCompat.h"
 #include "ElunaEventMgr.h"
@@ -25,6 +29,9 @@
 #define USING_BOOST
 
 #include <boost/filesystem.hpp>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
 
 extern "C"
 {
@@ -44,7 +51,13 @@ std::string Eluna::lua_requirecpath;
 Eluna* Eluna::GEluna = NULL;
 bool Eluna::reload = false;
 bool Eluna::initialized = false;
+bool Eluna::multiState = false;
+bool Eluna::nativeIntegers = false;
 Eluna::LockType Eluna::lock;
+Eluna::MapStates Eluna::mapStates;
+uint32 ElunaObject::typeCount = 0;
+std::shared_mutex Eluna::mapStatesLock;
+SamplingProfiler Eluna::sampler;
 
 extern void RegisterFunctions(Eluna* E);
 
@@ -59,6 +72,12 @@ void Eluna::Initialize()
 
     LoadScriptPaths();
 
+    multiState = eConfigMgr->GetOption<bool>("Eluna.MultiState", false);
+    if (multiState)
+        ELUNA_LOG_INFO("[Eluna]: Multi-state mode enabled, maps get their own Lua states");
+
+    nativeIntegers = eConfigMgr->GetOption<bool>("Eluna.NativeIntegers", false);
+
     // Must be before creating GEluna
     // This is checked on Eluna creation
     initialized = true;
@@ -72,6 +91,14 @@ void Eluna::Uninitialize()
     LOCK_ELUNA;
     ASSERT(IsInitialized());
 
+    // Maps are normally all unloaded by now, but don't leak states of any that are left
+    {
+        std::unique_lock<std::shared_mutex> guard(mapStatesLock);
+        for (MapStates::iterator itr = mapStates.begin(); itr != mapStates.end(); ++itr)
+            delete itr->second;
+        mapStates.clear();
+    }
+
     delete GEluna;
     GEluna = NULL;
 
@@ -132,31 +159,329 @@ void Eluna::_ReloadEluna()
     else
         ChatHandler(nullptr).SendGMText(SERVER_MSG_STRING, "Reloading Eluna...");
 
+    // Reload script paths
+    LoadScriptPaths();
+
+    sEluna->ReloadState();
+
+    // Map threads are idle during the world update, but maps can still be created from other threads
+    {
+        std::shared_lock<std::shared_mutex> guard(mapStatesLock);
+        for (MapStates::const_iterator itr = mapStates.begin(); itr != mapStates.end(); ++itr)
+            itr->second->ReloadState();
+    }
+
+    reload = false;
+}
+
+void Eluna::ReloadState()
+{
+    LOCK_ELUNA_STATE(this);
+
     // Remove all timed events
-    sEluna->eventMgr->SetStates(LUAEVENT_STATE_ERASE);
+    eventMgr->SetStates(LUAEVENT_STATE_ERASE);
 
     // Close lua
-    sEluna->CloseLua();
-
-    // Reload script paths
-    LoadScriptPaths();
+    CloseLua();
 
     // Open new lua and libaraies
-    sEluna->OpenLua();
+    OpenLua();
 
     // Run scripts from laoded paths
-    sEluna->RunScripts();
+    RunScripts();
+}
 
-    reload = false;
+void Eluna::CreateMapState(Map* map)
+{
+    if (!multiState || !IsInitialized())
+        return;
+
+    // Create and load the state before publishing it, so no hook can see a half loaded state
+    Eluna* E = new Eluna(map);
+    E->RunScripts();
+
+    std::unique_lock<std::shared_mutex> guard(mapStatesLock);
+    Eluna*& state = mapStates[map];
+    ASSERT(!state);
+    state = E;
+}
+
+void Eluna::DestroyMapState(Map* map)
+{
+    if (!multiState || !IsInitialized())
+        return;
+
+    Eluna* E = NULL;
+    {
+        std::unique_lock<std::shared_mutex> guard(mapStatesLock);
+        MapStates::iterator itr = mapStates.find(map);
+        if (itr == mapStates.end())
+            return;
+        E = itr->second;
+        mapStates.erase(itr);
+    }
+
+    delete E;
+}
+
+int32 Eluna::GetStateMapId() const
+{
+    return stateMap ? int32(stateMap->GetId()) : -1;
+}
+
+uint32 Eluna::GetStateInstanceId() const
+{
+    return stateMap ? stateMap->GetInstanceId() : 0;
+}
+
+std::string Eluna::GetStateName() const
+{
+    if (!stateMap)
+        return "World";
+
+    std::string name = "Map " + std::to_string(GetStateMapId());
+    if (uint32 instanceId = GetStateInstanceId())
+        name += " instance " + std::to_string(instanceId);
+    return name;
+}
+
+// Compares a command token with a lowercase word, ignoring the case of the token
+static bool IsCommandToken(const char* token, size_t length, const char* word)
+{
+    size_t i = 0;
+    for (; i < length; ++i)
+        if (!word[i] || std::tolower(static_cast<unsigned char>(token[i])) != word[i])
+            return false;
+    return !word[i];
+}
+
+// Returns the number of a command token, 0 if it is not one
+static uint32 ParseCommandNumber(const char* token, size_t length)
+{
+    return static_cast<uint32>(strtoul(std::string(token, length).c_str(), NULL, 10));
+}
+
+/*
+ * Calls `f(E, name)` for the world state and every map state, with a name for messages.
+ */
+template<typename F>
+void Eluna::ForEachState(F f)
+{
+    f(GEluna, GEluna->GetStateName());
+
+    std::shared_lock<std::shared_mutex> guard(mapStatesLock);
+    for (MapStates::const_iterator itr = mapStates.begin(); itr != mapStates.end(); ++itr)
+        f(itr->second, itr->second->GetStateName());
 }
 
-Eluna::Eluna() :
+/*
+ * Handles the `.eluna` GM commands, called by `OnCommand` for administrators.
+ *
+ * Returns false if `text` is not an `.eluna` command.
+ */
+bool Eluna::HandleElunaCommand(ChatHandler& handler, const char* text)
+{
+    const char* tokens[6] = { };
+    size_t lengths[6] = { };
+    uint32 count = 0;
+    CommandTrie::Tokenize(text, [&](const char* token, size_t length)
+    {
+        tokens[count] = token;
+        lengths[count] = length;
+        return ++count < 6;
+    });
+
+    if (!count || !IsCommandToken(tokens[0], lengths[0], "eluna"))
+        return false;
+
+    // Excludes reloads, which replace the allocators and profiled functions
+    LOCK_ELUNA;
+
+    if (count > 1 && IsCommandToken(tokens[1], lengths[1], "memory"))
+    {
+        ForEachState([&handler](Eluna* E, const std::string& name) { ReportMemory(handler, E, name); });
+        return true;
+    }
+
+    if (count > 1 && IsCommandToken(tokens[1], lengths[1], "stats"))
+    {
+        if (count > 2 && (IsCommandToken(tokens[2], lengths[2], "on") || IsCommandToken(tokens[2], lengths[2], "off")))
+        {
+            bool enable = IsCommandToken(tokens[2], lengths[2], "on");
+            ForEachState([enable](Eluna* E, const std::string& /*name*/) { E->profiler->SetEnabled(enable); });
+            handler.SendSysMessage(enable ? "Eluna hook profiling enabled" : "Eluna hook profiling disabled");
+            return true;
+        }
+
+        if (count > 2 && IsCommandToken(tokens[2], lengths[2], "reset"))
+        {
+            ForEachState([](Eluna* E, const std::string& /*name*/) { E->profiler->Reset(); });
+            handler.SendSysMessage("Eluna hook stats reset");
+            return true;
+        }
+
+        // .eluna stats [top N]
+        uint32 top = 10;
+        uint32 topIndex = count > 2 && IsCommandToken(tokens[2], lengths[2], "top") ? 3 : 2;
+        if (count > topIndex)
+            top = std::max<uint32>(1, ParseCommandNumber(tokens[topIndex], lengths[topIndex]));
+        ReportHookStats(handler, top);
+        return true;
+    }
+
+    if (count > 1 && IsCommandToken(tokens[1], lengths[1], "profile"))
+    {
+        if (count > 2 && IsCommandToken(tokens[2], lengths[2], "stop"))
+        {
+            StopSampling(&handler);
+            return true;
+        }
+
+        if (count > 2 && IsCommandToken(tokens[2], lengths[2], "start"))
+        {
+            // .eluna profile start [seconds] [time microseconds | count instructions]
+            uint32 seconds = count > 3 ? ParseCommandNumber(tokens[3], lengths[3]) : 0;
+            if (!seconds)
+                seconds = 30;
+            bool timeBased = !(count > 4 && IsCommandToken(tokens[4], lengths[4], "count"));
+            uint32 period = count > 5 ? ParseCommandNumber(tokens[5], lengths[5]) : 0;
+            if (!period)
+                period = 1000;
+
+            if (!sampler.Start(seconds, timeBased, period))
+            {
+                handler.SendSysMessage("An Eluna profile is already running, end it with .eluna profile stop");
+                return true;
+            }
+
+            handler.PSendSysMessage("Eluna profile started for {} seconds, sampling every {} {}",
+                seconds, period, timeBased ? "microseconds" : "instructions");
+            return true;
+        }
+    }
+
+    handler.SendSysMessage("Usage: .eluna memory | .eluna stats [top N] | .eluna stats on/off/reset");
+    handler.SendSysMessage("       .eluna profile start [seconds] [time microseconds | count instructions] | .eluna profile stop");
+    return true;
+}
+
+/*
+ * Sends the `top` slowest hooks and handlers by total time, summed over all states, to the command's user.
+ */
+void Eluna::ReportHookStats(ChatHandler& handler, uint32 top)
+{
+    HookProfiler::HookMap hooks;
+    std::unordered_map<std::string, LatencyStats> handlers;
+    bool enabled = false;
+    ForEachState([&](Eluna* E, const std::string& /*name*/)
+    {
+        enabled = enabled || E->profiler->IsEnabled();
+        E->profiler->Read([&](const HookProfiler::HookMap& stateHooks, const HookProfiler::HandlerMap& stateHandlers)
+        {
+            for (auto itr = stateHooks.begin(); itr != stateHooks.end(); ++itr)
+                hooks[itr->first].Merge(itr->second);
+            for (auto itr = stateHandlers.begin(); itr != stateHandlers.end(); ++itr)
+                handlers[itr->second.location].Merge(itr->second.stats);
+        });
+    });
+
+    if (!enabled)
+        handler.SendSysMessage("Eluna hook profiling is disabled, enable it with .eluna stats on");
+
+    auto report = [&handler](const std::string& name, const LatencyStats& stats)
+    {
+        handler.PSendSysMessage("{}: {} calls, {:.2f} ms total, {:.1f} us avg, {:.1f} us p99, {:.1f} us max",
+            name, stats.count, stats.total / 1000000.0, stats.total / 1000.0 / stats.count,
+            stats.GetPercentile(99) / 1000.0, stats.max / 1000.0);
+    };
+    typedef std::pair<std::string, const LatencyStats*> Entry;
+    auto byTotal = [](const Entry& a, const Entry& b) { return a.second->total > b.second->total; };
+
+    std::vector<Entry> sorted;
+    for (auto itr = hooks.begin(); itr != hooks.end(); ++itr)
+        if (itr->second.count)
+            sorted.push_back(Entry(std::string(itr->first.first) + " event " + std::to_string(itr->first.second), &itr->second));
+    std::sort(sorted.begin(), sorted.end(), byTotal);
+
+    handler.PSendSysMessage("Eluna hooks by total time ({} of {}):", std::min<size_t>(top, sorted.size()), sorted.size());
+    for (size_t i = 0; i < sorted.size() && i < top; ++i)
+        report(sorted[i].first, *sorted[i].second);
+
+    sorted.clear();
+    for (auto itr = handlers.begin(); itr != handlers.end(); ++itr)
+        if (itr->second.count)
+            sorted.push_back(Entry(itr->first, &itr->second));
+    std::sort(sorted.begin(), sorted.end(), byTotal);
+
+    handler.PSendSysMessage("Eluna handlers by total time ({} of {}):", std::min<size_t>(top, sorted.size()), sorted.size());
+    for (size_t i = 0; i < sorted.size() && i < top; ++i)
+        report(sorted[i].first, *sorted[i].second);
+}
+
+/*
+ * Sends the memory use of the Lua state `E` to the command's user.
+ */
+void Eluna::ReportMemory(ChatHandler& handler, Eluna* E, const std::string& name)
+{
+    if (!E || !E->L)
+        return;
+
+    const ElunaAllocator* stateAllocator = E->GetAllocator();
+    if (!stateAllocator)
+    {
+        // A map state can be running on its map thread, the state lock is taken after LOCK_ELUNA as when reloading
+        int used;
+        {
+            LOCK_ELUNA_STATE(E);
+            used = lua_gc(E->L, LUA_GCCOUNT, 0);
+        }
+        handler.PSendSysMessage("{}: {} KB used", name, used);
+        return;
+    }
+
+    std::string limit = stateAllocator->GetLimit() ? std::to_string(stateAllocator->GetLimit() / 1024) + " KB" : "none";
+    handler.PSendSysMessage("{}: {} KB used, {} KB peak, {} KB pooled, limit {}, {} allocations refused",
+        name, stateAllocator->GetUsed() / 1024, stateAllocator->GetPeak() / 1024, stateAllocator->GetPooled() / 1024,
+        limit, stateAllocator->GetFailures());
+}
+
+/*
+ * Does for a map state what `OnWorldUpdate` does for the world state,
+ *   on the map's update thread.
+ */
+void Eluna::OnMapStateUpdate(uint32 diff)
+{
+    eventMgr->globalProcessor->Update(diff);
+    queryProcessor.ProcessReadyCallbacks();
+    RunDeferredHooks();
+    FlushErrorReports();
+    StepGC();
+    UpdateSampling();
+}
+
+Eluna::Eluna(Map* map) :
 event_level(0),
 push_counter(0),
+lastCallStops(false),
 enabled(false),
+errorReportInterval(0),
+errorSuspendThreshold(0),
+gcStepBudget(0),
+gcGrowth(100),
+gcGenerational(false),
+gcCycleActive(false),
+gcNextCycleKB(0),
+gcStats(),
+allocator(NULL),
+samplingSession(0),
+lastSampleHook(0),
+unsampledTime(0),
+stateMap(map),
+self(this),
 
 L(NULL),
 eventMgr(NULL),
+profiler(NULL),
 httpManager(),
 queryProcessor(),
 
@@ -180,17 +505,24 @@ InstanceEventBindings(NULL),
 TicketEventBindings(NULL),
 SpellEventBindings(NULL),
 
-CreatureUniqueBindings(NULL)
+CreatureUniqueBindings(NULL),
+AddonMessageBindings(NULL),
+Commands(NULL),
+CommandBindings(NULL),
+
+ServerEventDeferredBindings(NULL),
+PlayerEventDeferredBindings(NULL),
+GuildEventDeferredBindings(NULL),
+GroupEventDeferredBindings(NULL)
 {
     ASSERT(IsInitialized());
 
-    OpenLua();
+    profiler = new HookProfiler();
 
-    // Replace this with map insert if making multithread version
+    OpenLua();
 
-    // Set event manager. Must be after setting sEluna
-    // on multithread have a map of state pointers and here insert this pointer to the map and then save a pointer of that pointer to the EventMgr
-    eventMgr = new EventMgr(&Eluna::GEluna);
+    // Event processors keep a pointer to the state handle, which stays valid for the lifetime of this state
+    eventMgr = new EventMgr(&self);
 }
 
 Eluna::~Eluna()
@@ -201,6 +533,9 @@ Eluna::~Eluna()
 
     delete eventMgr;
     eventMgr = NULL;
+
+    delete profiler;
+    profiler = NULL;
 }
 
 void Eluna::CloseLua()
@@ -214,13 +549,27 @@ void Eluna::CloseLua()
         lua_close(L);
     L = NULL;
 
+    // After the state, which frees its memory through it
+    delete allocator;
+    allocator = NULL;
+
+    // The profiled functions are gone with the state
+    profiler->Clear();
+
     instanceDataRefs.clear();
     continentDataRefs.clear();
+
+    errorRecords.clear();
+    handlerErrors.clear();
+    suspendedHandlers.clear();
 }
 
 void Eluna::OpenLua()
 {
     enabled = eConfigMgr->GetOption<bool>("Eluna.Enabled", true);
+    errorReportInterval = eConfigMgr->GetOption<uint32>("Eluna.ErrorReportInterval", 10000);
+    errorSuspendThreshold = eConfigMgr->GetOption<uint32>("Eluna.ErrorSuspendThreshold", 1000);
+    profiler->SetEnabled(eConfigMgr->GetOption<bool>("Eluna.HookProfiling", false));
 
     if (!IsEnabled())
     {
@@ -228,7 +577,28 @@ void Eluna::OpenLua()
         return;
     }
 
+#if defined LUAJIT_VERSION
     L = luaL_newstate();
+#else
+    // Pooled allocator of the state, the limit is in MB in the config
+    allocator = new ElunaAllocator(static_cast<size_t>(eConfigMgr->GetOption<uint32>("Eluna.MemoryLimit", 0)) * 1024 * 1024);
+    L = lua_newstate(&ElunaAllocator::Alloc, allocator);
+#endif
+    if (!L)
+    {
+        ELUNA_LOG_ERROR("[Eluna]: Failed to create the Lua state, Eluna.MemoryLimit may be too low");
+        delete allocator;
+        allocator = NULL;
+        enabled = false;
+        return;
+    }
+#if !defined LUAJIT_VERSION
+    // Set by luaL_newstate otherwise
+    lua_atpanic(L, &Eluna::Panic);
+#endif
+    // The new state has no sampling hook yet, `UpdateSampling` installs it
+    samplingSession = 0;
+    ConfigureGC();
 
     lua_pushlightuserdata(L, this);
     lua_setfield(L, LUA_REGISTRYINDEX, ELUNA_STATE_PTR);
@@ -265,27 +635,35 @@ void Eluna::CreateBindStores()
 {
     DestroyBindStores();
 
-    ServerEventBindings      = new BindingMap< EventKey<Hooks::ServerEvents> >(L);
-    PlayerEventBindings      = new BindingMap< EventKey<Hooks::PlayerEvents> >(L);
-    GuildEventBindings       = new BindingMap< EventKey<Hooks::GuildEvents> >(L);
-    GroupEventBindings       = new BindingMap< EventKey<Hooks::GroupEvents> >(L);
-    VehicleEventBindings     = new BindingMap< EventKey<Hooks::VehicleEvents> >(L);
-    BGEventBindings          = new BindingMap< EventKey<Hooks::BGEvents> >(L);
-    TicketEventBindings      = new BindingMap< EventKey<Hooks::TicketEvents> >(L);
-
-    PacketEventBindings      = new BindingMap< EntryKey<Hooks::PacketEvents> >(L);
-    CreatureEventBindings    = new BindingMap< EntryKey<Hooks::CreatureEvents> >(L);
-    CreatureGossipBindings   = new BindingMap< EntryKey<Hooks::GossipEvents> >(L);
-    GameObjectEventBindings  = new BindingMap< EntryKey<Hooks::GameObjectEvents> >(L);
-    GameObjectGossipBindings = new BindingMap< EntryKey<Hooks::GossipEvents> >(L);
-    ItemEventBindings        = new BindingMap< EntryKey<Hooks::ItemEvents> >(L);
-    ItemGossipBindings       = new BindingMap< EntryKey<Hooks::GossipEvents> >(L);
-    PlayerGossipBindings     = new BindingMap< EntryKey<Hooks::GossipEvents> >(L);
-    MapEventBindings         = new BindingMap< EntryKey<Hooks::InstanceEvents> >(L);
-    InstanceEventBindings    = new BindingMap< EntryKey<Hooks::InstanceEvents> >(L);
-    SpellEventBindings       = new BindingMap< EntryKey<Hooks::SpellEvents> >(L);
-
-    CreatureUniqueBindings   = new BindingMap< UniqueObjectKey<Hooks::CreatureEvents> >(L);
+    ServerEventBindings      = new BindingMap< EventKey<Hooks::ServerEvents> >(L, "Server");
+    PlayerEventBindings      = new BindingMap< EventKey<Hooks::PlayerEvents> >(L, "Player");
+    GuildEventBindings       = new BindingMap< EventKey<Hooks::GuildEvents> >(L, "Guild");
+    GroupEventBindings       = new BindingMap< EventKey<Hooks::GroupEvents> >(L, "Group");
+    VehicleEventBindings     = new BindingMap< EventKey<Hooks::VehicleEvents> >(L, "Vehicle");
+    BGEventBindings          = new BindingMap< EventKey<Hooks::BGEvents> >(L, "BG");
+    TicketEventBindings      = new BindingMap< EventKey<Hooks::TicketEvents> >(L, "Ticket");
+
+    PacketEventBindings      = new BindingMap< EntryKey<Hooks::PacketEvents> >(L, "Packet");
+    CreatureEventBindings    = new BindingMap< EntryKey<Hooks::CreatureEvents> >(L, "Creature");
+    CreatureGossipBindings   = new BindingMap< EntryKey<Hooks::GossipEvents> >(L, "CreatureGossip");
+    GameObjectEventBindings  = new BindingMap< EntryKey<Hooks::GameObjectEvents> >(L, "GameObject");
+    GameObjectGossipBindings = new BindingMap< EntryKey<Hooks::GossipEvents> >(L, "GameObjectGossip");
+    ItemEventBindings        = new BindingMap< EntryKey<Hooks::ItemEvents> >(L, "Item");
+    ItemGossipBindings       = new BindingMap< EntryKey<Hooks::GossipEvents> >(L, "ItemGossip");
+    PlayerGossipBindings     = new BindingMap< EntryKey<Hooks::GossipEvents> >(L, "PlayerGossip");
+    MapEventBindings         = new BindingMap< EntryKey<Hooks::InstanceEvents> >(L, "Map");
+    InstanceEventBindings    = new BindingMap< EntryKey<Hooks::InstanceEvents> >(L, "Instance");
+    SpellEventBindings       = new BindingMap< EntryKey<Hooks::SpellEvents> >(L, "Spell");
+
+    CreatureUniqueBindings   = new BindingMap< UniqueObjectKey<Hooks::CreatureEvents> >(L, "UniqueCreature");
+    AddonMessageBindings     = new BindingMap< PrefixKey<Hooks::ServerEvents> >(L, "AddonMessage");
+    Commands                 = new CommandTrie();
+    CommandBindings          = new BindingMap< PrefixKey<Hooks::PlayerEvents> >(L, "Command");
+
+    ServerEventDeferredBindings = new BindingMap< EventKey<Hooks::ServerEvents> >(L, "DeferredServer");
+    PlayerEventDeferredBindings = new BindingMap< EventKey<Hooks::PlayerEvents> >(L, "DeferredPlayer");
+    GuildEventDeferredBindings  = new BindingMap< EventKey<Hooks::GuildEvents> >(L, "DeferredGuild");
+    GroupEventDeferredBindings  = new BindingMap< EventKey<Hooks::GroupEvents> >(L, "DeferredGroup");
 }
 
 void Eluna::DestroyBindStores()
@@ -310,6 +688,14 @@ void Eluna::DestroyBindStores()
     delete SpellEventBindings;
 
     delete CreatureUniqueBindings;
+    delete AddonMessageBindings;
+    delete Commands;
+    delete CommandBindings;
+
+    delete ServerEventDeferredBindings;
+    delete PlayerEventDeferredBindings;
+    delete GuildEventDeferredBindings;
+    delete GroupEventDeferredBindings;
 
     ServerEventBindings = NULL;
     PlayerEventBindings = NULL;
@@ -331,6 +717,14 @@ void Eluna::DestroyBindStores()
     SpellEventBindings = NULL;
 
     CreatureUniqueBindings = NULL;
+    AddonMessageBindings = NULL;
+    Commands = NULL;
+    CommandBindings = NULL;
+
+    ServerEventDeferredBindings = NULL;
+    PlayerEventDeferredBindings = NULL;
+    GuildEventDeferredBindings = NULL;
+    GroupEventDeferredBindings = NULL;
 }
 
 void Eluna::AddScriptPath(std::string filename, const std::string& fullpath)
@@ -354,6 +748,8 @@ void Eluna::AddScriptPath(std::string filename, const std::string& fullpath)
     script.filename = filename;
     script.filepath = fullpath;
     script.modulepath = fullpath.substr(0, fullpath.length() - filename.length() - ext.length());
+    // Extensions and binary modules are libraries, so they are available in every state
+    script.states = (ext == ".lua" || ext == ".moon") ? ReadScriptStates(fullpath) : ELUNA_STATE_ALL;
     if (extension)
         lua_extensions.push_back(script);
     else
@@ -361,6 +757,40 @@ void Eluna::AddScriptPath(std::string filename, const std::string& fullpath)
     ELUNA_LOG_DEBUG("[Eluna]: AddScriptPath add path `{}`", fullpath);
 }
 
+/*
+ * Reads which Lua states a script wants to be loaded into from its first line,
+ *   which can be a comment like `-- eluna-state: map` (or `world` or `all`).
+ *
+ * Scripts without the comment are only loaded into the world state.
+ */
+uint8 Eluna::ReadScriptStates(const std::string& fullpath)
+{
+    std::ifstream file(fullpath);
+    std::string line;
+    if (!file || !std::getline(file, line))
+        return ELUNA_STATE_WORLD;
+
+    std::size_t pos = line.find("eluna-state:");
+    if (line.compare(0, 2, "--") != 0 || pos == std::string::npos)
+        return ELUNA_STATE_WORLD;
+
+    uint8 states = 0;
+    std::string value = line.substr(pos + 12);
+    if (value.find("world") != std::string::npos)
+        states |= ELUNA_STATE_WORLD;
+    if (value.find("map") != std::string::npos)
+        states |= ELUNA_STATE_MAP;
+    if (value.find("all") != std::string::npos)
+        states |= ELUNA_STATE_ALL;
+
+    if (!states)
+    {
+        ELUNA_LOG_ERROR("[Eluna]: Unknown eluna-state `{}` in `{}`, loading it into the world state", value, fullpath);
+        return ELUNA_STATE_WORLD;
+    }
+    return states;
+}
+
 // Finds lua script files from given path (including subdirectories) and pushes them to scripts
 void Eluna::GetScripts(std::string path)
 {
@@ -419,10 +849,12 @@ static bool ScriptPathComparator(const LuaScript& first, const LuaScript& second
 
 void Eluna::RunScripts()
 {
-    LOCK_ELUNA;
+    LOCK_ELUNA_STATE(this);
     if (!IsEnabled())
         return;
 
+    uint8 stateFlag = stateMap ? ELUNA_STATE_MAP : ELUNA_STATE_WORLD;
+
     uint32 oldMSTime = ElunaUtil::GetCurrTime();
     uint32 count = 0;
 
@@ -441,6 +873,9 @@ void Eluna::RunScripts()
     int modules = lua_gettop(L);
     for (ScriptList::const_iterator it = scripts.begin(); it != scripts.end(); ++it)
     {
+        if (!(it->states & stateFlag))
+            continue;
+
         // Check that no duplicate names exist
         if (loaded.find(it->filename) != loaded.end())
         {
@@ -523,6 +958,316 @@ void Eluna::Report(lua_State* _L)
     lua_pop(_L, 1);
 }
 
+Eluna::MemoryLimitScope::MemoryLimitScope(Eluna* E, bool limited) :
+    E(E),
+    previous(E->allocator && E->allocator->SetLimited(limited))
+{
+}
+
+Eluna::MemoryLimitScope::~MemoryLimitScope()
+{
+    // Looked up again, reloading the state replaces the allocator
+    if (E->allocator)
+        E->allocator->SetLimited(previous);
+}
+
+/*
+ * Reports the error of a failed handler call and pops it. `functionIndex` is the stack index
+ *   of the handler function, 0 if it is not known.
+ *
+ * Errors are told apart by their first line, which holds the source location and message.
+ *   An error is logged when it first occurs, later occurrences within `errorReportInterval` ms
+ *   are only counted and summed up by `FlushErrorReports`. Handlers that failed
+ *   `errorSuspendThreshold` times in a row are suspended until Eluna is reloaded.
+ *
+ * Handlers are told apart by the address of their function. A failing function is referenced
+ *   until it returns without an error, so a new function can't inherit its errors by reusing the address.
+ *   Suspended functions stay referenced until the state is closed.
+ */
+void Eluna::ReportCallError(int functionIndex)
+{
+    const void* function = functionIndex ? lua_topointer(L, functionIndex) : NULL;
+
+    // Stack: errmsg
+    const char* msg = lua_tostring(L, -1);
+    std::string error = msg ? msg : "(error object is not a string)";
+    lua_pop(L, 1);
+
+    std::string firstLine = error.substr(0, error.find('\n'));
+    auto result = errorRecords.emplace(std::hash<std::string>()(firstLine), ErrorRecord());
+    ErrorRecord& record = result.first->second;
+    if (result.second || ElunaUtil::GetTimeDiff(record.lastReport) >= errorReportInterval)
+    {
+        if (record.repeats)
+            ELUNA_LOG_ERROR("[Eluna]: Error repeated {} times in the last {} ms: {}", record.repeats, ElunaUtil::GetTimeDiff(record.lastReport), record.error);
+
+        ELUNA_LOG_ERROR("{}", error);
+        record.error = firstLine;
+        record.lastReport = ElunaUtil::GetCurrTime();
+        record.repeats = 0;
+    }
+    else
+        ++record.repeats;
+
+    if (errorSuspendThreshold && function && !IsSuspended(function))
+    {
+        auto itr = handlerErrors.find(function);
+        if (itr == handlerErrors.end())
+        {
+            lua_pushvalue(L, functionIndex);
+            HandlerErrors errors = { 0, luaL_ref(L, LUA_REGISTRYINDEX) };
+            itr = handlerErrors.emplace(function, errors).first;
+        }
+
+        if (++itr->second.count == errorSuspendThreshold)
+        {
+            suspendedHandlers.insert(function);
+            ELUNA_LOG_ERROR("[Eluna]: Handler suspended after {} consecutive errors until Eluna is reloaded, last error: {}", errorSuspendThreshold, firstLine);
+        }
+    }
+
+    // A bounded incremental step instead of a full collection, errors can come in storms
+    lua_gc(L, LUA_GCSTEP, 0);
+}
+
+/*
+ * Forgets the errors of `function`, which returned without one. Suspended functions stay suspended.
+ */
+void Eluna::ClearCallErrors(const void* function)
+{
+    auto itr = handlerErrors.find(function);
+    if (itr == handlerErrors.end() || IsSuspended(function))
+        return;
+
+    luaL_unref(L, LUA_REGISTRYINDEX, itr->second.functionRef);
+    handlerErrors.erase(itr);
+}
+
+/*
+ * Logs how often the errors reported by `ReportCallError` repeated since they were last logged,
+ *   once `errorReportInterval` ms have passed.
+ */
+void Eluna::FlushErrorReports()
+{
+    LOCK_ELUNA_STATE(this);
+
+    for (auto itr = errorRecords.begin(); itr != errorRecords.end();)
+    {
+        uint32 elapsed = ElunaUtil::GetTimeDiff(itr->second.lastReport);
+        if (elapsed < errorReportInterval)
+        {
+            ++itr;
+            continue;
+        }
+
+        if (itr->second.repeats)
+            ELUNA_LOG_ERROR("[Eluna]: Error repeated {} times in the last {} ms: {}", itr->second.repeats, elapsed, itr->second.error);
+        itr = errorRecords.erase(itr);
+    }
+}
+
+/*
+ * Applies the garbage collector options of the config to the new state.
+ *
+ * Pause and step multiplier of 0 keep the defaults of the Lua version.
+ *   Generational mode is only available in Lua 5.4.
+ */
+void Eluna::ConfigureGC()
+{
+    gcStepBudget = eConfigMgr->GetOption<uint32>("Eluna.GCStepBudget", 0);
+    uint32 pause = eConfigMgr->GetOption<uint32>("Eluna.GCPause", 0);
+    uint32 stepMultiplier = eConfigMgr->GetOption<uint32>("Eluna.GCStepMultiplier", 0);
+    bool generational = eConfigMgr->GetOption<bool>("Eluna.GCGenerational", false);
+
+    gcGenerational = false;
+    gcCycleActive = false;
+    gcNextCycleKB = 0;
+    gcStats = ElunaGCStats();
+
+#if LUA_VERSION_NUM >= 504
+    if (generational)
+    {
+        lua_gc(L, LUA_GCGEN, 0, 0);
+        gcGenerational = true;
+        // Lua runs a minor collection when the heap grew by 20% since the last one
+        gcGrowth = 20;
+        return;
+    }
+    lua_gc(L, LUA_GCINC, static_cast<int>(pause), static_cast<int>(stepMultiplier), 0);
+#else
+    if (generational)
+        ELUNA_LOG_ERROR("[Eluna]: Eluna.GCGenerational needs Lua 5.4, using incremental collection");
+    if (pause)
+        lua_gc(L, LUA_GCSETPAUSE, static_cast<int>(pause));
+    if (stepMultiplier)
+        lua_gc(L, LUA_GCSETSTEPMUL, static_cast<int>(stepMultiplier));
+#endif
+
+    gcGrowth = pause > 100 ? pause - 100 : (pause ? 0 : 100);
+}
+
+/*
+ * Advances the garbage collector within `gcStepBudget` microseconds, called once per update.
+ *
+ * A cycle is started when the heap is halfway to the size at which Lua would start it by itself,
+ *   and stepped until it finishes or the budget is spent. That way collection happens between
+ *   hooks instead of in the allocations of the handlers, while the automatic collector is left on
+ *   in case the budget can't keep up. In generational mode every step is a whole minor collection,
+ *   so at most one is run per update.
+ */
+void Eluna::StepGC()
+{
+    if (!gcStepBudget)
+        return;
+
+    LOCK_ELUNA_STATE(this);
+
+    if (!L)
+        return;
+
+    gcStats.lastTime = 0;
+    if (!gcCycleActive)
+    {
+        if (lua_gc(L, LUA_GCCOUNT, 0) < gcNextCycleKB)
+            return;
+        gcCycleActive = true;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    uint64 elapsed = 0;
+    do
+    {
+        ++gcStats.steps;
+        bool finished = lua_gc(L, LUA_GCSTEP, 0) != 0 || gcGenerational;
+        elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+        if (finished)
+        {
+            int liveKB = lua_gc(L, LUA_GCCOUNT, 0);
+            gcNextCycleKB = liveKB + static_cast<int>(static_cast<uint64>(liveKB) * gcGrowth / 200);
+            gcCycleActive = false;
+            ++gcStats.cycles;
+            break;
+        }
+    } while (elapsed < gcStepBudget);
+
+    gcStats.lastTime = static_cast<uint32>(elapsed);
+    gcStats.totalTime += elapsed;
+}
+
+/*
+ * Installs or removes the sampling hook of the state when a sampler session starts or ends, called once per update.
+ *
+ * Each state changes its own hook on its own thread. The hook is set on the main thread of the state,
+ *   coroutines created while it is installed inherit it.
+ */
+void Eluna::UpdateSampling()
+{
+    uint32 session = sampler.GetSession();
+    if (session == samplingSession)
+        return;
+
+    LOCK_ELUNA_STATE(this);
+
+    samplingSession = session;
+    if (!L)
+        return;
+
+    if (session)
+        lua_sethook(L, &SampleHook, LUA_MASKCOUNT, static_cast<int>(sampler.GetHookCount()));
+    else
+        lua_sethook(L, NULL, 0, 0);
+}
+
+/*
+ * The count hook of sampled states and their coroutines. In time based sessions most calls only check the clock.
+ *
+ * Time based sessions sample by the time spent running Lua code, not by wall-clock time,
+ *   or a short handler called after a pause would be sampled as if it ran for all of it.
+ *   Only the time since Lua was entered, see `MarkLuaEntry`, or since the previous hook call is
+ *   counted, at most `SamplingProfiler::MAX_HOOK_GAP` per call for the state leaving Lua in between.
+ */
+void Eluna::SampleHook(lua_State* L, lua_Debug* /*ar*/)
+{
+    Eluna* E = GetEluna(L);
+
+    // `UpdateSampling` only sets the hook of the main thread, coroutines created during a session inherit it.
+    //   A hook that is not for the running session removes itself from its thread, the main thread gets
+    //   it back from `UpdateSampling` if a new session has started.
+    uint32 session = sampler.GetSession();
+    if (!session || session != E->samplingSession)
+    {
+        lua_sethook(L, NULL, 0, 0);
+        return;
+    }
+
+    uint32 samples = 1;
+    if (uint32 interval = sampler.GetInterval())
+    {
+        uint64 now = HookProfiler::Now() / 1000;
+        E->unsampledTime += std::min<uint64>(now - E->lastSampleHook, SamplingProfiler::MAX_HOOK_GAP);
+        E->lastSampleHook = now;
+        if (E->unsampledTime < interval)
+            return;
+
+        // Intervals shorter than the gap between hook calls are made up for by weighing the sample
+        samples = static_cast<uint32>(E->unsampledTime / interval);
+        E->unsampledTime %= interval;
+    }
+
+    sampler.Sample(L, E->GetStateName(), samples);
+}
+
+/*
+ * Starts the clock of time based sampling when Lua is entered, the time outside of Lua is not sampled.
+ */
+void Eluna::MarkLuaEntry()
+{
+    if (samplingSession && sampler.GetInterval())
+        lastSampleHook = HookProfiler::Now() / 1000;
+}
+
+/*
+ * Ends the sampler session and writes its folded stacks to a new file in `Eluna.ProfilePath`.
+ *
+ * `handler` is told the result, it is NULL when the session ended by itself.
+ */
+void Eluna::StopSampling(ChatHandler* handler)
+{
+    if (!sampler.Stop())
+    {
+        if (handler)
+            handler->SendSysMessage("No Eluna profile is running");
+        return;
+    }
+
+    std::string path = eConfigMgr->GetOption<std::string>("Eluna.ProfilePath", "");
+    if (!path.empty() && path.back() != '/' && path.back() != '\\')
+        path += '/';
+    path += "eluna-profile-" + std::to_string(time(NULL)) + ".folded";
+
+    uint64 samples = sampler.GetSampleCount();
+    if (!sampler.WriteFolded(path))
+    {
+        ELUNA_LOG_ERROR("[Eluna]: Could not write the profile to `{}`", path);
+        if (handler)
+            handler->PSendSysMessage("Could not write the Eluna profile to {}", path);
+        return;
+    }
+
+    ELUNA_LOG_INFO("[Eluna]: Wrote {} profile samples to `{}`", samples, path);
+    if (handler)
+        handler->PSendSysMessage("Wrote {} Eluna profile samples to {}", samples, path);
+}
+
+// Logs errors raised outside of protected calls, before Lua aborts.
+//   The memory limit is lifted outside of them, so this is not reached by scripts using too much memory.
+int Eluna::Panic(lua_State* _L)
+{
+    const char* msg = lua_tostring(_L, -1);
+    ELUNA_LOG_ERROR("[Eluna]: Unprotected error in call to Lua API: {}", msg ? msg : "error object is not a string");
+    return 0;
+}
+
 // Borrowed from http://stackoverflow.com/questions/12256455/print-stacktrace-from-c-code-with-embedded-lua
 int Eluna::StackTrace(lua_State *_L)
 {
@@ -550,7 +1295,7 @@ int Eluna::StackTrace(lua_State *_L)
 
     // dirty stack?
     // Stack: errmsg, debug, tracemsg
-    sEluna->OnError(std::string(lua_tostring(_L, -1)));
+    GetEluna(_L)->OnError(std::string(lua_tostring(_L, -1)));
     return 1;
 }
 
@@ -569,6 +1314,27 @@ bool Eluna::ExecuteCall(int params, int res)
         ASSERT(false); // stack probably corrupt
     }
 
+    // Suspended handlers are dropped with their parameters
+    const void* function = lua_topointer(L, base);
+    if (IsSuspended(function))
+    {
+        lua_pop(L, params + 1);
+        for (int i = 0; i < res; ++i)
+            lua_pushnil(L);
+        return false;
+    }
+
+    HookProfiler::HandlerStats* handlerStats = profiler->IsEnabled() ? profiler->GetHandler(L, base) : NULL;
+
+    // A copy of the function stays below the call, for `ReportCallError` to keep track of it
+    bool keepFunction = errorSuspendThreshold != 0;
+    if (keepFunction)
+    {
+        lua_pushvalue(L, base);
+        lua_insert(L, base);
+        ++base;
+    }
+
     bool usetrace = eConfigMgr->GetOption<bool>("Eluna.TraceBack", false);
     if (usetrace)
     {
@@ -578,27 +1344,34 @@ bool Eluna::ExecuteCall(int params, int res)
         // Stack: traceback, function, [parameters]
     }
 
+    uint64 start = handlerStats ? HookProfiler::Now() : 0;
+    MarkLuaEntry();
     // Objects are invalidated when event_level hits 0
     ++event_level;
-    int result = lua_pcall(L, params, res, usetrace ? base : 0);
+    int result;
+    {
+        MemoryLimitScope limit(this, true);
+        result = lua_pcall(L, params, res, usetrace ? base : 0);
+    }
     --event_level;
+    if (handlerStats)
+        profiler->RecordHandler(handlerStats, HookProfiler::Now() - start);
 
     if (usetrace)
     {
         // Stack: traceback, [results or errmsg]
         lua_remove(L, base);
     }
-    // Stack: [results or errmsg]
+    // Stack: [function], [results or errmsg]
 
     // lua_pcall returns 0 on success.
     // On error print the error and push nils for expected amount of returned values
     if (result)
     {
-        // Stack: errmsg
-        Report(L);
-
-        // Force garbage collect
-        lua_gc(L, LUA_GCCOLLECT, 0);
+        // Stack: [function], errmsg
+        ReportCallError(keepFunction ? base - 1 : 0);
+        if (keepFunction)
+            lua_remove(L, base - 1);
 
         // Push nils for expected amount of results
         for (int i = 0; i < res; ++i)
@@ -607,6 +1380,12 @@ bool Eluna::ExecuteCall(int params, int res)
         return false;
     }
 
+    if (keepFunction)
+    {
+        ResetCallErrors(function);
+        lua_remove(L, base - 1);
+    }
+
     // Stack: [results]
     return true;
 }
@@ -617,10 +1396,25 @@ void Eluna::Push(lua_State* luastate)
 }
 void Eluna::Push(lua_State* luastate, const long long l)
 {
+#if LUA_VERSION_NUM >= 503
+    if (nativeIntegers)
+    {
+        lua_pushinteger(luastate, static_cast<lua_Integer>(l));
+        return;
+    }
+#endif
     ElunaTemplate<long long>::Push(luastate, new long long(l));
 }
 void Eluna::Push(lua_State* luastate, const unsigned long long l)
 {
+#if LUA_VERSION_NUM >= 503
+    // Values above the signed range wrap to negative integers and are read back unchanged by CHECKVAL
+    if (nativeIntegers)
+    {
+        lua_pushinteger(luastate, static_cast<lua_Integer>(l));
+        return;
+    }
+#endif
     ElunaTemplate<unsigned long long>::Push(luastate, new unsigned long long(l));
 }
 void Eluna::Push(lua_State* luastate, const long l)
@@ -738,7 +1532,7 @@ void Eluna::Push(lua_State* luastate, Object const* obj)
 }
 void Eluna::Push(lua_State* luastate, ObjectGuid const guid)
 {
-    ElunaTemplate<unsigned long long>::Push(luastate, new unsigned long long(guid.GetRawValue()));
+    Push(luastate, static_cast<unsigned long long>(guid.GetRawValue()));
 }
 
 void Eluna::Push(lua_State* luastate, GemPropertiesEntry const& gemProperties)
@@ -876,12 +1670,20 @@ template<> std::string Eluna::CHECKVAL<std::string>(lua_State* luastate, int nar
 }
 template<> long long Eluna::CHECKVAL<long long>(lua_State* luastate, int narg)
 {
+#if LUA_VERSION_NUM >= 503
+    if (nativeIntegers && lua_isinteger(luastate, narg))
+        return static_cast<long long>(lua_tointeger(luastate, narg));
+#endif
     if (lua_isnumber(luastate, narg))
         return static_cast<long long>(CHECKVAL<double>(luastate, narg));
     return *(Eluna::CHECKOBJ<long long>(luastate, narg, true));
 }
 template<> unsigned long long Eluna::CHECKVAL<unsigned long long>(lua_State* luastate, int narg)
 {
+#if LUA_VERSION_NUM >= 503
+    if (nativeIntegers && lua_isinteger(luastate, narg))
+        return static_cast<unsigned long long>(lua_tointeger(luastate, narg));
+#endif
     if (lua_isnumber(luastate, narg))
         return static_cast<unsigned long long>(CHECKVAL<uint32>(luastate, narg));
     return *(Eluna::CHECKOBJ<unsigned long long>(luastate, narg, true));
@@ -899,42 +1701,12 @@ template<> ObjectGuid Eluna::CHECKVAL<ObjectGuid>(lua_State* luastate, int narg)
     return ObjectGuid(uint64((CHECKVAL<unsigned long long>(luastate, narg))));
 }
 
-template<> Object* Eluna::CHECKOBJ<Object>(lua_State* luastate, int narg, bool error)
-{
-    Object* obj = CHECKOBJ<WorldObject>(luastate, narg, false);
-    if (!obj)
-        obj = CHECKOBJ<Item>(luastate, narg, false);
-    if (!obj)
-        obj = ElunaTemplate<Object>::Check(luastate, narg, error);
-    return obj;
-}
-template<> WorldObject* Eluna::CHECKOBJ<WorldObject>(lua_State* luastate, int narg, bool error)
-{
-    WorldObject* obj = CHECKOBJ<Unit>(luastate, narg, false);
-    if (!obj)
-        obj = CHECKOBJ<GameObject>(luastate, narg, false);
-    if (!obj)
-        obj = CHECKOBJ<Corpse>(luastate, narg, false);
-    if (!obj)
-        obj = ElunaTemplate<WorldObject>::Check(luastate, narg, error);
-    return obj;
-}
-template<> Unit* Eluna::CHECKOBJ<Unit>(lua_State* luastate, int narg, bool error)
-{
-    Unit* obj = CHECKOBJ<Player>(luastate, narg, false);
-    if (!obj)
-        obj = CHECKOBJ<Creature>(luastate, narg, false);
-    if (!obj)
-        obj = ElunaTemplate<Unit>::Check(luastate, narg, error);
-    return obj;
-}
-
 template<> ElunaObject* Eluna::CHECKOBJ<ElunaObject>(lua_State* luastate, int narg, bool error)
 {
-    return CHECKTYPE(luastate, narg, NULL, error);
+    return CHECKTYPE(luastate, narg, NULL, 0, error);
 }
 
-ElunaObject* Eluna::CHECKTYPE(lua_State* luastate, int narg, const char* tname, bool error)
+ElunaObject* Eluna::CHECKTYPE(lua_State* luastate, int narg, const char* tname, uint32 typeId, bool error)
 {
     if (lua_islightuserdata(luastate, narg))
     {
@@ -943,19 +1715,19 @@ ElunaObject* Eluna::CHECKTYPE(lua_State* luastate, int narg, const char* tname,
         return NULL;
     }
 
-    ElunaObject** ptrHold = static_cast<ElunaObject**>(lua_touserdata(luastate, narg));
+    ElunaObject* elunaObj = static_cast<ElunaObject*>(lua_touserdata(luastate, narg));
 
-    if (!ptrHold || (tname && (*ptrHold)->GetTypeName() != tname))
+    if (!elunaObj || (tname && !elunaObj->IsA(typeId)))
     {
         if (error)
         {
             char buff[256];
-            snprintf(buff, 256, "bad argument : %s expected, got %s", tname ? tname : "ElunaObject", ptrHold ? (*ptrHold)->GetTypeName() : luaL_typename(luastate, narg));
+            snprintf(buff, 256, "bad argument : %s expected, got %s", tname ? tname : "ElunaObject", elunaObj ? elunaObj->GetTypeName() : luaL_typename(luastate, narg));
             luaL_argerror(luastate, narg, buff);
         }
         return NULL;
     }
-    return *ptrHold;
+    return elunaObj;
 }
 
 template<typename K>
@@ -982,19 +1754,194 @@ static void createCancelCallback(lua_State* L, uint64 bindingID, BindingMap<K>*
     // Stack: cancel_callback
 }
 
+/*
+ * Returns `true` if handlers of the event can be registered as deferred.
+ *
+ * Only hooks that don't use the handlers' return values and call `DEFER_HOOK` can be deferred.
+ */
+bool Eluna::IsDeferrable(uint8 regtype, uint32 event_id)
+{
+    switch (regtype)
+    {
+        case Hooks::REGTYPE_SERVER:
+            switch (event_id)
+            {
+                case Hooks::MAP_EVENT_ON_PLAYER_ENTER:
+                case Hooks::MAP_EVENT_ON_PLAYER_LEAVE:
+                    return true;
+            }
+            return false;
+
+        case Hooks::REGTYPE_PLAYER:
+            switch (event_id)
+            {
+                case Hooks::PLAYER_EVENT_ON_LOGIN:
+                case Hooks::PLAYER_EVENT_ON_LOGOUT:
+                case Hooks::PLAYER_EVENT_ON_FIRST_LOGIN:
+                case Hooks::PLAYER_EVENT_ON_LEVEL_CHANGE:
+                case Hooks::PLAYER_EVENT_ON_LOOT_ITEM:
+                case Hooks::PLAYER_EVENT_ON_LOOT_MONEY:
+                case Hooks::PLAYER_EVENT_ON_LEARN_SPELL:
+                case Hooks::PLAYER_EVENT_ON_ACHIEVEMENT_COMPLETE:
+                    return true;
+            }
+            return false;
+
+        case Hooks::REGTYPE_GUILD:
+            switch (event_id)
+            {
+                case Hooks::GUILD_EVENT_ON_ADD_MEMBER:
+                case Hooks::GUILD_EVENT_ON_REMOVE_MEMBER:
+                case Hooks::GUILD_EVENT_ON_MOTD_CHANGE:
+                case Hooks::GUILD_EVENT_ON_INFO_CHANGE:
+                case Hooks::GUILD_EVENT_ON_CREATE:
+                case Hooks::GUILD_EVENT_ON_DISBAND:
+                case Hooks::GUILD_EVENT_ON_EVENT:
+                case Hooks::GUILD_EVENT_ON_BANK_EVENT:
+                    return true;
+            }
+            return false;
+
+        case Hooks::REGTYPE_GROUP:
+            return event_id < Hooks::GROUP_EVENT_COUNT;
+    }
+    return false;
+}
+
+/*
+ * Returns the bit mask of `BindingFilterKind`s that handlers of the event can be filtered by.
+ *
+ * Only hooks that pass a `BindingFilterArgs` with these kinds to their bindings can be filtered.
+ */
+uint8 Eluna::GetFilterKinds(uint8 regtype, uint32 event_id)
+{
+    const uint8 entry = 1 << BINDING_FILTER_ENTRY;
+    const uint8 spell = 1 << BINDING_FILTER_SPELL;
+    const uint8 zone = 1 << BINDING_FILTER_ZONE;
+    const uint8 map = 1 << BINDING_FILTER_MAP;
+    const uint8 opcode = 1 << BINDING_FILTER_OPCODE;
+
+    switch (regtype)
+    {
+        case Hooks::REGTYPE_SERVER:
+            switch (event_id)
+            {
+                case Hooks::SERVER_EVENT_ON_PACKET_RECEIVE:
+                case Hooks::SERVER_EVENT_ON_PACKET_SEND:
+                    return opcode;
+                case Hooks::MAP_EVENT_ON_PLAYER_ENTER:
+                case Hooks::MAP_EVENT_ON_PLAYER_LEAVE:
+                    return map;
+                case Hooks::TRIGGER_EVENT_ON_TRIGGER:
+                case Hooks::WORLD_EVENT_ON_DELETE_CREATURE:
+                case Hooks::WORLD_EVENT_ON_DELETE_GAMEOBJECT:
+                    return entry | map;
+            }
+            return 0;
+
+        case Hooks::REGTYPE_PLAYER:
+            switch (event_id)
+            {
+                case Hooks::PLAYER_EVENT_ON_SPELL_CAST:
+                    return spell | zone | map;
+                case Hooks::PLAYER_EVENT_ON_LEARN_SPELL:
+                    return spell;
+                case Hooks::PLAYER_EVENT_ON_LOOT_ITEM:
+                case Hooks::PLAYER_EVENT_ON_EQUIP:
+                case Hooks::PLAYER_EVENT_ON_KILL_CREATURE:
+                case Hooks::PLAYER_EVENT_ON_KILLED_BY_CREATURE:
+                case Hooks::PLAYER_EVENT_ON_PET_KILL:
+                    return entry | zone | map;
+                case Hooks::PLAYER_EVENT_ON_CAN_USE_ITEM:
+                    return entry;
+                case Hooks::PLAYER_EVENT_ON_UPDATE_ZONE:
+                case Hooks::PLAYER_EVENT_ON_MAP_CHANGE:
+                    return zone | map;
+            }
+            return 0;
+    }
+    return 0;
+}
+
 // Saves the function reference ID given to the register type's store for given entry under the given event
-int Eluna::Register(lua_State* L, uint8 regtype, uint32 entry, ObjectGuid guid, uint32 instanceId, uint32 event_id, int functionRef, uint32 shots)
+/*
+ * Registers a handler for addon messages with the given prefix.
+ *
+ * The handlers are kept apart from the ADDON_EVENT_ON_MESSAGE server event bindings,
+ *   so a message only calls the handlers of its own prefix.
+ */
+int Eluna::RegisterAddonMessage(lua_State* L, const char* prefix, size_t length, int functionRef, uint32 shots, int32 priority, bool stopOnResult)
+{
+    auto key = PrefixKey<Hooks::ServerEvents>(Hooks::ADDON_EVENT_ON_MESSAGE, prefix, length);
+    uint64 bindingID = AddonMessageBindings->Insert(key, functionRef, shots, priority, stopOnResult);
+    createCancelCallback(L, bindingID, AddonMessageBindings);
+    return 1; // Stack: callback
+}
+
+/*
+ * Registers a handler for the chat command `path`, a list of command tokens separated by spaces.
+ *
+ * The command is added to `Commands`, which `OnCommand` matches the command text against
+ *   before any PLAYER_EVENT_ON_COMMAND handlers are called. The security level is kept per handler,
+ *   as a filter of the binding, so handlers of the same command can need different levels.
+ */
+int Eluna::RegisterCommand(lua_State* L, const char* path, int functionRef, uint32 minSecurity)
+{
+    CommandTrie::Key key = CommandTrie::GetKey(path);
+    if (key.prefix.empty())
+    {
+        luaL_unref(L, LUA_REGISTRYINDEX, functionRef);
+        luaL_argerror(L, 1, "command path is empty");
+        return 0; // Stack: (empty)
+    }
+
+    std::shared_ptr<BindingFilter> filter;
+    if (minSecurity)
+    {
+        filter = std::make_shared<BindingFilter>();
+        for (uint32 security = std::min<uint32>(minSecurity, SEC_CONSOLE); security <= SEC_CONSOLE; ++security)
+            filter->Add(BINDING_FILTER_SECURITY, security);
+    }
+
+    Commands->Insert(path);
+    uint64 bindingID = CommandBindings->Insert(key, functionRef, 0, 0, false, filter);
+    createCancelCallback(L, bindingID, CommandBindings);
+    return 1; // Stack: callback
+}
+
+int Eluna::Register(lua_State* L, uint8 regtype, uint32 entry, ObjectGuid guid, uint32 instanceId, uint32 event_id, int functionRef, uint32 shots, bool deferred, int32 priority, bool stopOnResult, const BindingFilter* filter)
 {
     uint64 bindingID;
 
+    if (deferred && !IsDeferrable(regtype, event_id))
+    {
+        luaL_unref(L, LUA_REGISTRYINDEX, functionRef);
+        luaL_error(L, "Event %d of regtype %d can't be deferred", event_id, regtype);
+        return 0; // Stack: (empty)
+    }
+
+    std::shared_ptr<const BindingFilter> bindingFilter;
+    if (filter && filter->kinds)
+    {
+        // Deferred hooks are queued before their handlers are looked up, so they can't be filtered
+        if (deferred || (filter->kinds & ~GetFilterKinds(regtype, event_id)))
+        {
+            luaL_unref(L, LUA_REGISTRYINDEX, functionRef);
+            luaL_error(L, "Event %d of regtype %d can't be filtered by the given arguments", event_id, regtype);
+            return 0; // Stack: (empty)
+        }
+        bindingFilter = std::make_shared<BindingFilter>(*filter);
+    }
+
     switch (regtype)
     {
         case Hooks::REGTYPE_SERVER:
             if (event_id < Hooks::SERVER_EVENT_COUNT)
             {
                 auto key = EventKey<Hooks::ServerEvents>((Hooks::ServerEvents)event_id);
-                bindingID = ServerEventBindings->Insert(key, functionRef, shots);
-                createCancelCallback(L, bindingID, ServerEventBindings);
+                BindingMap< EventKey<Hooks::ServerEvents> >* bindings = deferred ? ServerEventDeferredBindings : ServerEventBindings;
+                bindingID = bindings->Insert(key, functionRef, shots, priority, stopOnResult, bindingFilter);
+                createCancelCallback(L, bindingID, bindings);
                 return 1; // Stack: callback
             }
             break;
@@ -1003,8 +1950,9 @@ int Eluna::Register(lua_State* L, uint8 regtype, uint32 entry, ObjectGuid guid,
             if (event_id < Hooks::PLAYER_EVENT_COUNT)
             {
                 auto key = EventKey<Hooks::PlayerEvents>((Hooks::PlayerEvents)event_id);
-                bindingID = PlayerEventBindings->Insert(key, functionRef, shots);
-                createCancelCallback(L, bindingID, PlayerEventBindings);
+                BindingMap< EventKey<Hooks::PlayerEvents> >* bindings = deferred ? PlayerEventDeferredBindings : PlayerEventBindings;
+                bindingID = bindings->Insert(key, functionRef, shots, priority, stopOnResult, bindingFilter);
+                createCancelCallback(L, bindingID, bindings);
                 return 1; // Stack: callback
             }
             break;
@@ -1013,8 +1961,9 @@ int Eluna::Register(lua_State* L, uint8 regtype, uint32 entry, ObjectGuid guid,
             if (event_id < Hooks::GUILD_EVENT_COUNT)
             {
                 auto key = EventKey<Hooks::GuildEvents>((Hooks::GuildEvents)event_id);
-                bindingID = GuildEventBindings->Insert(key, functionRef, shots);
-                createCancelCallback(L, bindingID, GuildEventBindings);
+                BindingMap< EventKey<Hooks::GuildEvents> >* bindings = deferred ? GuildEventDeferredBindings : GuildEventBindings;
+                bindingID = bindings->Insert(key, functionRef, shots, priority, stopOnResult, bindingFilter);
+                createCancelCallback(L, bindingID, bindings);
                 return 1; // Stack: callback
             }
             break;
@@ -1023,8 +1972,9 @@ int Eluna::Register(lua_State* L, uint8 regtype, uint32 entry, ObjectGuid guid,
             if (event_id < Hooks::GROUP_EVENT_COUNT)
             {
                 auto key = EventKey<Hooks::GroupEvents>((Hooks::GroupEvents)event_id);
-                bindingID = GroupEventBindings->Insert(key, functionRef, shots);
-                createCancelCallback(L, bindingID, GroupEventBindings);
+                BindingMap< EventKey<Hooks::GroupEvents> >* bindings = deferred ? GroupEventDeferredBindings : GroupEventBindings;
+                bindingID = bindings->Insert(key, functionRef, shots, priority, stopOnResult, bindingFilter);
+                createCancelCallback(L, bindingID, bindings);
                 return 1; // Stack: callback
             }
             break;
@@ -1033,7 +1983,7 @@ int Eluna::Register(lua_State* L, uint8 regtype, uint32 entry, ObjectGuid guid,
             if (event_id < Hooks::VEHICLE_EVENT_COUNT)
             {
                 auto key = EventKey<Hooks::VehicleEvents>((Hooks::VehicleEvents)event_id);
-                bindingID = VehicleEventBindings->Insert(key, functionRef, shots);
+                bindingID = VehicleEventBindings->Insert(key, functionRef, shots, priority, stopOnResult, bindingFilter);
                 createCancelCallback(L, bindingID, VehicleEventBindings);
                 return 1; // Stack: callback
             }
@@ -1043,7 +1993,7 @@ int Eluna::Register(lua_State* L, uint8 regtype, uint32 entry, ObjectGuid guid,
             if (event_id < Hooks::BG_EVENT_COUNT)
             {
                 auto key = EventKey<Hooks::BGEvents>((Hooks::BGEvents)event_id);
-                bindingID = BGEventBindings->Insert(key, functionRef, shots);
+                bindingID = BGEventBindings->Insert(key, functionRef, shots, priority, stopOnResult, bindingFilter);
                 createCancelCallback(L, bindingID, BGEventBindings);
                 return 1; // Stack: callback
             }
@@ -1060,7 +2010,7 @@ int Eluna::Register(lua_State* L, uint8 regtype, uint32 entry, ObjectGuid guid,
                 }
 
                 auto key = EntryKey<Hooks::PacketEvents>((Hooks::PacketEvents)event_id, entry);
-                bindingID = PacketEventBindings->Insert(key, functionRef, shots);
+                bindingID = PacketEventBindings->Insert(key, functionRef, shots, priority, stopOnResult, bindingFilter);
                 createCancelCallback(L, bindingID, PacketEventBindings);
                 return 1; // Stack: callback
             }
@@ -1079,7 +2029,7 @@ int Eluna::Register(lua_State* L, uint8 regtype, uint32 entry, ObjectGuid guid,
                     }
 
                     auto key = EntryKey<Hooks::CreatureEvents>((Hooks::CreatureEvents)event_id, entry);
-                    bindingID = CreatureEventBindings->Insert(key, functionRef, shots);
+                    bindingID = CreatureEventBindings->Insert(key, functionRef, shots, priority, stopOnResult, bindingFilter);
                     createCancelCallback(L, bindingID, CreatureEventBindings);
                 }
                 else
@@ -1092,7 +2042,7 @@ int Eluna::Register(lua_State* L, uint8 regtype, uint32 entry, ObjectGuid guid,
                     }
 
                     auto key = UniqueObjectKey<Hooks::CreatureEvents>((Hooks::CreatureEvents)event_id, guid, instanceId);
-                    bindingID = CreatureUniqueBindings->Insert(key, functionRef, shots);
+                    bindingID = CreatureUniqueBindings->Insert(key, functionRef, shots, priority, stopOnResult, bindingFilter);
                     createCancelCallback(L, bindingID, CreatureUniqueBindings);
                 }
                 return 1; // Stack: callback
@@ -1110,7 +2060,7 @@ int Eluna::Register(lua_State* L, uint8 regtype, uint32 entry, ObjectGuid guid,
                 }
 
                 auto key = EntryKey<Hooks::GossipEvents>((Hooks::GossipEvents)event_id, entry);
-                bindingID = CreatureGossipBindings->Insert(key, functionRef, shots);
+                bindingID = CreatureGossipBindings->Insert(key, functionRef, shots, priority, stopOnResult, bindingFilter);
                 createCancelCallback(L, bindingID, CreatureGossipBindings);
                 return 1; // Stack: callback
             }
@@ -1127,7 +2077,7 @@ int Eluna::Register(lua_State* L, uint8 regtype, uint32 entry, ObjectGuid guid,
                 }
 
                 auto key = EntryKey<Hooks::GameObjectEvents>((Hooks::GameObjectEvents)event_id, entry);
-                bindingID = GameObjectEventBindings->Insert(key, functionRef, shots);
+                bindingID = GameObjectEventBindings->Insert(key, functionRef, shots, priority, stopOnResult, bindingFilter);
                 createCancelCallback(L, bindingID, GameObjectEventBindings);
                 return 1; // Stack: callback
             }
@@ -1144,7 +2094,7 @@ int Eluna::Register(lua_State* L, uint8 regtype, uint32 entry, ObjectGuid guid,
                 }
 
                 auto key = EntryKey<Hooks::GossipEvents>((Hooks::GossipEvents)event_id, entry);
-                bindingID = GameObjectGossipBindings->Insert(key, functionRef, shots);
+                bindingID = GameObjectGossipBindings->Insert(key, functionRef, shots, priority, stopOnResult, bindingFilter);
                 createCancelCallback(L, bindingID, GameObjectGossipBindings);
                 return 1; // Stack: callback
             }
@@ -1161,7 +2111,7 @@ int Eluna::Register(lua_State* L, uint8 regtype, uint32 entry, ObjectGuid guid,
                 }
 
                 auto key = EntryKey<Hooks::ItemEvents>((Hooks::ItemEvents)event_id, entry);
-                bindingID = ItemEventBindings->Insert(key, functionRef, shots);
+                bindingID = ItemEventBindings->Insert(key, functionRef, shots, priority, stopOnResult, bindingFilter);
                 createCancelCallback(L, bindingID, ItemEventBindings);
                 return 1; // Stack: callback
             }
@@ -1178,7 +2128,7 @@ int Eluna::Register(lua_State* L, uint8 regtype, uint32 entry, ObjectGuid guid,
                 }
 
                 auto key = EntryKey<Hooks::GossipEvents>((Hooks::GossipEvents)event_id, entry);
-                bindingID = ItemGossipBindings->Insert(key, functionRef, shots);
+                bindingID = ItemGossipBindings->Insert(key, functionRef, shots, priority, stopOnResult, bindingFilter);
                 createCancelCallback(L, bindingID, ItemGossipBindings);
                 return 1; // Stack: callback
             }
@@ -1188,7 +2138,7 @@ int Eluna::Register(lua_State* L, uint8 regtype, uint32 entry, ObjectGuid guid,
             if (event_id < Hooks::GOSSIP_EVENT_COUNT)
             {
                 auto key = EntryKey<Hooks::GossipEvents>((Hooks::GossipEvents)event_id, entry);
-                bindingID = PlayerGossipBindings->Insert(key, functionRef, shots);
+                bindingID = PlayerGossipBindings->Insert(key, functionRef, shots, priority, stopOnResult, bindingFilter);
                 createCancelCallback(L, bindingID, PlayerGossipBindings);
                 return 1; // Stack: callback
             }
@@ -1197,7 +2147,7 @@ int Eluna::Register(lua_State* L, uint8 regtype, uint32 entry, ObjectGuid guid,
             if (event_id < Hooks::INSTANCE_EVENT_COUNT)
             {
                 auto key = EntryKey<Hooks::InstanceEvents>((Hooks::InstanceEvents)event_id, entry);
-                bindingID = MapEventBindings->Insert(key, functionRef, shots);
+                bindingID = MapEventBindings->Insert(key, functionRef, shots, priority, stopOnResult, bindingFilter);
                 createCancelCallback(L, bindingID, MapEventBindings);
                 return 1; // Stack: callback
             }
@@ -1206,7 +2156,7 @@ int Eluna::Register(lua_State* L, uint8 regtype, uint32 entry, ObjectGuid guid,
             if (event_id < Hooks::INSTANCE_EVENT_COUNT)
             {
                 auto key = EntryKey<Hooks::InstanceEvents>((Hooks::InstanceEvents)event_id, entry);
-                bindingID = InstanceEventBindings->Insert(key, functionRef, shots);
+                bindingID = InstanceEventBindings->Insert(key, functionRef, shots, priority, stopOnResult, bindingFilter);
                 createCancelCallback(L, bindingID, InstanceEventBindings);
                 return 1; // Stack: callback
             }
@@ -1215,7 +2165,7 @@ int Eluna::Register(lua_State* L, uint8 regtype, uint32 entry, ObjectGuid guid,
             if (event_id < Hooks::TICKET_EVENT_COUNT)
             {
                 auto key = EventKey<Hooks::TicketEvents>((Hooks::TicketEvents)event_id);
-                bindingID = TicketEventBindings->Insert(key, functionRef, shots);
+                bindingID = TicketEventBindings->Insert(key, functionRef, shots, priority, stopOnResult, bindingFilter);
                 createCancelCallback(L, bindingID, TicketEventBindings);
                 return 1; // Stack: callback
             }
@@ -1231,7 +2181,7 @@ int Eluna::Register(lua_State* L, uint8 regtype, uint32 entry, ObjectGuid guid,
                 }
 
                 auto key = EntryKey<Hooks::SpellEvents>((Hooks::SpellEvents)event_id, entry);
-                bindingID = SpellEventBindings->Insert(key, functionRef, shots);
+                bindingID = SpellEventBindings->Insert(key, functionRef, shots, priority, stopOnResult, bindingFilter);
                 createCancelCallback(L, bindingID, SpellEventBindings);
                 return 1; // Stack: callback
             }
@@ -1281,29 +2231,198 @@ int Eluna::CallOneFunction(int number_of_functions, int number_of_arguments, int
     }
     // Stack: event_id, [arguments], [functions], event_id, [arguments]
 
+    // Taken before the call, handlers of nested events push and pop their own bindings
+    PushedBinding binding = pushedBindings.back();
+    pushedBindings.pop_back();
+    binding.Settle(!IsSuspended(lua_topointer(L, functions_top)));
+
     ExecuteCall(number_of_arguments, number_of_results);
     --functions_top;
     // Stack: event_id, [arguments], [functions - 1], [results]
 
+    lastCallStops = binding.stopOnResult;
     return functions_top + 1; // Return the location of the first result (if any exist).
 }
 
-CreatureAI* Eluna::GetAI(Creature* creature)
+/*
+ * Checks whether the handler last called with `CallOneFunction` was registered to stop the dispatch once the result is decided.
+ *
+ * If so, the `number_of_functions` handlers that were not called yet are removed from the stack.
+ * Call this only after the result has been decided, before calling the next handler.
+ */
+bool Eluna::StopsDispatch(int number_of_functions)
 {
-    if (!IsEnabled())
-        return NULL;
+    if (!lastCallStops)
+        return false;
 
-    for (int i = 1; i < Hooks::CREATURE_EVENT_COUNT; ++i)
+    // Stack: event_id, [arguments], [functions]
+    lua_pop(L, number_of_functions);
+    // The skipped handlers give their shots back
+    for (size_t i = pushedBindings.size() - number_of_functions; i < pushedBindings.size(); ++i)
+        pushedBindings[i].Settle(false);
+    pushedBindings.resize(pushedBindings.size() - number_of_functions);
+    // Stack: event_id, [arguments]
+    return true;
+}
+
+namespace
+{
+    // Progress of CallFunctions, kept outside of Lua so it survives a failing handler
+    struct FunctionCalls
+    {
+        int arguments;      // event_id and the arguments
+        int functions;      // Functions not yet called
+        bool checkResults;
+        bool defaultValue;
+        bool result;
+        const std::vector<PushedBinding>* bindings;
+        size_t firstBinding; // Binding of the first function
+        const std::unordered_set<const void*>* suspended;
+        const void* current; // Function called last
+        int currentIndex;   // Position of that function among the functions, the first is 0
+        Eluna* E;
+        HookProfiler* profiler; // NULL unless profiling
+        HookProfiler::HandlerStats* handler; // Stats of the function being called
+        uint64 callStart;
+    };
+
+    // Stack: calls, event_id, [arguments], [functions]
+    int DispatchFunctions(lua_State* L)
     {
-        Hooks::CreatureEvents event_id = (Hooks::CreatureEvents)i;
+        FunctionCalls* calls = static_cast<FunctionCalls*>(lua_touserdata(L, 1));
 
-        auto entryKey = EntryKey<Hooks::CreatureEvents>(event_id, creature->GetEntry());
-        auto uniqueKey = UniqueObjectKey<Hooks::CreatureEvents>(event_id, creature->GET_GUID(), creature->GetInstanceId());
+        while (calls->functions > 0)
+        {
+            // The last function is called first, like CallOneFunction does
+            int function_index = 1 + calls->arguments + calls->functions;
+            calls->current = lua_topointer(L, function_index);
+            calls->currentIndex = calls->functions - 1;
+            if (!calls->suspended->empty() && calls->suspended->count(calls->current))
+            {
+                --calls->functions;
+                (*calls->bindings)[calls->firstBinding + calls->functions].Settle(false);
+                continue;
+            }
+
+            if (calls->profiler)
+            {
+                calls->handler = calls->profiler->GetHandler(L, function_index);
+                calls->callStart = HookProfiler::Now();
+            }
+
+            lua_pushvalue(L, function_index);
+            for (int argument_index = 2; argument_index <= calls->arguments + 1; ++argument_index)
+                lua_pushvalue(L, argument_index);
 
-        if (CreatureEventBindings->HasBindingsFor(entryKey) ||
-            CreatureUniqueBindings->HasBindingsFor(uniqueKey))
-            return new ElunaCreatureAI(creature);
+            // Counted before the call, so a failing function is not called again
+            --calls->functions;
+            (*calls->bindings)[calls->firstBinding + calls->functions].Settle(true);
+            lua_call(L, calls->arguments, calls->checkResults ? 1 : 0);
+            calls->E->ResetCallErrors(calls->current);
+            if (calls->handler)
+            {
+                calls->profiler->RecordHandler(calls->handler, HookProfiler::Now() - calls->callStart);
+                calls->handler = NULL;
+            }
+
+            if (calls->checkResults)
+            {
+                if (lua_isboolean(L, -1) && (lua_toboolean(L, -1) == 1) != calls->defaultValue)
+                    calls->result = !calls->defaultValue;
+                lua_pop(L, 1);
+
+                // The result can't change back, skip the rest if the handler asked for it, they keep their shots
+                if (calls->result != calls->defaultValue && (*calls->bindings)[calls->firstBinding + calls->functions].stopOnResult)
+                {
+                    for (int i = 0; i < calls->functions; ++i)
+                        (*calls->bindings)[calls->firstBinding + i].Settle(false);
+                    calls->functions = 0;
+                }
+            }
+        }
+        return 0;
     }
+}
+
+/*
+ * Calls all event handlers that were put on the stack with `Setup` in one protected call and removes them from the stack.
+ *
+ * A handler that errors is reported and the remaining handlers are called in a new protected call.
+ * If `check_results` is true, returns `default_value` if all handlers returned `default_value` or no boolean,
+ *   otherwise the opposite of `default_value`. Once the result is decided, a handler registered with
+ *   `stopOnResult` ends the dispatch and the handlers after it are not called.
+ */
+bool Eluna::CallFunctions(int number_of_functions, int number_of_arguments, bool check_results, bool default_value)
+{
+    ++number_of_arguments; // Caller doesn't know about `event_id`.
+    ASSERT(number_of_functions > 0 && number_of_arguments > 0);
+    // Stack: event_id, [arguments], [functions]
+
+    int first_argument_index = lua_gettop(L) - number_of_functions - number_of_arguments + 1;
+    FunctionCalls calls = { number_of_arguments, number_of_functions, check_results, default_value, default_value,
+        &pushedBindings, pushedBindings.size() - number_of_functions, &suspendedHandlers, NULL, 0, this,
+        profiler->IsEnabled() ? profiler : NULL, NULL, 0 };
+
+    bool usetrace = eConfigMgr->GetOption<bool>("Eluna.TraceBack", false);
+    lua_checkstack(L, number_of_arguments + number_of_functions + 3);
+
+    while (calls.functions > 0)
+    {
+        int base = lua_gettop(L) + 1;
+        if (usetrace)
+            lua_pushcfunction(L, &StackTrace);
+
+        lua_pushcfunction(L, &DispatchFunctions);
+        lua_pushlightuserdata(L, &calls);
+        for (int index = first_argument_index; index < first_argument_index + calls.arguments + calls.functions; ++index)
+            lua_pushvalue(L, index);
+        // Stack: event_id, [arguments], [functions], [traceback], dispatch, calls, event_id, [arguments], [functions not yet called]
+
+        MarkLuaEntry();
+        // Objects are invalidated when event_level hits 0
+        ++event_level;
+        int result;
+        {
+            MemoryLimitScope limit(this, true);
+            result = lua_pcall(L, 1 + calls.arguments + calls.functions, 0, usetrace ? base : 0);
+        }
+        --event_level;
+
+        if (result)
+        {
+            // Stack: event_id, [arguments], [functions], [traceback], errmsg
+            if (calls.handler)
+            {
+                profiler->RecordHandler(calls.handler, HookProfiler::Now() - calls.callStart);
+                calls.handler = NULL;
+            }
+            ReportCallError(first_argument_index + calls.arguments + calls.currentIndex);
+        }
+
+        if (usetrace)
+            lua_remove(L, base);
+        // Stack: event_id, [arguments], [functions]
+    }
+
+    lua_pop(L, number_of_functions);
+    pushedBindings.resize(calls.firstBinding);
+    // Stack: event_id, [arguments]
+
+    return calls.result;
+}
+
+CreatureAI* Eluna::GetAI(Creature* creature)
+{
+    if (!IsEnabled())
+        return NULL;
+
+    // The event ID of the keys is ignored, only the entry and GUID are looked up
+    auto entryKey = EntryKey<Hooks::CreatureEvents>(Hooks::CreatureEvents(), creature->GetEntry());
+    auto uniqueKey = UniqueObjectKey<Hooks::CreatureEvents>(Hooks::CreatureEvents(), creature->GET_GUID(), creature->GetInstanceId());
+
+    if (CreatureEventBindings->GetEventMask(entryKey).any() ||
+        CreatureUniqueBindings->GetEventMask(uniqueKey).any())
+        return new ElunaCreatureAI(this, creature);
 
     return NULL;
 }
@@ -1313,16 +2432,12 @@ InstanceData* Eluna::GetInstanceData(Map* map)
     if (!IsEnabled())
         return NULL;
 
-    for (int i = 1; i < Hooks::INSTANCE_EVENT_COUNT; ++i)
-    {
-        Hooks::InstanceEvents event_id = (Hooks::InstanceEvents)i;
+    // The event ID of the key is ignored, only the map ID is looked up
+    auto key = EntryKey<Hooks::InstanceEvents>(Hooks::InstanceEvents(), map->GetId());
 
-        auto key = EntryKey<Hooks::InstanceEvents>(event_id, map->GetId());
-
-        if (MapEventBindings->HasBindingsFor(key) ||
-            InstanceEventBindings->HasBindingsFor(key))
-            return new ElunaInstanceAI(map);
-    }
+    if (MapEventBindings->GetEventMask(key).any() ||
+        InstanceEventBindings->GetEventMask(key).any())
+        return new ElunaInstanceAI(this, map);
 
     return NULL;
 }
@@ -1374,19 +2489,23 @@ void Eluna::CreateInstanceData(Map const* map)
  */
 void Eluna::FreeInstanceId(uint32 instanceId)
 {
-    LOCK_ELUNA;
+    LOCK_ELUNA_STATE(this);
 
     if (!IsEnabled())
         return;
 
+    auto ownerKey = EntryKey<Hooks::InstanceEvents>(Hooks::InstanceEvents(), instanceId);
+    auto mapEvents = MapEventBindings->GetEventMask(ownerKey);
+    auto instanceEvents = InstanceEventBindings->GetEventMask(ownerKey);
+
     for (int i = 1; i < Hooks::INSTANCE_EVENT_COUNT; ++i)
     {
         auto key = EntryKey<Hooks::InstanceEvents>((Hooks::InstanceEvents)i, instanceId);
 
-        if (MapEventBindings->HasBindingsFor(key))
+        if (mapEvents.test(i))
             MapEventBindings->Clear(key);
 
-        if (InstanceEventBindings->HasBindingsFor(key))
+        if (instanceEvents.test(i))
             InstanceEventBindings->Clear(key);
 
         if (instanceDataRefs.find(instanceId) != instanceDataRefs.end())
@@ -20,10 +20,12 @@
 #include "Hooks.h"
 #include "LFG.h"
 #include "ElunaUtility.h"
+#include "ElunaDeferredHook.h"
 #include "HttpManager.h"
 #include "EventEmitter.h"
 #include "TicketMgr.h"
 #include <mutex>
+#include <shared_mutex>
 #include <memory>
 
 extern "C"
@@ -63,6 +65,7 @@ class WorldPacket;
 class Vehicle;
 
 struct lua_State;
+struct lua_Debug;
 class EventMgr;
 class ElunaObject;
 template<typename T> class ElunaTemplate;
@@ -71,6 +74,22 @@ template<typename K> class BindingMap;
 template<typename T> struct EventKey;
 template<typename T> struct EntryKey;
 template<typename T> struct UniqueObjectKey;
+template<typename T> struct PrefixKey;
+class CommandTrie;
+class ElunaAllocator;
+class HookProfiler;
+class SamplingProfiler;
+struct BindingFilter;
+struct BindingFilterArgs;
+struct PushedBinding;
+
+// The kinds of Lua states a script is loaded into, see `Eluna.MultiState`
+enum ElunaStateFlags
+{
+    ELUNA_STATE_WORLD = 0x1,
+    ELUNA_STATE_MAP   = 0x2,
+    ELUNA_STATE_ALL   = ELUNA_STATE_WORLD | ELUNA_STATE_MAP
+};
 
 struct LuaScript
 {
@@ -78,10 +97,23 @@ struct LuaScript
     std::string filename;
     std::string filepath;
     std::string modulepath;
+    uint8 states;
+};
+
+// Time spent by the garbage collector scheduled by `Eluna::StepGC`
+struct ElunaGCStats
+{
+    uint32 lastTime;    // Microseconds spent collecting in the last update
+    uint64 totalTime;   // Microseconds spent collecting since the state was opened
+    uint32 steps;       // Collector steps taken
+    uint32 cycles;      // Collection cycles finished
 };
 
 #define ELUNA_STATE_PTR "Eluna State Ptr"
 #define LOCK_ELUNA Eluna::Guard __guard(Eluna::GetLock())
+// Locks the Lua state of `E`. Same as LOCK_ELUNA unless `Eluna.MultiState` is enabled.
+//   Lifts the memory limit of the state for the scope, a hook called from inside a handler must not fail to push its arguments.
+#define LOCK_ELUNA_STATE(E) Eluna::Guard __guard((E)->GetStateLock()); Eluna::MemoryLimitScope __limit((E), false)
 
 #define ELUNA_GAME_API AC_GAME_API
 
@@ -96,11 +128,40 @@ public:
     const std::string& GetRequirePath() const { return lua_requirepath; }
     const std::string& GetRequireCPath() const { return lua_requirecpath; }
 
+    /*
+     * Sets whether `Eluna.MemoryLimit` is enforced for the state until the end of the scope.
+     *
+     * It is enforced while handlers run in a protected call, where running out of memory is
+     *   an ordinary error, and lifted for the C++ code of hooks, see `ElunaAllocator`.
+     */
+    class MemoryLimitScope
+    {
+    public:
+        MemoryLimitScope(Eluna* E, bool limited);
+        ~MemoryLimitScope();
+
+    private:
+        Eluna* E;
+        bool previous;
+    };
+
 private:
+    typedef std::unordered_map<Map const*, Eluna*> MapStates;
+
     static bool reload;
     static bool initialized;
+    static bool multiState;
+    // Push 64-bit integers as Lua integers instead of userdata, Lua 5.3 and later only
+    static bool nativeIntegers;
     static LockType lock;
 
+    // Per-map Lua states when `Eluna.MultiState` is enabled
+    static MapStates mapStates;
+    static std::shared_mutex mapStatesLock;
+
+    // Sampling profiler of all states, see `.eluna profile`
+    static SamplingProfiler sampler;
+
     // Lua script locations
     static ScriptList lua_scripts;
     static ScriptList lua_extensions;
@@ -123,14 +184,70 @@ private:
     // When a hook pushes arguments to be passed to event handlers,
     //  this is used to keep track of how many arguments were pushed.
     uint8 push_counter;
+    // The bindings of the event handlers on the stack, whether they stop the dispatch once the result is decided
+    //   and the shots they hold. Mirrors the functions pushed by `SetupStack`, the last belongs to the top function.
+    std::vector<PushedBinding> pushedBindings;
+    // Stop flag of the handler last called by `CallOneFunction`
+    bool lastCallStops;
     bool enabled;
 
+    // Handler errors are logged at most once per `errorReportInterval` ms per error,
+    //   handlers are suspended after `errorSuspendThreshold` consecutive errors, see `ReportCallError`
+    uint32 errorReportInterval;
+    uint32 errorSuspendThreshold;
+
+    struct ErrorRecord
+    {
+        std::string error;  // First line of the error, its source location and message
+        uint32 lastReport;  // Time the error was last logged
+        uint32 repeats;     // Times the error occurred since then
+    };
+    // Recently logged errors by the hash of their first line
+    std::unordered_map<size_t, ErrorRecord> errorRecords;
+    struct HandlerErrors
+    {
+        uint32 count;       // Errors since the function last returned without one
+        int functionRef;    // Keeps the function alive, so no other function gets its address while counted
+    };
+    // Errors of the handler functions that failed last, and the functions that are no longer called
+    std::unordered_map<const void*, HandlerErrors> handlerErrors;
+    std::unordered_set<const void*> suspendedHandlers;
+
+    // The collector is stepped for at most `gcStepBudget` microseconds per update, see `StepGC`
+    uint32 gcStepBudget;
+    // Growth in percent over the heap left by a cycle at which Lua starts the next one itself
+    uint32 gcGrowth;
+    bool gcGenerational;
+    // Whether a cycle is being collected, and the heap size in KB at which `StepGC` starts the next one
+    bool gcCycleActive;
+    int gcNextCycleKB;
+    ElunaGCStats gcStats;
+
+    // Allocator of the Lua state, NULL with LuaJIT which uses its own
+    ElunaAllocator* allocator;
+
+    // Sampler session the hook of the state is installed for, 0 if none
+    uint32 samplingSession;
+    // For time based sessions, when Lua was last entered or the hook last called, and the Lua time
+    //   not yet sampled, in microseconds, see `SampleHook`
+    uint64 lastSampleHook;
+    uint64 unsampledTime;
+
+    // The map this state belongs to, or NULL for the world state
+    Map* stateMap;
+    // Lock of a map state. The world state uses the static `lock`.
+    LockType stateLock;
+    // Stable handle to this state, event processors hold a pointer to it
+    Eluna* self;
+    // Hooks fired for deferred handlers, run by `RunDeferredHooks`
+    ElunaUtil::MPSCQueue<DeferredHook> deferredHooks;
+
     // Map from instance ID -> Lua table ref
     std::unordered_map<uint32, int> instanceDataRefs;
     // Map from map ID -> Lua table ref
     std::unordered_map<uint32, int> continentDataRefs;
 
-    Eluna();
+    Eluna(Map* map = NULL);
     ~Eluna();
 
     // Prevent copy
@@ -149,32 +266,51 @@ private:
     static void LoadScriptPaths();
     static void GetScripts(std::string path);
     static void AddScriptPath(std::string filename, const std::string& fullpath);
+    static uint8 ReadScriptStates(const std::string& fullpath);
+    void ReloadState();
+    template<typename F> static void ForEachState(F f);
+    static bool HandleElunaCommand(ChatHandler& handler, const char* text);
+    static void ReportMemory(ChatHandler& handler, Eluna* E, const std::string& name);
+    static void ReportHookStats(ChatHandler& handler, uint32 top);
 
     static int StackTrace(lua_State *_L);
+    static int Panic(lua_State* _L);
     static void Report(lua_State* _L);
+    void ReportCallError(int functionIndex);
+    void ClearCallErrors(const void* function);
+    void FlushErrorReports();
+    bool IsSuspended(const void* function) const { return !suspendedHandlers.empty() && suspendedHandlers.count(function); }
+    void ConfigureGC();
+    void StepGC();
+    void UpdateSampling();
+    static void SampleHook(lua_State* L, lua_Debug* ar);
+    void MarkLuaEntry();
+    static void StopSampling(ChatHandler* handler);
 
     // Some helpers for hooks to call event handlers.
     // The bodies of the templates are in HookHelpers.h, so if you want to use them you need to #include "HookHelpers.h".
-    template<typename K1, typename K2> int SetupStack(BindingMap<K1>* bindings1, BindingMap<K2>* bindings2, const K1& key1, const K2& key2, int number_of_arguments);
+    template<typename K1, typename K2> int SetupStack(BindingMap<K1>* bindings1, BindingMap<K2>* bindings2, const K1& key1, const K2& key2, int number_of_arguments, const BindingFilterArgs* filter = NULL);
                                        int CallOneFunction(int number_of_functions, int number_of_arguments, int number_of_results);
+                                       bool CallFunctions(int number_of_functions, int number_of_arguments, bool check_results, bool default_value);
+                                       bool StopsDispatch(int number_of_functions);
                                        void CleanUpStack(int number_of_arguments);
     template<typename T>               void ReplaceArgument(T value, uint8 index);
-    template<typename K1, typename K2> void CallAllFunctions(BindingMap<K1>* bindings1, BindingMap<K2>* bindings2, const K1& key1, const K2& key2);
-    template<typename K1, typename K2> bool CallAllFunctionsBool(BindingMap<K1>* bindings1, BindingMap<K2>* bindings2, const K1& key1, const K2& key2, bool default_value = false);
+    template<typename K1, typename K2> void CallAllFunctions(BindingMap<K1>* bindings1, BindingMap<K2>* bindings2, const K1& key1, const K2& key2, const BindingFilterArgs* filter = NULL);
+    template<typename K1, typename K2> bool CallAllFunctionsBool(BindingMap<K1>* bindings1, BindingMap<K2>* bindings2, const K1& key1, const K2& key2, bool default_value = false, const BindingFilterArgs* filter = NULL);
 
     // Same as above but for only one binding instead of two.
     // `key` is passed twice because there's no NULL for references, but it's not actually used if `bindings2` is NULL.
-    template<typename K> int SetupStack(BindingMap<K>* bindings, const K& key, int number_of_arguments)
+    template<typename K> int SetupStack(BindingMap<K>* bindings, const K& key, int number_of_arguments, const BindingFilterArgs* filter = NULL)
     {
-        return SetupStack<K, K>(bindings, NULL, key, key, number_of_arguments);
+        return SetupStack<K, K>(bindings, NULL, key, key, number_of_arguments, filter);
     }
-    template<typename K> void CallAllFunctions(BindingMap<K>* bindings, const K& key)
+    template<typename K> void CallAllFunctions(BindingMap<K>* bindings, const K& key, const BindingFilterArgs* filter = NULL)
     {
-        CallAllFunctions<K, K>(bindings, NULL, key, key);
+        CallAllFunctions<K, K>(bindings, NULL, key, key, filter);
     }
-    template<typename K> bool CallAllFunctionsBool(BindingMap<K>* bindings, const K& key, bool default_value = false)
+    template<typename K> bool CallAllFunctionsBool(BindingMap<K>* bindings, const K& key, bool default_value = false, const BindingFilterArgs* filter = NULL)
     {
-        return CallAllFunctionsBool<K, K>(bindings, NULL, key, key, default_value);
+        return CallAllFunctionsBool<K, K>(bindings, NULL, key, key, default_value, filter);
     }
 
     // Non-static pushes, to be used in hooks.
@@ -191,15 +327,25 @@ private:
     void Push(const double value)               { Push(L, value); ++push_counter; }
     void Push(const std::string& value)         { Push(L, value); ++push_counter; }
     void Push(const char* value)                { Push(L, value); ++push_counter; }
+    void Push(const char* value, size_t length) { lua_pushlstring(L, value, length); ++push_counter; }
     void Push(ObjectGuid const value)           { Push(L, value); ++push_counter; }
     template<typename T>
     void Push(T const* ptr)                     { Push(L, ptr); ++push_counter; }
+    // Returns the object of the view, which the caller invalidates once the wrapped object may be gone
+    template<typename T>
+    ElunaObject* PushView(T const* ptr)         { ElunaTemplate<T>::PushView(L, ptr); ++push_counter; return static_cast<ElunaObject*>(lua_touserdata(L, -1)); }
+
+    // Queues a hook for the handlers registered as deferred, can be called from any thread
+    void QueueDeferredHook(DeferredHook&& hook) { deferredHooks.Enqueue(std::move(hook)); }
+    void RunDeferredHooks();
 
 public:
     static Eluna* GEluna;
 
     lua_State* L;
     EventMgr* eventMgr;
+    // Latencies of hooks and handlers, see `Eluna.HookProfiling`
+    HookProfiler* profiler;
     HttpManager httpManager;
     QueryCallbackProcessor queryProcessor;
     EventEmitter<void(std::string)> OnError;
@@ -226,15 +372,33 @@ public:
 
     BindingMap< UniqueObjectKey<Hooks::CreatureEvents> >*  CreatureUniqueBindings;
 
+    // Addon message handlers by message prefix, see `RegisterAddonMessage`
+    BindingMap< PrefixKey<Hooks::ServerEvents> >*    AddonMessageBindings;
+
+    // Chat commands and their handlers by command path, see `RegisterCommand`
+    CommandTrie*                                     Commands;
+    BindingMap< PrefixKey<Hooks::PlayerEvents> >*    CommandBindings;
+
+    // Handlers registered with `deferred` set, run from the queue instead of inside the hook
+    BindingMap< EventKey<Hooks::ServerEvents> >*     ServerEventDeferredBindings;
+    BindingMap< EventKey<Hooks::PlayerEvents> >*     PlayerEventDeferredBindings;
+    BindingMap< EventKey<Hooks::GuildEvents> >*      GuildEventDeferredBindings;
+    BindingMap< EventKey<Hooks::GroupEvents> >*      GroupEventDeferredBindings;
+
     static void Initialize();
     static void Uninitialize();
     // This function is used to make eluna reload
     static void ReloadEluna() { LOCK_ELUNA; reload = true; }
     static LockType& GetLock() { return lock; };
     static bool IsInitialized() { return initialized; }
+    static bool IsMultiState() { return multiState; }
     // Never returns nullptr
     static Eluna* GetEluna(lua_State* L)
     {
+        // With a single state there is nothing to look up
+        if (!multiState && GEluna)
+            return GEluna;
+
         lua_pushstring(L, ELUNA_STATE_PTR);
         lua_rawget(L, LUA_REGISTRYINDEX);
         ASSERT(lua_islightuserdata(L, -1));
@@ -244,6 +408,38 @@ public:
         return E;
     }
 
+    /*
+     * Returns the Lua state that handles hooks for `map`.
+     *
+     * This is the world state unless `Eluna.MultiState` is enabled. Never returns nullptr.
+     */
+    static Eluna* GetStateFor(Map const* map)
+    {
+        if (!multiState || !map)
+            return GEluna;
+
+        std::shared_lock<std::shared_mutex> guard(mapStatesLock);
+        MapStates::const_iterator itr = mapStates.find(map);
+        return itr != mapStates.end() ? itr->second : GEluna;
+    }
+    static Eluna* GetStateFor(WorldObject const* obj)
+    {
+        return GetStateFor(multiState ? obj->FindMap() : NULL);
+    }
+    static void CreateMapState(Map* map);
+    static void DestroyMapState(Map* map);
+
+    LockType& GetStateLock() { return stateMap ? stateLock : lock; }
+    Eluna** GetStateHandle() { return &self; }
+    Map* GetStateMap() const { return stateMap; }
+    int32 GetStateMapId() const;
+    // "World", or "Map <id>" and the instance ID for instances, for messages
+    std::string GetStateName() const;
+    uint32 GetStateInstanceId() const;
+
+    // Called when `function` returned without an error, only consecutive errors count towards suspending it
+    void ResetCallErrors(const void* function) { if (!handlerErrors.empty()) ClearCallErrors(function); }
+
     // Static pushes, can be used by anything, including methods.
     static void Push(lua_State* luastate); // nil
     static void Push(lua_State* luastate, const long long);
@@ -304,7 +500,14 @@ public:
     bool IsEnabled() const { return enabled && IsInitialized(); }
     bool HasLuaState() const { return L != NULL; }
     uint64 GetCallstackId() const { return callstackid; }
-    int Register(lua_State* L, uint8 reg, uint32 entry, ObjectGuid guid, uint32 instanceId, uint32 event_id, int functionRef, uint32 shots);
+    const ElunaGCStats& GetGCStats() const { return gcStats; }
+    const ElunaAllocator* GetAllocator() const { return allocator; }
+    bool IsGCGenerational() const { return gcGenerational; }
+    int RegisterAddonMessage(lua_State* L, const char* prefix, size_t length, int functionRef, uint32 shots, int32 priority = 0, bool stopOnResult = false);
+    int RegisterCommand(lua_State* L, const char* path, int functionRef, uint32 minSecurity);
+    int Register(lua_State* L, uint8 reg, uint32 entry, ObjectGuid guid, uint32 instanceId, uint32 event_id, int functionRef, uint32 shots, bool deferred = false, int32 priority = 0, bool stopOnResult = false, const BindingFilter* filter = NULL);
+    static bool IsDeferrable(uint8 regtype, uint32 event_id);
+    static uint8 GetFilterKinds(uint8 regtype, uint32 event_id);
 
     // Checks
     template<typename T> static T CHECKVAL(lua_State* luastate, int narg);
@@ -316,7 +519,8 @@ public:
     {
         return ElunaTemplate<T>::Check(luastate, narg, error);
     }
-    static ElunaObject* CHECKTYPE(lua_State* luastate, int narg, const char *tname, bool error = true);
+    // Returns the object at narg if it is of the type with the ID `typeId` or derived from it, any type if `tname` is NULL
+    static ElunaObject* CHECKTYPE(lua_State* luastate, int narg, const char *tname, uint32 typeId, bool error = true);
 
     CreatureAI* GetAI(Creature* creature);
     InstanceData* GetInstanceData(Map* map);
@@ -326,6 +530,7 @@ public:
     void OnTimedEvent(int funcRef, uint32 delay, uint32 calls, WorldObject* obj);
     bool OnCommand(ChatHandler& handler, const char* text);
     void OnWorldUpdate(uint32 diff);
+    void OnMapStateUpdate(uint32 diff);
     void OnLootItem(Player* pPlayer, Item* pItem, uint32 count, ObjectGuid guid);
     void OnLootMoney(Player* pPlayer, uint32 amount);
     void OnFirstLogin(Player* pPlayer);
@@ -547,9 +752,6 @@ public:
     void OnSpellCast(Unit* caster, Spell* spell, SpellInfo const* spellInfo, bool skipCheck);
     void OnSpellCastCancel(Unit* caster, Spell* spell, SpellInfo const* spellInfo, bool bySelf);
 };
-template<> Unit* Eluna::CHECKOBJ<Unit>(lua_State* L, int narg, bool error);
-template<> Object* Eluna::CHECKOBJ<Object>(lua_State* L, int narg, bool error);
-template<> WorldObject* Eluna::CHECKOBJ<WorldObject>(lua_State* L, int narg, bool error);
 template<> ElunaObject* Eluna::CHECKOBJ<ElunaObject>(lua_State* L, int narg, bool error);
 
 #define sEluna Eluna::GEluna
@@ -15,6 +15,9 @@ extern "C"
 #include "ElunaIncludes.h"
 #include "ElunaTemplate.h"
 #include "ElunaUtility.h"
+#include "ElunaTextMatcher.h"
+#include "ElunaAllocator.h"
+#include "ElunaProfiler.h"
 
 // Method includes
 #include "GlobalMethods.h"
@@ -42,6 +45,7 @@ extern "C"
 #include "RollMethods.h"
 #include "TicketMethods.h"
 #include "SpellInfoMethods.h"
+#include "TextMatcherMethods.h"
 
 // DBCStores includes
 #include "GemPropertiesEntryMethods.h"
@@ -52,6 +56,8 @@ luaL_Reg GlobalMethods[] =
     // Hooks
     { "RegisterPacketEvent", &LuaGlobalFunctions::RegisterPacketEvent },
     { "RegisterServerEvent", &LuaGlobalFunctions::RegisterServerEvent },
+    { "RegisterAddonMessageHandler", &LuaGlobalFunctions::RegisterAddonMessageHandler },
+    { "RegisterCommand", &LuaGlobalFunctions::RegisterCommand },
     { "RegisterPlayerEvent", &LuaGlobalFunctions::RegisterPlayerEvent },
     { "RegisterGuildEvent", &LuaGlobalFunctions::RegisterGuildEvent },
     { "RegisterGroupEvent", &LuaGlobalFunctions::RegisterGroupEvent },
@@ -83,6 +89,7 @@ luaL_Reg GlobalMethods[] =
     { "ClearPlayerEvents", &LuaGlobalFunctions::ClearPlayerEvents },
     { "ClearPlayerGossipEvents", &LuaGlobalFunctions::ClearPlayerGossipEvents },
     { "ClearServerEvents", &LuaGlobalFunctions::ClearServerEvents },
+    { "ClearAddonMessageHandlers", &LuaGlobalFunctions::ClearAddonMessageHandlers },
     { "ClearMapEvents", &LuaGlobalFunctions::ClearMapEvents },
     { "ClearInstanceEvents", &LuaGlobalFunctions::ClearInstanceEvents },
     { "ClearTicketEvents", &LuaGlobalFunctions::ClearTicketEvents },
@@ -97,6 +104,9 @@ luaL_Reg GlobalMethods[] =
     { "GetStateMap", &LuaGlobalFunctions::GetStateMap },
     { "GetStateMapId", &LuaGlobalFunctions::GetStateMapId },
     { "GetStateInstanceId", &LuaGlobalFunctions::GetStateInstanceId },
+    { "GetGCStats", &LuaGlobalFunctions::GetGCStats },
+    { "GetMemoryStats", &LuaGlobalFunctions::GetMemoryStats },
+    { "GetHookStats", &LuaGlobalFunctions::GetHookStats },
     { "GetQuest", &LuaGlobalFunctions::GetQuest },
     { "GetPlayerByGUID", &LuaGlobalFunctions::GetPlayerByGUID },
     { "GetPlayerByName", &LuaGlobalFunctions::GetPlayerByName },
@@ -159,6 +169,7 @@ luaL_Reg GlobalMethods[] =
     { "RemoveEvents", &LuaGlobalFunctions::RemoveEvents },
     { "PerformIngameSpawn", &LuaGlobalFunctions::PerformIngameSpawn },
     { "CreatePacket", &LuaGlobalFunctions::CreatePacket },
+    { "CreateTextMatcher", &LuaGlobalFunctions::CreateTextMatcher },
     { "AddVendorItem", &LuaGlobalFunctions::AddVendorItem },
     { "VendorRemoveItem", &LuaGlobalFunctions::VendorRemoveItem },
     { "VendorRemoveAllItems", &LuaGlobalFunctions::VendorRemoveAllItems },
@@ -181,42 +192,42 @@ luaL_Reg GlobalMethods[] =
 ElunaRegister<Object> ObjectMethods[] =
 {
     // Getters
-    { "GetEntry", &LuaObject::GetEntry },
-    { "GetGUID", &LuaObject::GetGUID },
-    { "GetGUIDLow", &LuaObject::GetGUIDLow },
-    { "GetInt32Value", &LuaObject::GetInt32Value },
-    { "GetUInt32Value", &LuaObject::GetUInt32Value },
-    { "GetFloatValue", &LuaObject::GetFloatValue },
-    { "GetByteValue", &LuaObject::GetByteValue },
-    { "GetUInt16Value", &LuaObject::GetUInt16Value },
-    { "GetUInt64Value", &LuaObject::GetUInt64Value },
-    { "GetScale", &LuaObject::GetScale },
-    { "GetTypeId", &LuaObject::GetTypeId },
+    { "GetEntry", &ElunaMethod<&LuaObject::GetEntry>::Call },
+    { "GetGUID", &ElunaMethod<&LuaObject::GetGUID>::Call },
+    { "GetGUIDLow", &ElunaMethod<&LuaObject::GetGUIDLow>::Call },
+    { "GetInt32Value", &ElunaMethod<&LuaObject::GetInt32Value>::Call },
+    { "GetUInt32Value", &ElunaMethod<&LuaObject::GetUInt32Value>::Call },
+    { "GetFloatValue", &ElunaMethod<&LuaObject::GetFloatValue>::Call },
+    { "GetByteValue", &ElunaMethod<&LuaObject::GetByteValue>::Call },
+    { "GetUInt16Value", &ElunaMethod<&LuaObject::GetUInt16Value>::Call },
+    { "GetUInt64Value", &ElunaMethod<&LuaObject::GetUInt64Value>::Call },
+    { "GetScale", &ElunaMethod<&LuaObject::GetScale>::Call },
+    { "GetTypeId", &ElunaMethod<&LuaObject::GetTypeId>::Call },
 
     // Setters
-    { "SetInt32Value", &LuaObject::SetInt32Value },
-    { "SetUInt32Value", &LuaObject::SetUInt32Value },
-    { "UpdateUInt32Value", &LuaObject::UpdateUInt32Value },
-    { "SetFloatValue", &LuaObject::SetFloatValue },
-    { "SetByteValue", &LuaObject::SetByteValue },
-    { "SetUInt16Value", &LuaObject::SetUInt16Value },
-    { "SetInt16Value", &LuaObject::SetInt16Value },
-    { "SetUInt64Value", &LuaObject::SetUInt64Value },
-    { "SetScale", &LuaObject::SetScale },
-    { "SetFlag", &LuaObject::SetFlag },
+    { "SetInt32Value", &ElunaMethod<&LuaObject::SetInt32Value>::Call },
+    { "SetUInt32Value", &ElunaMethod<&LuaObject::SetUInt32Value>::Call },
+    { "UpdateUInt32Value", &ElunaMethod<&LuaObject::UpdateUInt32Value>::Call },
+    { "SetFloatValue", &ElunaMethod<&LuaObject::SetFloatValue>::Call },
+    { "SetByteValue", &ElunaMethod<&LuaObject::SetByteValue>::Call },
+    { "SetUInt16Value", &ElunaMethod<&LuaObject::SetUInt16Value>::Call },
+    { "SetInt16Value", &ElunaMethod<&LuaObject::SetInt16Value>::Call },
+    { "SetUInt64Value", &ElunaMethod<&LuaObject::SetUInt64Value>::Call },
+    { "SetScale", &ElunaMethod<&LuaObject::SetScale>::Call },
+    { "SetFlag", &ElunaMethod<&LuaObject::SetFlag>::Call },
 
     // Boolean
-    { "IsInWorld", &LuaObject::IsInWorld },
-    { "IsPlayer", &LuaObject::IsPlayer },
-    { "HasFlag", &LuaObject::HasFlag },
+    { "IsInWorld", &ElunaMethod<&LuaObject::IsInWorld>::Call },
+    { "IsPlayer", &ElunaMethod<&LuaObject::IsPlayer>::Call },
+    { "HasFlag", &ElunaMethod<&LuaObject::HasFlag>::Call },
 
     // Other
-    { "ToGameObject", &LuaObject::ToGameObject },
-    { "ToUnit", &LuaObject::ToUnit },
-    { "ToCreature", &LuaObject::ToCreature },
-    { "ToPlayer", &LuaObject::ToPlayer },
-    { "ToCorpse", &LuaObject::ToCorpse },
-    { "RemoveFlag", &LuaObject::RemoveFlag },
+    { "ToGameObject", &ElunaMethod<&LuaObject::ToGameObject>::Call },
+    { "ToUnit", &ElunaMethod<&LuaObject::ToUnit>::Call },
+    { "ToCreature", &ElunaMethod<&LuaObject::ToCreature>::Call },
+    { "ToPlayer", &ElunaMethod<&LuaObject::ToPlayer>::Call },
+    { "ToCorpse", &ElunaMethod<&LuaObject::ToCorpse>::Call },
+    { "RemoveFlag", &ElunaMethod<&LuaObject::RemoveFlag>::Call },
 
     { NULL, NULL }
 };
@@ -224,57 +235,57 @@ ElunaRegister<Object> ObjectMethods[] =
 ElunaRegister<WorldObject> WorldObjectMethods[] =
 {
     // Getters
-    { "GetName", &LuaWorldObject::GetName },
-    { "GetMap", &LuaWorldObject::GetMap },
-    { "GetPhaseMask", &LuaWorldObject::GetPhaseMask },
-    { "SetPhaseMask", &LuaWorldObject::SetPhaseMask },
-    { "GetInstanceId", &LuaWorldObject::GetInstanceId },
-    { "GetAreaId", &LuaWorldObject::GetAreaId },
-    { "GetZoneId", &LuaWorldObject::GetZoneId },
-    { "GetMapId", &LuaWorldObject::GetMapId },
-    { "GetX", &LuaWorldObject::GetX },
-    { "GetY", &LuaWorldObject::GetY },
-    { "GetZ", &LuaWorldObject::GetZ },
-    { "GetO", &LuaWorldObject::GetO },
-    { "GetLocation", &LuaWorldObject::GetLocation },
-    { "GetPlayersInRange", &LuaWorldObject::GetPlayersInRange },
-    { "GetCreaturesInRange", &LuaWorldObject::GetCreaturesInRange },
-    { "GetGameObjectsInRange", &LuaWorldObject::GetGameObjectsInRange },
-    { "GetNearestPlayer", &LuaWorldObject::GetNearestPlayer },
-    { "GetNearestGameObject", &LuaWorldObject::GetNearestGameObject },
-    { "GetNearestCreature", &LuaWorldObject::GetNearestCreature },
-    { "GetNearObject", &LuaWorldObject::GetNearObject },
-    { "GetNearObjects", &LuaWorldObject::GetNearObjects },
-    { "GetDistance", &LuaWorldObject::GetDistance },
-    { "GetExactDistance", &LuaWorldObject::GetExactDistance },
-    { "GetDistance2d", &LuaWorldObject::GetDistance2d },
-    { "GetExactDistance2d", &LuaWorldObject::GetExactDistance2d },
-    { "GetRelativePoint", &LuaWorldObject::GetRelativePoint },
-    { "GetAngle", &LuaWorldObject::GetAngle },
+    { "GetName", &ElunaMethod<&LuaWorldObject::GetName>::Call },
+    { "GetMap", &ElunaMethod<&LuaWorldObject::GetMap>::Call },
+    { "GetPhaseMask", &ElunaMethod<&LuaWorldObject::GetPhaseMask>::Call },
+    { "SetPhaseMask", &ElunaMethod<&LuaWorldObject::SetPhaseMask>::Call },
+    { "GetInstanceId", &ElunaMethod<&LuaWorldObject::GetInstanceId>::Call },
+    { "GetAreaId", &ElunaMethod<&LuaWorldObject::GetAreaId>::Call },
+    { "GetZoneId", &ElunaMethod<&LuaWorldObject::GetZoneId>::Call },
+    { "GetMapId", &ElunaMethod<&LuaWorldObject::GetMapId>::Call },
+    { "GetX", &ElunaMethod<&LuaWorldObject::GetX>::Call },
+    { "GetY", &ElunaMethod<&LuaWorldObject::GetY>::Call },
+    { "GetZ", &ElunaMethod<&LuaWorldObject::GetZ>::Call },
+    { "GetO", &ElunaMethod<&LuaWorldObject::GetO>::Call },
+    { "GetLocation", &ElunaMethod<&LuaWorldObject::GetLocation>::Call },
+    { "GetPlayersInRange", &ElunaMethod<&LuaWorldObject::GetPlayersInRange>::Call },
+    { "GetCreaturesInRange", &ElunaMethod<&LuaWorldObject::GetCreaturesInRange>::Call },
+    { "GetGameObjectsInRange", &ElunaMethod<&LuaWorldObject::GetGameObjectsInRange>::Call },
+    { "GetNearestPlayer", &ElunaMethod<&LuaWorldObject::GetNearestPlayer>::Call },
+    { "GetNearestGameObject", &ElunaMethod<&LuaWorldObject::GetNearestGameObject>::Call },
+    { "GetNearestCreature", &ElunaMethod<&LuaWorldObject::GetNearestCreature>::Call },
+    { "GetNearObject", &ElunaMethod<&LuaWorldObject::GetNearObject>::Call },
+    { "GetNearObjects", &ElunaMethod<&LuaWorldObject::GetNearObjects>::Call },
+    { "GetDistance", &ElunaMethod<&LuaWorldObject::GetDistance>::Call },
+    { "GetExactDistance", &ElunaMethod<&LuaWorldObject::GetExactDistance>::Call },
+    { "GetDistance2d", &ElunaMethod<&LuaWorldObject::GetDistance2d>::Call },
+    { "GetExactDistance2d", &ElunaMethod<&LuaWorldObject::GetExactDistance2d>::Call },
+    { "GetRelativePoint", &ElunaMethod<&LuaWorldObject::GetRelativePoint>::Call },
+    { "GetAngle", &ElunaMethod<&LuaWorldObject::GetAngle>::Call },
 
     // Boolean
-    { "IsWithinLoS", &LuaWorldObject::IsWithinLoS },
-    { "IsInMap", &LuaWorldObject::IsInMap },
-    { "IsWithinDist3d", &LuaWorldObject::IsWithinDist3d },
-    { "IsWithinDist2d", &LuaWorldObject::IsWithinDist2d },
-    { "IsWithinDist", &LuaWorldObject::IsWithinDist },
-    { "IsWithinDistInMap", &LuaWorldObject::IsWithinDistInMap },
-    { "IsInRange", &LuaWorldObject::IsInRange },
-    { "IsInRange2d", &LuaWorldObject::IsInRange2d },
-    { "IsInRange3d", &LuaWorldObject::IsInRange3d },
-    { "IsInFront", &LuaWorldObject::IsInFront },
-    { "IsInBack", &LuaWorldObject::IsInBack },
+    { "IsWithinLoS", &ElunaMethod<&LuaWorldObject::IsWithinLoS>::Call },
+    { "IsInMap", &ElunaMethod<&LuaWorldObject::IsInMap>::Call },
+    { "IsWithinDist3d", &ElunaMethod<&LuaWorldObject::IsWithinDist3d>::Call },
+    { "IsWithinDist2d", &ElunaMethod<&LuaWorldObject::IsWithinDist2d>::Call },
+    { "IsWithinDist", &ElunaMethod<&LuaWorldObject::IsWithinDist>::Call },
+    { "IsWithinDistInMap", &ElunaMethod<&LuaWorldObject::IsWithinDistInMap>::Call },
+    { "IsInRange", &ElunaMethod<&LuaWorldObject::IsInRange>::Call },
+    { "IsInRange2d", &ElunaMethod<&LuaWorldObject::IsInRange2d>::Call },
+    { "IsInRange3d", &ElunaMethod<&LuaWorldObject::IsInRange3d>::Call },
+    { "IsInFront", &ElunaMethod<&LuaWorldObject::IsInFront>::Call },
+    { "IsInBack", &ElunaMethod<&LuaWorldObject::IsInBack>::Call },
 
     // Other
-    { "SummonGameObject", &LuaWorldObject::SummonGameObject },
-    { "SpawnCreature", &LuaWorldObject::SpawnCreature },
-    { "SendPacket", &LuaWorldObject::SendPacket },
-    { "RegisterEvent", &LuaWorldObject::RegisterEvent },
-    { "RemoveEventById", &LuaWorldObject::RemoveEventById },
-    { "RemoveEvents", &LuaWorldObject::RemoveEvents },
-    { "PlayMusic", &LuaWorldObject::PlayMusic },
-    { "PlayDirectSound", &LuaWorldObject::PlayDirectSound },
-    { "PlayDistanceSound", &LuaWorldObject::PlayDistanceSound },
+    { "SummonGameObject", &ElunaMethod<&LuaWorldObject::SummonGameObject>::Call },
+    { "SpawnCreature", &ElunaMethod<&LuaWorldObject::SpawnCreature>::Call },
+    { "SendPacket", &ElunaMethod<&LuaWorldObject::SendPacket>::Call },
+    { "RegisterEvent", &ElunaMethod<&LuaWorldObject::RegisterEvent>::Call },
+    { "RemoveEventById", &ElunaMethod<&LuaWorldObject::RemoveEventById>::Call },
+    { "RemoveEvents", &ElunaMethod<&LuaWorldObject::RemoveEvents>::Call },
+    { "PlayMusic", &ElunaMethod<&LuaWorldObject::PlayMusic>::Call },
+    { "PlayDirectSound", &ElunaMethod<&LuaWorldObject::PlayDirectSound>::Call },
+    { "PlayDistanceSound", &ElunaMethod<&LuaWorldObject::PlayDistanceSound>::Call },
 
     { NULL, NULL }
 };
@@ -282,186 +293,186 @@ ElunaRegister<WorldObject> WorldObjectMethods[] =
 ElunaRegister<Unit> UnitMethods[] =
 {
     // Getters
-    { "GetLevel", &LuaUnit::GetLevel },
-    { "GetHealth", &LuaUnit::GetHealth },
-    { "GetDisplayId", &LuaUnit::GetDisplayId },
-    { "GetNativeDisplayId", &LuaUnit::GetNativeDisplayId },
-    { "GetPower", &LuaUnit::GetPower },
-    { "GetMaxPower", &LuaUnit::GetMaxPower },
-    { "GetPowerType", &LuaUnit::GetPowerType },
-    { "GetMaxHealth", &LuaUnit::GetMaxHealth },
-    { "GetHealthPct", &LuaUnit::GetHealthPct },
-    { "GetPowerPct", &LuaUnit::GetPowerPct },
-    { "GetGender", &LuaUnit::GetGender },
-    { "GetRace", &LuaUnit::GetRace },
-    { "GetClass", &LuaUnit::GetClass },
-    { "GetRaceMask", &LuaUnit::GetRaceMask },
-    { "GetClassMask", &LuaUnit::GetClassMask },
-    { "GetRaceAsString", &LuaUnit::GetRaceAsString },
-    { "GetClassAsString", &LuaUnit::GetClassAsString },
-    { "GetAura", &LuaUnit::GetAura },
-    { "GetFaction", &LuaUnit::GetFaction },
-    { "GetCurrentSpell", &LuaUnit::GetCurrentSpell },
-    { "GetCreatureType", &LuaUnit::GetCreatureType },
-    { "GetMountId", &LuaUnit::GetMountId },
-    { "GetOwner", &LuaUnit::GetOwner },
-    { "GetFriendlyUnitsInRange", &LuaUnit::GetFriendlyUnitsInRange },
-    { "GetUnfriendlyUnitsInRange", &LuaUnit::GetUnfriendlyUnitsInRange },
-    { "GetOwnerGUID", &LuaUnit::GetOwnerGUID },
-    { "GetCreatorGUID", &LuaUnit::GetCreatorGUID },
-    { "GetMinionGUID", &LuaUnit::GetPetGUID },
-    { "GetCharmerGUID", &LuaUnit::GetCharmerGUID },
-    { "GetCharmGUID", &LuaUnit::GetCharmGUID },
-    { "GetPetGUID", &LuaUnit::GetPetGUID },
-    { "GetCritterGUID", &LuaUnit::GetCritterGUID },
-    { "GetControllerGUID", &LuaUnit::GetControllerGUID },
-    { "GetControllerGUIDS", &LuaUnit::GetControllerGUIDS },
-    { "GetStandState", &LuaUnit::GetStandState },
-    { "GetVictim", &LuaUnit::GetVictim },
-    { "GetSpeed", &LuaUnit::GetSpeed },
-    { "GetSpeedRate", &LuaUnit::GetSpeedRate },
-    { "GetStat", &LuaUnit::GetStat },
-    { "GetBaseSpellPower", &LuaUnit::GetBaseSpellPower },
-    { "GetVehicleKit", &LuaUnit::GetVehicleKit },
+    { "GetLevel", &ElunaMethod<&LuaUnit::GetLevel>::Call },
+    { "GetHealth", &ElunaMethod<&LuaUnit::GetHealth>::Call },
+    { "GetDisplayId", &ElunaMethod<&LuaUnit::GetDisplayId>::Call },
+    { "GetNativeDisplayId", &ElunaMethod<&LuaUnit::GetNativeDisplayId>::Call },
+    { "GetPower", &ElunaMethod<&LuaUnit::GetPower>::Call },
+    { "GetMaxPower", &ElunaMethod<&LuaUnit::GetMaxPower>::Call },
+    { "GetPowerType", &ElunaMethod<&LuaUnit::GetPowerType>::Call },
+    { "GetMaxHealth", &ElunaMethod<&LuaUnit::GetMaxHealth>::Call },
+    { "GetHealthPct", &ElunaMethod<&LuaUnit::GetHealthPct>::Call },
+    { "GetPowerPct", &ElunaMethod<&LuaUnit::GetPowerPct>::Call },
+    { "GetGender", &ElunaMethod<&LuaUnit::GetGender>::Call },
+    { "GetRace", &ElunaMethod<&LuaUnit::GetRace>::Call },
+    { "GetClass", &ElunaMethod<&LuaUnit::GetClass>::Call },
+    { "GetRaceMask", &ElunaMethod<&LuaUnit::GetRaceMask>::Call },
+    { "GetClassMask", &ElunaMethod<&LuaUnit::GetClassMask>::Call },
+    { "GetRaceAsString", &ElunaMethod<&LuaUnit::GetRaceAsString>::Call },
+    { "GetClassAsString", &ElunaMethod<&LuaUnit::GetClassAsString>::Call },
+    { "GetAura", &ElunaMethod<&LuaUnit::GetAura>::Call },
+    { "GetFaction", &ElunaMethod<&LuaUnit::GetFaction>::Call },
+    { "GetCurrentSpell", &ElunaMethod<&LuaUnit::GetCurrentSpell>::Call },
+    { "GetCreatureType", &ElunaMethod<&LuaUnit::GetCreatureType>::Call },
+    { "GetMountId", &ElunaMethod<&LuaUnit::GetMountId>::Call },
+    { "GetOwner", &ElunaMethod<&LuaUnit::GetOwner>::Call },
+    { "GetFriendlyUnitsInRange", &ElunaMethod<&LuaUnit::GetFriendlyUnitsInRange>::Call },
+    { "GetUnfriendlyUnitsInRange", &ElunaMethod<&LuaUnit::GetUnfriendlyUnitsInRange>::Call },
+    { "GetOwnerGUID", &ElunaMethod<&LuaUnit::GetOwnerGUID>::Call },
+    { "GetCreatorGUID", &ElunaMethod<&LuaUnit::GetCreatorGUID>::Call },
+    { "GetMinionGUID", &ElunaMethod<&LuaUnit::GetPetGUID>::Call },
+    { "GetCharmerGUID", &ElunaMethod<&LuaUnit::GetCharmerGUID>::Call },
+    { "GetCharmGUID", &ElunaMethod<&LuaUnit::GetCharmGUID>::Call },
+    { "GetPetGUID", &ElunaMethod<&LuaUnit::GetPetGUID>::Call },
+    { "GetCritterGUID", &ElunaMethod<&LuaUnit::GetCritterGUID>::Call },
+    { "GetControllerGUID", &ElunaMethod<&LuaUnit::GetControllerGUID>::Call },
+    { "GetControllerGUIDS", &ElunaMethod<&LuaUnit::GetControllerGUIDS>::Call },
+    { "GetStandState", &ElunaMethod<&LuaUnit::GetStandState>::Call },
+    { "GetVictim", &ElunaMethod<&LuaUnit::GetVictim>::Call },
+    { "GetSpeed", &ElunaMethod<&LuaUnit::GetSpeed>::Call },
+    { "GetSpeedRate", &ElunaMethod<&LuaUnit::GetSpeedRate>::Call },
+    { "GetStat", &ElunaMethod<&LuaUnit::GetStat>::Call },
+    { "GetBaseSpellPower", &ElunaMethod<&LuaUnit::GetBaseSpellPower>::Call },
+    { "GetVehicleKit", &ElunaMethod<&LuaUnit::GetVehicleKit>::Call },
     // {"GetVehicle", &LuaUnit::GetVehicle},                           // :GetVehicle() - UNDOCUMENTED - Gets the Vehicle kit of the vehicle the unit is on
-    { "GetMovementType", &LuaUnit::GetMovementType },
-    { "GetAttackers", &LuaUnit::GetAttackers },
-    { "GetThreat", &LuaUnit::GetThreat },
+    { "GetMovementType", &ElunaMethod<&LuaUnit::GetMovementType>::Call },
+    { "GetAttackers", &ElunaMethod<&LuaUnit::GetAttackers>::Call },
+    { "GetThreat", &ElunaMethod<&LuaUnit::GetThreat>::Call },
 
     // Setters
-    { "SetFaction", &LuaUnit::SetFaction },
-    { "SetLevel", &LuaUnit::SetLevel },
-    { "SetHealth", &LuaUnit::SetHealth },
-    { "SetMaxHealth", &LuaUnit::SetMaxHealth },
-    { "SetPower", &LuaUnit::SetPower },
-    { "SetMaxPower", &LuaUnit::SetMaxPower },
-    { "SetPowerType", &LuaUnit::SetPowerType },
-    { "SetDisplayId", &LuaUnit::SetDisplayId },
-    { "SetNativeDisplayId", &LuaUnit::SetNativeDisplayId },
-    { "SetFacing", &LuaUnit::SetFacing },
-    { "SetFacingToObject", &LuaUnit::SetFacingToObject },
-    { "SetSpeed", &LuaUnit::SetSpeed },
-    { "SetSpeedRate", &LuaUnit::SetSpeedRate },
+    { "SetFaction", &ElunaMethod<&LuaUnit::SetFaction>::Call },
+    { "SetLevel", &ElunaMethod<&LuaUnit::SetLevel>::Call },
+    { "SetHealth", &ElunaMethod<&LuaUnit::SetHealth>::Call },
+    { "SetMaxHealth", &ElunaMethod<&LuaUnit::SetMaxHealth>::Call },
+    { "SetPower", &ElunaMethod<&LuaUnit::SetPower>::Call },
+    { "SetMaxPower", &ElunaMethod<&LuaUnit::SetMaxPower>::Call },
+    { "SetPowerType", &ElunaMethod<&LuaUnit::SetPowerType>::Call },
+    { "SetDisplayId", &ElunaMethod<&LuaUnit::SetDisplayId>::Call },
+    { "SetNativeDisplayId", &ElunaMethod<&LuaUnit::SetNativeDisplayId>::Call },
+    { "SetFacing", &ElunaMethod<&LuaUnit::SetFacing>::Call },
+    { "SetFacingToObject", &ElunaMethod<&LuaUnit::SetFacingToObject>::Call },
+    { "SetSpeed", &ElunaMethod<&LuaUnit::SetSpeed>::Call },
+    { "SetSpeedRate", &ElunaMethod<&LuaUnit::SetSpeedRate>::Call },
     // {"SetStunned", &LuaUnit::SetStunned},                           // :SetStunned([enable]) - UNDOCUMENTED - Stuns or removes stun
     {"SetRooted", &LuaUnit::SetRooted},
     {"SetConfused", &LuaUnit::SetConfused},
     {"SetFeared", &LuaUnit::SetFeared},
-    { "SetPvP", &LuaUnit::SetPvP },
-    { "SetFFA", &LuaUnit::SetFFA },
-    { "SetSanctuary", &LuaUnit::SetSanctuary },
+    { "SetPvP", &ElunaMethod<&LuaUnit::SetPvP>::Call },
+    { "SetFFA", &ElunaMethod<&LuaUnit::SetFFA>::Call },
+    { "SetSanctuary", &ElunaMethod<&LuaUnit::SetSanctuary>::Call },
     // {"SetCanFly", &LuaUnit::SetCanFly},                             // :SetCanFly(apply) - UNDOCUMENTED
     // {"SetVisible", &LuaUnit::SetVisible},                           // :SetVisible(x) - UNDOCUMENTED
-    { "SetOwnerGUID", &LuaUnit::SetOwnerGUID },
-    { "SetName", &LuaUnit::SetName },
-    { "SetSheath", &LuaUnit::SetSheath },
-    { "SetCreatorGUID", &LuaUnit::SetCreatorGUID },
-    { "SetMinionGUID", &LuaUnit::SetPetGUID },
-    { "SetPetGUID", &LuaUnit::SetPetGUID },
-    { "SetCritterGUID", &LuaUnit::SetCritterGUID },
-    { "SetWaterWalk", &LuaUnit::SetWaterWalk },
-    { "SetStandState", &LuaUnit::SetStandState },
-    { "SetInCombatWith", &LuaUnit::SetInCombatWith },
-    { "ModifyPower", &LuaUnit::ModifyPower },
-    { "SetImmuneTo", &LuaUnit::SetImmuneTo },
+    { "SetOwnerGUID", &ElunaMethod<&LuaUnit::SetOwnerGUID>::Call },
+    { "SetName", &ElunaMethod<&LuaUnit::SetName>::Call },
+    { "SetSheath", &ElunaMethod<&LuaUnit::SetSheath>::Call },
+    { "SetCreatorGUID", &ElunaMethod<&LuaUnit::SetCreatorGUID>::Call },
+    { "SetMinionGUID", &ElunaMethod<&LuaUnit::SetPetGUID>::Call },
+    { "SetPetGUID", &ElunaMethod<&LuaUnit::SetPetGUID>::Call },
+    { "SetCritterGUID", &ElunaMethod<&LuaUnit::SetCritterGUID>::Call },
+    { "SetWaterWalk", &ElunaMethod<&LuaUnit::SetWaterWalk>::Call },
+    { "SetStandState", &ElunaMethod<&LuaUnit::SetStandState>::Call },
+    { "SetInCombatWith", &ElunaMethod<&LuaUnit::SetInCombatWith>::Call },
+    { "ModifyPower", &ElunaMethod<&LuaUnit::ModifyPower>::Call },
+    { "SetImmuneTo", &ElunaMethod<&LuaUnit::SetImmuneTo>::Call },
 
     // Boolean
-    { "IsAlive", &LuaUnit::IsAlive },
-    { "IsDead", &LuaUnit::IsDead },
-    { "IsDying", &LuaUnit::IsDying },
-    { "IsPvPFlagged", &LuaUnit::IsPvPFlagged },
-    { "IsInCombat", &LuaUnit::IsInCombat },
-    { "IsBanker", &LuaUnit::IsBanker },
-    { "IsBattleMaster", &LuaUnit::IsBattleMaster },
-    { "IsCharmed", &LuaUnit::IsCharmed },
-    { "IsArmorer", &LuaUnit::IsArmorer },
-    { "IsAttackingPlayer", &LuaUnit::IsAttackingPlayer },
-    { "IsInWater", &LuaUnit::IsInWater },
-    { "IsUnderWater", &LuaUnit::IsUnderWater },
-    { "IsAuctioneer", &LuaUnit::IsAuctioneer },
-    { "IsGuildMaster", &LuaUnit::IsGuildMaster },
-    { "IsInnkeeper", &LuaUnit::IsInnkeeper },
-    { "IsTrainer", &LuaUnit::IsTrainer },
-    { "IsGossip", &LuaUnit::IsGossip },
-    { "IsTaxi", &LuaUnit::IsTaxi },
-    { "IsSpiritHealer", &LuaUnit::IsSpiritHealer },
-    { "IsSpiritGuide", &LuaUnit::IsSpiritGuide },
-    { "IsTabardDesigner", &LuaUnit::IsTabardDesigner },
-    { "IsServiceProvider", &LuaUnit::IsServiceProvider },
-    { "IsSpiritService", &LuaUnit::IsSpiritService },
-    { "HealthBelowPct", &LuaUnit::HealthBelowPct },
-    { "HealthAbovePct", &LuaUnit::HealthAbovePct },
-    { "IsMounted", &LuaUnit::IsMounted },
-    { "AttackStop", &LuaUnit::AttackStop },
-    { "Attack", &LuaUnit::Attack },
+    { "IsAlive", &ElunaMethod<&LuaUnit::IsAlive>::Call },
+    { "IsDead", &ElunaMethod<&LuaUnit::IsDead>::Call },
+    { "IsDying", &ElunaMethod<&LuaUnit::IsDying>::Call },
+    { "IsPvPFlagged", &ElunaMethod<&LuaUnit::IsPvPFlagged>::Call },
+    { "IsInCombat", &ElunaMethod<&LuaUnit::IsInCombat>::Call },
+    { "IsBanker", &ElunaMethod<&LuaUnit::IsBanker>::Call },
+    { "IsBattleMaster", &ElunaMethod<&LuaUnit::IsBattleMaster>::Call },
+    { "IsCharmed", &ElunaMethod<&LuaUnit::IsCharmed>::Call },
+    { "IsArmorer", &ElunaMethod<&LuaUnit::IsArmorer>::Call },
+    { "IsAttackingPlayer", &ElunaMethod<&LuaUnit::IsAttackingPlayer>::Call },
+    { "IsInWater", &ElunaMethod<&LuaUnit::IsInWater>::Call },
+    { "IsUnderWater", &ElunaMethod<&LuaUnit::IsUnderWater>::Call },
+    { "IsAuctioneer", &ElunaMethod<&LuaUnit::IsAuctioneer>::Call },
+    { "IsGuildMaster", &ElunaMethod<&LuaUnit::IsGuildMaster>::Call },
+    { "IsInnkeeper", &ElunaMethod<&LuaUnit::IsInnkeeper>::Call },
+    { "IsTrainer", &ElunaMethod<&LuaUnit::IsTrainer>::Call },
+    { "IsGossip", &ElunaMethod<&LuaUnit::IsGossip>::Call },
+    { "IsTaxi", &ElunaMethod<&LuaUnit::IsTaxi>::Call },
+    { "IsSpiritHealer", &ElunaMethod<&LuaUnit::IsSpiritHealer>::Call },
+    { "IsSpiritGuide", &ElunaMethod<&LuaUnit::IsSpiritGuide>::Call },
+    { "IsTabardDesigner", &ElunaMethod<&LuaUnit::IsTabardDesigner>::Call },
+    { "IsServiceProvider", &ElunaMethod<&LuaUnit::IsServiceProvider>::Call },
+    { "IsSpiritService", &ElunaMethod<&LuaUnit::IsSpiritService>::Call },
+    { "HealthBelowPct", &ElunaMethod<&LuaUnit::HealthBelowPct>::Call },
+    { "HealthAbovePct", &ElunaMethod<&LuaUnit::HealthAbovePct>::Call },
+    { "IsMounted", &ElunaMethod<&LuaUnit::IsMounted>::Call },
+    { "AttackStop", &ElunaMethod<&LuaUnit::AttackStop>::Call },
+    { "Attack", &ElunaMethod<&LuaUnit::Attack>::Call },
     // {"IsVisible", &LuaUnit::IsVisible},                              // :IsVisible() - UNDOCUMENTED
     // {"IsMoving", &LuaUnit::IsMoving},                                // :IsMoving() - UNDOCUMENTED
     // {"IsFlying", &LuaUnit::IsFlying},                                // :IsFlying() - UNDOCUMENTED
-    { "IsStopped", &LuaUnit::IsStopped },
-    { "HasUnitState", &LuaUnit::HasUnitState },
-    { "IsQuestGiver", &LuaUnit::IsQuestGiver },
-    { "IsInAccessiblePlaceFor", &LuaUnit::IsInAccessiblePlaceFor },
-    { "IsVendor", &LuaUnit::IsVendor },
-    { "IsRooted", &LuaUnit::IsRooted },
-    { "IsFullHealth", &LuaUnit::IsFullHealth },
-    { "HasAura", &LuaUnit::HasAura },
-    { "IsCasting", &LuaUnit::IsCasting },
-    { "IsStandState", &LuaUnit::IsStandState },
-    { "IsOnVehicle", &LuaUnit::IsOnVehicle },
+    { "IsStopped", &ElunaMethod<&LuaUnit::IsStopped>::Call },
+    { "HasUnitState", &ElunaMethod<&LuaUnit::HasUnitState>::Call },
+    { "IsQuestGiver", &ElunaMethod<&LuaUnit::IsQuestGiver>::Call },
+    { "IsInAccessiblePlaceFor", &ElunaMethod<&LuaUnit::IsInAccessiblePlaceFor>::Call },
+    { "IsVendor", &ElunaMethod<&LuaUnit::IsVendor>::Call },
+    { "IsRooted", &ElunaMethod<&LuaUnit::IsRooted>::Call },
+    { "IsFullHealth", &ElunaMethod<&LuaUnit::IsFullHealth>::Call },
+    { "HasAura", &ElunaMethod<&LuaUnit::HasAura>::Call },
+    { "IsCasting", &ElunaMethod<&LuaUnit::IsCasting>::Call },
+    { "IsStandState", &ElunaMethod<&LuaUnit::IsStandState>::Call },
+    { "IsOnVehicle", &ElunaMethod<&LuaUnit::IsOnVehicle>::Call },
 
     // Other
-    { "HandleStatModifier", &LuaUnit::HandleStatModifier },
-    { "AddAura", &LuaUnit::AddAura },
-    { "RemoveAura", &LuaUnit::RemoveAura },
-    { "RemoveAllAuras", &LuaUnit::RemoveAllAuras },
-    { "RemoveArenaAuras", &LuaUnit::RemoveArenaAuras },
-    { "ClearInCombat", &LuaUnit::ClearInCombat },
-    { "DeMorph", &LuaUnit::DeMorph },
-    { "SendUnitWhisper", &LuaUnit::SendUnitWhisper },
-    { "SendUnitEmote", &LuaUnit::SendUnitEmote },
-    { "SendUnitSay", &LuaUnit::SendUnitSay },
-    { "SendUnitYell", &LuaUnit::SendUnitYell },
-    { "CastSpell", &LuaUnit::CastSpell },
-    { "CastCustomSpell", &LuaUnit::CastCustomSpell },
-    { "CastSpellAoF", &LuaUnit::CastSpellAoF },
-    { "Kill", &LuaUnit::Kill },
-    { "StopSpellCast", &LuaUnit::StopSpellCast },
-    { "InterruptSpell", &LuaUnit::InterruptSpell },
-    { "SendChatMessageToPlayer", &LuaUnit::SendChatMessageToPlayer },
-    { "PerformEmote", &LuaUnit::PerformEmote },
-    { "EmoteState", &LuaUnit::EmoteState },
-    { "CountPctFromCurHealth", &LuaUnit::CountPctFromCurHealth },
-    { "CountPctFromMaxHealth", &LuaUnit::CountPctFromMaxHealth },
-    { "Dismount", &LuaUnit::Dismount },
-    { "Mount", &LuaUnit::Mount },
+    { "HandleStatModifier", &ElunaMethod<&LuaUnit::HandleStatModifier>::Call },
+    { "AddAura", &ElunaMethod<&LuaUnit::AddAura>::Call },
+    { "RemoveAura", &ElunaMethod<&LuaUnit::RemoveAura>::Call },
+    { "RemoveAllAuras", &ElunaMethod<&LuaUnit::RemoveAllAuras>::Call },
+    { "RemoveArenaAuras", &ElunaMethod<&LuaUnit::RemoveArenaAuras>::Call },
+    { "ClearInCombat", &ElunaMethod<&LuaUnit::ClearInCombat>::Call },
+    { "DeMorph", &ElunaMethod<&LuaUnit::DeMorph>::Call },
+    { "SendUnitWhisper", &ElunaMethod<&LuaUnit::SendUnitWhisper>::Call },
+    { "SendUnitEmote", &ElunaMethod<&LuaUnit::SendUnitEmote>::Call },
+    { "SendUnitSay", &ElunaMethod<&LuaUnit::SendUnitSay>::Call },
+    { "SendUnitYell", &ElunaMethod<&LuaUnit::SendUnitYell>::Call },
+    { "CastSpell", &ElunaMethod<&LuaUnit::CastSpell>::Call },
+    { "CastCustomSpell", &ElunaMethod<&LuaUnit::CastCustomSpell>::Call },
+    { "CastSpellAoF", &ElunaMethod<&LuaUnit::CastSpellAoF>::Call },
+    { "Kill", &ElunaMethod<&LuaUnit::Kill>::Call },
+    { "StopSpellCast", &ElunaMethod<&LuaUnit::StopSpellCast>::Call },
+    { "InterruptSpell", &ElunaMethod<&LuaUnit::InterruptSpell>::Call },
+    { "SendChatMessageToPlayer", &ElunaMethod<&LuaUnit::SendChatMessageToPlayer>::Call },
+    { "PerformEmote", &ElunaMethod<&LuaUnit::PerformEmote>::Call },
+    { "EmoteState", &ElunaMethod<&LuaUnit::EmoteState>::Call },
+    { "CountPctFromCurHealth", &ElunaMethod<&LuaUnit::CountPctFromCurHealth>::Call },
+    { "CountPctFromMaxHealth", &ElunaMethod<&LuaUnit::CountPctFromMaxHealth>::Call },
+    { "Dismount", &ElunaMethod<&LuaUnit::Dismount>::Call },
+    { "Mount", &ElunaMethod<&LuaUnit::Mount>::Call },
     // {"RestoreDisplayId", &LuaUnit::RestoreDisplayId},                // :RestoreDisplayId() - UNDOCUMENTED
     // {"RestoreFaction", &LuaUnit::RestoreFaction},                    // :RestoreFaction() - UNDOCUMENTED
     // {"RemoveBindSightAuras", &LuaUnit::RemoveBindSightAuras},        // :RemoveBindSightAuras() - UNDOCUMENTED
     // {"RemoveCharmAuras", &LuaUnit::RemoveCharmAuras},                // :RemoveCharmAuras() - UNDOCUMENTED
-    { "ClearThreatList", &LuaUnit::ClearThreatList },
-    { "GetThreatList", &LuaUnit::GetThreatList },
-    { "ClearUnitState", &LuaUnit::ClearUnitState },
-    { "AddUnitState", &LuaUnit::AddUnitState },
+    { "ClearThreatList", &ElunaMethod<&LuaUnit::ClearThreatList>::Call },
+    { "GetThreatList", &ElunaMethod<&LuaUnit::GetThreatList>::Call },
+    { "ClearUnitState", &ElunaMethod<&LuaUnit::ClearUnitState>::Call },
+    { "AddUnitState", &ElunaMethod<&LuaUnit::AddUnitState>::Call },
     // {"DisableMelee", &LuaUnit::DisableMelee},                        // :DisableMelee([disable]) - UNDOCUMENTED - if true, enables
     // {"SummonGuardian", &LuaUnit::SummonGuardian},                    // :SummonGuardian(entry, x, y, z, o[, duration]) - UNDOCUMENTED - summons a guardian to location. Scales with summoner, is friendly to him and guards him.
-    { "NearTeleport", &LuaUnit::NearTeleport },
-    { "MoveIdle", &LuaUnit::MoveIdle },
-    { "MoveRandom", &LuaUnit::MoveRandom },
-    { "MoveHome", &LuaUnit::MoveHome },
-    { "MoveFollow", &LuaUnit::MoveFollow },
-    { "MoveChase", &LuaUnit::MoveChase },
-    { "MoveConfused", &LuaUnit::MoveConfused },
-    { "MoveFleeing", &LuaUnit::MoveFleeing },
-    { "MoveTo", &LuaUnit::MoveTo },
-    { "MoveJump", &LuaUnit::MoveJump },
-    { "MoveStop", &LuaUnit::MoveStop },
-    { "MoveExpire", &LuaUnit::MoveExpire },
-    { "MoveClear", &LuaUnit::MoveClear },
-    { "DealDamage", &LuaUnit::DealDamage },
-    { "DealHeal", &LuaUnit::DealHeal },
-    { "AddThreat", &LuaUnit::AddThreat },
-    { "ModifyThreatPct", &LuaUnit::ModifyThreatPct },
-    { "ClearThreat", &LuaUnit::ClearThreat },
-    { "ResetAllThreat", &LuaUnit::ResetAllThreat },
+    { "NearTeleport", &ElunaMethod<&LuaUnit::NearTeleport>::Call },
+    { "MoveIdle", &ElunaMethod<&LuaUnit::MoveIdle>::Call },
+    { "MoveRandom", &ElunaMethod<&LuaUnit::MoveRandom>::Call },
+    { "MoveHome", &ElunaMethod<&LuaUnit::MoveHome>::Call },
+    { "MoveFollow", &ElunaMethod<&LuaUnit::MoveFollow>::Call },
+    { "MoveChase", &ElunaMethod<&LuaUnit::MoveChase>::Call },
+    { "MoveConfused", &ElunaMethod<&LuaUnit::MoveConfused>::Call },
+    { "MoveFleeing", &ElunaMethod<&LuaUnit::MoveFleeing>::Call },
+    { "MoveTo", &ElunaMethod<&LuaUnit::MoveTo>::Call },
+    { "MoveJump", &ElunaMethod<&LuaUnit::MoveJump>::Call },
+    { "MoveStop", &ElunaMethod<&LuaUnit::MoveStop>::Call },
+    { "MoveExpire", &ElunaMethod<&LuaUnit::MoveExpire>::Call },
+    { "MoveClear", &ElunaMethod<&LuaUnit::MoveClear>::Call },
+    { "DealDamage", &ElunaMethod<&LuaUnit::DealDamage>::Call },
+    { "DealHeal", &ElunaMethod<&LuaUnit::DealHeal>::Call },
+    { "AddThreat", &ElunaMethod<&LuaUnit::AddThreat>::Call },
+    { "ModifyThreatPct", &ElunaMethod<&LuaUnit::ModifyThreatPct>::Call },
+    { "ClearThreat", &ElunaMethod<&LuaUnit::ClearThreat>::Call },
+    { "ResetAllThreat", &ElunaMethod<&LuaUnit::ResetAllThreat>::Call },
 
     { NULL, NULL }
 };
@@ -469,291 +480,291 @@ ElunaRegister<Unit> UnitMethods[] =
 ElunaRegister<Player> PlayerMethods[] =
 {
     // Getters
-    { "GetSelection", &LuaPlayer::GetSelection },
-    { "GetGMRank", &LuaPlayer::GetGMRank },
-    { "GetGuildId", &LuaPlayer::GetGuildId },
-    { "GetCoinage", &LuaPlayer::GetCoinage },
-    { "GetTeam", &LuaPlayer::GetTeam },
-    { "GetItemCount", &LuaPlayer::GetItemCount },
-    { "GetGroup", &LuaPlayer::GetGroup },
-    { "GetGuild", &LuaPlayer::GetGuild },
-    { "GetAccountId", &LuaPlayer::GetAccountId },
-    { "GetAccountName", &LuaPlayer::GetAccountName },
-    { "GetCompletedQuestsCount", &LuaPlayer::GetCompletedQuestsCount },
-    { "GetArenaPoints", &LuaPlayer::GetArenaPoints },
-    { "GetHonorPoints", &LuaPlayer::GetHonorPoints },
-    { "GetLifetimeKills", &LuaPlayer::GetLifetimeKills },
-    { "GetPlayerIP", &LuaPlayer::GetPlayerIP },
-    { "GetLevelPlayedTime", &LuaPlayer::GetLevelPlayedTime },
-    { "GetTotalPlayedTime", &LuaPlayer::GetTotalPlayedTime },
-    { "GetItemByPos", &LuaPlayer::GetItemByPos },
-    { "GetItemByEntry", &LuaPlayer::GetItemByEntry },
-    { "GetItemByGUID", &LuaPlayer::GetItemByGUID },
-    { "GetMailCount", &LuaPlayer::GetMailCount },
-    { "GetMailItem", &LuaPlayer::GetMailItem },
-    { "GetReputation", &LuaPlayer::GetReputation },
-    { "GetEquippedItemBySlot", &LuaPlayer::GetEquippedItemBySlot },
-    { "GetQuestLevel", &LuaPlayer::GetQuestLevel },
-    { "GetChatTag", &LuaPlayer::GetChatTag },
-    { "GetRestBonus", &LuaPlayer::GetRestBonus },
-    { "GetPhaseMaskForSpawn", &LuaPlayer::GetPhaseMaskForSpawn },
-    { "GetAchievementPoints", &LuaPlayer::GetAchievementPoints },
-    { "GetCompletedAchievementsCount", &LuaPlayer::GetCompletedAchievementsCount },
-    { "GetReqKillOrCastCurrentCount", &LuaPlayer::GetReqKillOrCastCurrentCount },
-    { "GetQuestStatus", &LuaPlayer::GetQuestStatus },
-    { "GetInGameTime", &LuaPlayer::GetInGameTime },
-    { "GetComboPoints", &LuaPlayer::GetComboPoints },
-    { "GetComboTarget", &LuaPlayer::GetComboTarget },
-    { "GetGuildName", &LuaPlayer::GetGuildName },
-    { "GetFreeTalentPoints", &LuaPlayer::GetFreeTalentPoints },
-    { "GetActiveSpec", &LuaPlayer::GetActiveSpec },
-    { "GetSpecsCount", &LuaPlayer::GetSpecsCount },
-    { "GetSpellCooldownDelay", &LuaPlayer::GetSpellCooldownDelay },
-    { "GetGuildRank", &LuaPlayer::GetGuildRank },
-    { "GetDifficulty", &LuaPlayer::GetDifficulty },
-    { "GetHealthBonusFromStamina", &LuaPlayer::GetHealthBonusFromStamina },
-    { "GetManaBonusFromIntellect", &LuaPlayer::GetManaBonusFromIntellect },
-    { "GetMaxSkillValue", &LuaPlayer::GetMaxSkillValue },
-    { "GetPureMaxSkillValue", &LuaPlayer::GetPureMaxSkillValue },
-    { "GetSkillValue", &LuaPlayer::GetSkillValue },
-    { "GetBaseSkillValue", &LuaPlayer::GetBaseSkillValue },
-    { "GetPureSkillValue", &LuaPlayer::GetPureSkillValue },
-    { "GetSkillPermBonusValue", &LuaPlayer::GetSkillPermBonusValue },
-    { "GetSkillTempBonusValue", &LuaPlayer::GetSkillTempBonusValue },
-    { "GetReputationRank", &LuaPlayer::GetReputationRank },
-    { "GetDrunkValue", &LuaPlayer::GetDrunkValue },
-    { "GetBattlegroundId", &LuaPlayer::GetBattlegroundId },
-    { "GetBattlegroundTypeId", &LuaPlayer::GetBattlegroundTypeId },
-    { "GetXP", &LuaPlayer::GetXP },
-    { "GetXPRestBonus", &LuaPlayer::GetXPRestBonus },
-    { "GetGroupInvite", &LuaPlayer::GetGroupInvite },
-    { "GetSubGroup", &LuaPlayer::GetSubGroup },
-    { "GetNextRandomRaidMember", &LuaPlayer::GetNextRandomRaidMember },
-    { "GetOriginalGroup", &LuaPlayer::GetOriginalGroup },
-    { "GetOriginalSubGroup", &LuaPlayer::GetOriginalSubGroup },
-    { "GetChampioningFaction", &LuaPlayer::GetChampioningFaction },
-    { "GetLatency", &LuaPlayer::GetLatency },
+    { "GetSelection", &ElunaMethod<&LuaPlayer::GetSelection>::Call },
+    { "GetGMRank", &ElunaMethod<&LuaPlayer::GetGMRank>::Call },
+    { "GetGuildId", &ElunaMethod<&LuaPlayer::GetGuildId>::Call },
+    { "GetCoinage", &ElunaMethod<&LuaPlayer::GetCoinage>::Call },
+    { "GetTeam", &ElunaMethod<&LuaPlayer::GetTeam>::Call },
+    { "GetItemCount", &ElunaMethod<&LuaPlayer::GetItemCount>::Call },
+    { "GetGroup", &ElunaMethod<&LuaPlayer::GetGroup>::Call },
+    { "GetGuild", &ElunaMethod<&LuaPlayer::GetGuild>::Call },
+    { "GetAccountId", &ElunaMethod<&LuaPlayer::GetAccountId>::Call },
+    { "GetAccountName", &ElunaMethod<&LuaPlayer::GetAccountName>::Call },
+    { "GetCompletedQuestsCount", &ElunaMethod<&LuaPlayer::GetCompletedQuestsCount>::Call },
+    { "GetArenaPoints", &ElunaMethod<&LuaPlayer::GetArenaPoints>::Call },
+    { "GetHonorPoints", &ElunaMethod<&LuaPlayer::GetHonorPoints>::Call },
+    { "GetLifetimeKills", &ElunaMethod<&LuaPlayer::GetLifetimeKills>::Call },
+    { "GetPlayerIP", &ElunaMethod<&LuaPlayer::GetPlayerIP>::Call },
+    { "GetLevelPlayedTime", &ElunaMethod<&LuaPlayer::GetLevelPlayedTime>::Call },
+    { "GetTotalPlayedTime", &ElunaMethod<&LuaPlayer::GetTotalPlayedTime>::Call },
+    { "GetItemByPos", &ElunaMethod<&LuaPlayer::GetItemByPos>::Call },
+    { "GetItemByEntry", &ElunaMethod<&LuaPlayer::GetItemByEntry>::Call },
+    { "GetItemByGUID", &ElunaMethod<&LuaPlayer::GetItemByGUID>::Call },
+    { "GetMailCount", &ElunaMethod<&LuaPlayer::GetMailCount>::Call },
+    { "GetMailItem", &ElunaMethod<&LuaPlayer::GetMailItem>::Call },
+    { "GetReputation", &ElunaMethod<&LuaPlayer::GetReputation>::Call },
+    { "GetEquippedItemBySlot", &ElunaMethod<&LuaPlayer::GetEquippedItemBySlot>::Call },
+    { "GetQuestLevel", &ElunaMethod<&LuaPlayer::GetQuestLevel>::Call },
+    { "GetChatTag", &ElunaMethod<&LuaPlayer::GetChatTag>::Call },
+    { "GetRestBonus", &ElunaMethod<&LuaPlayer::GetRestBonus>::Call },
+    { "GetPhaseMaskForSpawn", &ElunaMethod<&LuaPlayer::GetPhaseMaskForSpawn>::Call },
+    { "GetAchievementPoints", &ElunaMethod<&LuaPlayer::GetAchievementPoints>::Call },
+    { "GetCompletedAchievementsCount", &ElunaMethod<&LuaPlayer::GetCompletedAchievementsCount>::Call },
+    { "GetReqKillOrCastCurrentCount", &ElunaMethod<&LuaPlayer::GetReqKillOrCastCurrentCount>::Call },
+    { "GetQuestStatus", &ElunaMethod<&LuaPlayer::GetQuestStatus>::Call },
+    { "GetInGameTime", &ElunaMethod<&LuaPlayer::GetInGameTime>::Call },
+    { "GetComboPoints", &ElunaMethod<&LuaPlayer::GetComboPoints>::Call },
+    { "GetComboTarget", &ElunaMethod<&LuaPlayer::GetComboTarget>::Call },
+    { "GetGuildName", &ElunaMethod<&LuaPlayer::GetGuildName>::Call },
+    { "GetFreeTalentPoints", &ElunaMethod<&LuaPlayer::GetFreeTalentPoints>::Call },
+    { "GetActiveSpec", &ElunaMethod<&LuaPlayer::GetActiveSpec>::Call },
+    { "GetSpecsCount", &ElunaMethod<&LuaPlayer::GetSpecsCount>::Call },
+    { "GetSpellCooldownDelay", &ElunaMethod<&LuaPlayer::GetSpellCooldownDelay>::Call },
+    { "GetGuildRank", &ElunaMethod<&LuaPlayer::GetGuildRank>::Call },
+    { "GetDifficulty", &ElunaMethod<&LuaPlayer::GetDifficulty>::Call },
+    { "GetHealthBonusFromStamina", &ElunaMethod<&LuaPlayer::GetHealthBonusFromStamina>::Call },
+    { "GetManaBonusFromIntellect", &ElunaMethod<&LuaPlayer::GetManaBonusFromIntellect>::Call },
+    { "GetMaxSkillValue", &ElunaMethod<&LuaPlayer::GetMaxSkillValue>::Call },
+    { "GetPureMaxSkillValue", &ElunaMethod<&LuaPlayer::GetPureMaxSkillValue>::Call },
+    { "GetSkillValue", &ElunaMethod<&LuaPlayer::GetSkillValue>::Call },
+    { "GetBaseSkillValue", &ElunaMethod<&LuaPlayer::GetBaseSkillValue>::Call },
+    { "GetPureSkillValue", &ElunaMethod<&LuaPlayer::GetPureSkillValue>::Call },
+    { "GetSkillPermBonusValue", &ElunaMethod<&LuaPlayer::GetSkillPermBonusValue>::Call },
+    { "GetSkillTempBonusValue", &ElunaMethod<&LuaPlayer::GetSkillTempBonusValue>::Call },
+    { "GetReputationRank", &ElunaMethod<&LuaPlayer::GetReputationRank>::Call },
+    { "GetDrunkValue", &ElunaMethod<&LuaPlayer::GetDrunkValue>::Call },
+    { "GetBattlegroundId", &ElunaMethod<&LuaPlayer::GetBattlegroundId>::Call },
+    { "GetBattlegroundTypeId", &ElunaMethod<&LuaPlayer::GetBattlegroundTypeId>::Call },
+    { "GetXP", &ElunaMethod<&LuaPlayer::GetXP>::Call },
+    { "GetXPRestBonus", &ElunaMethod<&LuaPlayer::GetXPRestBonus>::Call },
+    { "GetGroupInvite", &ElunaMethod<&LuaPlayer::GetGroupInvite>::Call },
+    { "GetSubGroup", &ElunaMethod<&LuaPlayer::GetSubGroup>::Call },
+    { "GetNextRandomRaidMember", &ElunaMethod<&LuaPlayer::GetNextRandomRaidMember>::Call },
+    { "GetOriginalGroup", &ElunaMethod<&LuaPlayer::GetOriginalGroup>::Call },
+    { "GetOriginalSubGroup", &ElunaMethod<&LuaPlayer::GetOriginalSubGroup>::Call },
+    { "GetChampioningFaction", &ElunaMethod<&LuaPlayer::GetChampioningFaction>::Call },
+    { "GetLatency", &ElunaMethod<&LuaPlayer::GetLatency>::Call },
     // {"GetRecruiterId", &LuaPlayer::GetRecruiterId},                            // :GetRecruiterId() - UNDOCUMENTED - Returns player's recruiter's ID
-    { "GetDbLocaleIndex", &LuaPlayer::GetDbLocaleIndex },
-    { "GetDbcLocale", &LuaPlayer::GetDbcLocale },
-    { "GetCorpse", &LuaPlayer::GetCorpse },
-    { "GetGossipTextId", &LuaPlayer::GetGossipTextId },
-    { "GetQuestRewardStatus", &LuaPlayer::GetQuestRewardStatus },
-    { "GetShieldBlockValue", &LuaPlayer::GetShieldBlockValue },
-    { "GetPlayerSettingValue", &LuaPlayer::GetPlayerSettingValue },
-    { "GetTrader", &LuaPlayer::GetTrader },
-    { "GetBonusTalentCount", &LuaPlayer::GetBonusTalentCount },
-    { "GetKnownTaxiNodes", &LuaPlayer::GetKnownTaxiNodes },
+    { "GetDbLocaleIndex", &ElunaMethod<&LuaPlayer::GetDbLocaleIndex>::Call },
+    { "GetDbcLocale", &ElunaMethod<&LuaPlayer::GetDbcLocale>::Call },
+    { "GetCorpse", &ElunaMethod<&LuaPlayer::GetCorpse>::Call },
+    { "GetGossipTextId", &ElunaMethod<&LuaPlayer::GetGossipTextId>::Call },
+    { "GetQuestRewardStatus", &ElunaMethod<&LuaPlayer::GetQuestRewardStatus>::Call },
+    { "GetShieldBlockValue", &ElunaMethod<&LuaPlayer::GetShieldBlockValue>::Call },
+    { "GetPlayerSettingValue", &ElunaMethod<&LuaPlayer::GetPlayerSettingValue>::Call },
+    { "GetTrader", &ElunaMethod<&LuaPlayer::GetTrader>::Call },
+    { "GetBonusTalentCount", &ElunaMethod<&LuaPlayer::GetBonusTalentCount>::Call },
+    { "GetKnownTaxiNodes", &ElunaMethod<&LuaPlayer::GetKnownTaxiNodes>::Call },
 
     // Setters
-    { "AdvanceSkillsToMax", &LuaPlayer::AdvanceSkillsToMax },
-    { "AdvanceSkill", &LuaPlayer::AdvanceSkill },
-    { "AdvanceAllSkills", &LuaPlayer::AdvanceAllSkills },
-    { "AddLifetimeKills", &LuaPlayer::AddLifetimeKills },
-    { "SetCoinage", &LuaPlayer::SetCoinage },
-    { "SetKnownTitle", &LuaPlayer::SetKnownTitle },
-    { "UnsetKnownTitle", &LuaPlayer::UnsetKnownTitle },
-    { "SetBindPoint", &LuaPlayer::SetBindPoint },
-    { "SetArenaPoints", &LuaPlayer::SetArenaPoints },
-    { "SetHonorPoints", &LuaPlayer::SetHonorPoints },
-    { "SetSpellPower", &LuaPlayer::SetSpellPower },
-    { "SetLifetimeKills", &LuaPlayer::SetLifetimeKills },
-    { "SetGameMaster", &LuaPlayer::SetGameMaster },
-    { "SetGMChat", &LuaPlayer::SetGMChat },
-    { "SetKnownTaxiNodes", &LuaPlayer::SetKnownTaxiNodes },
-    { "SetTaxiCheat", &LuaPlayer::SetTaxiCheat },
-    { "SetGMVisible", &LuaPlayer::SetGMVisible },
-    { "SetPvPDeath", &LuaPlayer::SetPvPDeath },
-    { "SetAcceptWhispers", &LuaPlayer::SetAcceptWhispers },
-    { "SetRestBonus", &LuaPlayer::SetRestBonus },
-    { "SetQuestStatus", &LuaPlayer::SetQuestStatus },
-    { "SetReputation", &LuaPlayer::SetReputation },
-    { "SetFreeTalentPoints", &LuaPlayer::SetFreeTalentPoints },
-    { "SetGuildRank", &LuaPlayer::SetGuildRank },
+    { "AdvanceSkillsToMax", &ElunaMethod<&LuaPlayer::AdvanceSkillsToMax>::Call },
+    { "AdvanceSkill", &ElunaMethod<&LuaPlayer::AdvanceSkill>::Call },
+    { "AdvanceAllSkills", &ElunaMethod<&LuaPlayer::AdvanceAllSkills>::Call },
+    { "AddLifetimeKills", &ElunaMethod<&LuaPlayer::AddLifetimeKills>::Call },
+    { "SetCoinage", &ElunaMethod<&LuaPlayer::SetCoinage>::Call },
+    { "SetKnownTitle", &ElunaMethod<&LuaPlayer::SetKnownTitle>::Call },
+    { "UnsetKnownTitle", &ElunaMethod<&LuaPlayer::UnsetKnownTitle>::Call },
+    { "SetBindPoint", &ElunaMethod<&LuaPlayer::SetBindPoint>::Call },
+    { "SetArenaPoints", &ElunaMethod<&LuaPlayer::SetArenaPoints>::Call },
+    { "SetHonorPoints", &ElunaMethod<&LuaPlayer::SetHonorPoints>::Call },
+    { "SetSpellPower", &ElunaMethod<&LuaPlayer::SetSpellPower>::Call },
+    { "SetLifetimeKills", &ElunaMethod<&LuaPlayer::SetLifetimeKills>::Call },
+    { "SetGameMaster", &ElunaMethod<&LuaPlayer::SetGameMaster>::Call },
+    { "SetGMChat", &ElunaMethod<&LuaPlayer::SetGMChat>::Call },
+    { "SetKnownTaxiNodes", &ElunaMethod<&LuaPlayer::SetKnownTaxiNodes>::Call },
+    { "SetTaxiCheat", &ElunaMethod<&LuaPlayer::SetTaxiCheat>::Call },
+    { "SetGMVisible", &ElunaMethod<&LuaPlayer::SetGMVisible>::Call },
+    { "SetPvPDeath", &ElunaMethod<&LuaPlayer::SetPvPDeath>::Call },
+    { "SetAcceptWhispers", &ElunaMethod<&LuaPlayer::SetAcceptWhispers>::Call },
+    { "SetRestBonus", &ElunaMethod<&LuaPlayer::SetRestBonus>::Call },
+    { "SetQuestStatus", &ElunaMethod<&LuaPlayer::SetQuestStatus>::Call },
+    { "SetReputation", &ElunaMethod<&LuaPlayer::SetReputation>::Call },
+    { "SetFreeTalentPoints", &ElunaMethod<&LuaPlayer::SetFreeTalentPoints>::Call },
+    { "SetGuildRank", &ElunaMethod<&LuaPlayer::SetGuildRank>::Call },
     // {"SetMovement", &LuaPlayer::SetMovement},                  // :SetMovement(type) - UNDOCUMENTED - Sets player's movement type
-    { "SetSkill", &LuaPlayer::SetSkill },
-    { "SetFactionForRace", &LuaPlayer::SetFactionForRace },
-    { "SetDrunkValue", &LuaPlayer::SetDrunkValue },
-    { "SetAtLoginFlag", &LuaPlayer::SetAtLoginFlag },
-    { "SetPlayerLock", &LuaPlayer::SetPlayerLock },
-    { "SetGender", &LuaPlayer::SetGender },
-    { "SetSheath", &LuaPlayer::SetSheath },
-    { "SetBonusTalentCount", &LuaPlayer::SetBonusTalentCount },
-    { "AddBonusTalent", &LuaPlayer::AddBonusTalent },
-    { "RemoveBonusTalent", &LuaPlayer::RemoveBonusTalent },
-    { "GetHomebind", &LuaPlayer::GetHomebind },
-    { "GetSpells", &LuaPlayer::GetSpells },
+    { "SetSkill", &ElunaMethod<&LuaPlayer::SetSkill>::Call },
+    { "SetFactionForRace", &ElunaMethod<&LuaPlayer::SetFactionForRace>::Call },
+    { "SetDrunkValue", &ElunaMethod<&LuaPlayer::SetDrunkValue>::Call },
+    { "SetAtLoginFlag", &ElunaMethod<&LuaPlayer::SetAtLoginFlag>::Call },
+    { "SetPlayerLock", &ElunaMethod<&LuaPlayer::SetPlayerLock>::Call },
+    { "SetGender", &ElunaMethod<&LuaPlayer::SetGender>::Call },
+    { "SetSheath", &ElunaMethod<&LuaPlayer::SetSheath>::Call },
+    { "SetBonusTalentCount", &ElunaMethod<&LuaPlayer::SetBonusTalentCount>::Call },
+    { "AddBonusTalent", &ElunaMethod<&LuaPlayer::AddBonusTalent>::Call },
+    { "RemoveBonusTalent", &ElunaMethod<&LuaPlayer::RemoveBonusTalent>::Call },
+    { "GetHomebind", &ElunaMethod<&LuaPlayer::GetHomebind>::Call },
+    { "GetSpells", &ElunaMethod<&LuaPlayer::GetSpells>::Call },
 
     // Boolean
-    { "HasTankSpec", &LuaPlayer::HasTankSpec },
-    { "HasMeleeSpec", &LuaPlayer::HasMeleeSpec },
-    { "HasCasterSpec", &LuaPlayer::HasCasterSpec },
-    { "HasHealSpec", &LuaPlayer::HasHealSpec },
-    { "IsInGroup", &LuaPlayer::IsInGroup },
-    { "IsInGuild", &LuaPlayer::IsInGuild },
-    { "IsGM", &LuaPlayer::IsGM },
-    { "IsImmuneToDamage", &LuaPlayer::IsImmuneToDamage },
-    { "IsAlliance", &LuaPlayer::IsAlliance },
-    { "IsHorde", &LuaPlayer::IsHorde },
-    { "HasTitle", &LuaPlayer::HasTitle },
-    { "HasItem", &LuaPlayer::HasItem },
-    { "Teleport", &LuaPlayer::Teleport },
-    { "AddItem", &LuaPlayer::AddItem },
-    { "IsInArenaTeam", &LuaPlayer::IsInArenaTeam },
-    { "CanRewardQuest", &LuaPlayer::CanRewardQuest },
-    { "CanCompleteRepeatableQuest", &LuaPlayer::CanCompleteRepeatableQuest },
-    { "CanCompleteQuest", &LuaPlayer::CanCompleteQuest },
-    { "CanEquipItem", &LuaPlayer::CanEquipItem },
-    { "IsFalling", &LuaPlayer::IsFalling },
-    { "ToggleAFK", &LuaPlayer::ToggleAFK },
-    { "ToggleDND", &LuaPlayer::ToggleDND },
-    { "IsAFK", &LuaPlayer::IsAFK },
-    { "IsDND", &LuaPlayer::IsDND },
-    { "IsAcceptingWhispers", &LuaPlayer::IsAcceptingWhispers },
-    { "IsGMChat", &LuaPlayer::IsGMChat },
-    { "IsTaxiCheater", &LuaPlayer::IsTaxiCheater },
-    { "IsGMVisible", &LuaPlayer::IsGMVisible },
-    { "HasQuest", &LuaPlayer::HasQuest },
-    { "InBattlegroundQueue", &LuaPlayer::InBattlegroundQueue },
+    { "HasTankSpec", &ElunaMethod<&LuaPlayer::HasTankSpec>::Call },
+    { "HasMeleeSpec", &ElunaMethod<&LuaPlayer::HasMeleeSpec>::Call },
+    { "HasCasterSpec", &ElunaMethod<&LuaPlayer::HasCasterSpec>::Call },
+    { "HasHealSpec", &ElunaMethod<&LuaPlayer::HasHealSpec>::Call },
+    { "IsInGroup", &ElunaMethod<&LuaPlayer::IsInGroup>::Call },
+    { "IsInGuild", &ElunaMethod<&LuaPlayer::IsInGuild>::Call },
+    { "IsGM", &ElunaMethod<&LuaPlayer::IsGM>::Call },
+    { "IsImmuneToDamage", &ElunaMethod<&LuaPlayer::IsImmuneToDamage>::Call },
+    { "IsAlliance", &ElunaMethod<&LuaPlayer::IsAlliance>::Call },
+    { "IsHorde", &ElunaMethod<&LuaPlayer::IsHorde>::Call },
+    { "HasTitle", &ElunaMethod<&LuaPlayer::HasTitle>::Call },
+    { "HasItem", &ElunaMethod<&LuaPlayer::HasItem>::Call },
+    { "Teleport", &ElunaMethod<&LuaPlayer::Teleport>::Call },
+    { "AddItem", &ElunaMethod<&LuaPlayer::AddItem>::Call },
+    { "IsInArenaTeam", &ElunaMethod<&LuaPlayer::IsInArenaTeam>::Call },
+    { "CanRewardQuest", &ElunaMethod<&LuaPlayer::CanRewardQuest>::Call },
+    { "CanCompleteRepeatableQuest", &ElunaMethod<&LuaPlayer::CanCompleteRepeatableQuest>::Call },
+    { "CanCompleteQuest", &ElunaMethod<&LuaPlayer::CanCompleteQuest>::Call },
+    { "CanEquipItem", &ElunaMethod<&LuaPlayer::CanEquipItem>::Call },
+    { "IsFalling", &ElunaMethod<&LuaPlayer::IsFalling>::Call },
+    { "ToggleAFK", &ElunaMethod<&LuaPlayer::ToggleAFK>::Call },
+    { "ToggleDND", &ElunaMethod<&LuaPlayer::ToggleDND>::Call },
+    { "IsAFK", &ElunaMethod<&LuaPlayer::IsAFK>::Call },
+    { "IsDND", &ElunaMethod<&LuaPlayer::IsDND>::Call },
+    { "IsAcceptingWhispers", &ElunaMethod<&LuaPlayer::IsAcceptingWhispers>::Call },
+    { "IsGMChat", &ElunaMethod<&LuaPlayer::IsGMChat>::Call },
+    { "IsTaxiCheater", &ElunaMethod<&LuaPlayer::IsTaxiCheater>::Call },
+    { "IsGMVisible", &ElunaMethod<&LuaPlayer::IsGMVisible>::Call },
+    { "HasQuest", &ElunaMethod<&LuaPlayer::HasQuest>::Call },
+    { "InBattlegroundQueue", &ElunaMethod<&LuaPlayer::InBattlegroundQueue>::Call },
     // {"IsImmuneToEnvironmentalDamage", &LuaPlayer::IsImmuneToEnvironmentalDamage},        // :IsImmuneToEnvironmentalDamage() - UNDOCUMENTED - Returns true if the player is immune to environmental damage
-    { "CanSpeak", &LuaPlayer::CanSpeak },
-    { "HasAtLoginFlag", &LuaPlayer::HasAtLoginFlag },
+    { "CanSpeak", &ElunaMethod<&LuaPlayer::CanSpeak>::Call },
+    { "HasAtLoginFlag", &ElunaMethod<&LuaPlayer::HasAtLoginFlag>::Call },
     // {"InRandomLfgDungeon", &LuaPlayer::InRandomLfgDungeon},                              // :InRandomLfgDungeon() - UNDOCUMENTED - Returns true if the player is in a random LFG dungeon
     // {"HasPendingBind", &LuaPlayer::HasPendingBind},                                      // :HasPendingBind() - UNDOCUMENTED - Returns true if the player has a pending instance bind
-    { "HasAchieved", &LuaPlayer::HasAchieved },
-    { "GetAchievementCriteriaProgress", &LuaPlayer::GetAchievementCriteriaProgress },
-    { "SetAchievement", &LuaPlayer::SetAchievement },
-    { "CanUninviteFromGroup", &LuaPlayer::CanUninviteFromGroup },
-    { "IsRested", &LuaPlayer::IsRested },
+    { "HasAchieved", &ElunaMethod<&LuaPlayer::HasAchieved>::Call },
+    { "GetAchievementCriteriaProgress", &ElunaMethod<&LuaPlayer::GetAchievementCriteriaProgress>::Call },
+    { "SetAchievement", &ElunaMethod<&LuaPlayer::SetAchievement>::Call },
+    { "CanUninviteFromGroup", &ElunaMethod<&LuaPlayer::CanUninviteFromGroup>::Call },
+    { "IsRested", &ElunaMethod<&LuaPlayer::IsRested>::Call },
     // {"CanFlyInZone", &LuaPlayer::CanFlyInZone},                                          // :CanFlyInZone(mapid, zone) - UNDOCUMENTED - Returns true if the player can fly in the area
     // {"IsNeverVisible", &LuaPlayer::IsNeverVisible},                                      // :IsNeverVisible() - UNDOCUMENTED - Returns true if the player is never visible
-    { "IsVisibleForPlayer", &LuaPlayer::IsVisibleForPlayer },
+    { "IsVisibleForPlayer", &ElunaMethod<&LuaPlayer::IsVisibleForPlayer>::Call },
     // {"IsUsingLfg", &LuaPlayer::IsUsingLfg},                                              // :IsUsingLfg() - UNDOCUMENTED - Returns true if the player is using LFG
-    { "HasQuestForItem", &LuaPlayer::HasQuestForItem },
-    { "HasQuestForGO", &LuaPlayer::HasQuestForGO },
-    { "CanShareQuest", &LuaPlayer::CanShareQuest },
+    { "HasQuestForItem", &ElunaMethod<&LuaPlayer::HasQuestForItem>::Call },
+    { "HasQuestForGO", &ElunaMethod<&LuaPlayer::HasQuestForGO>::Call },
+    { "CanShareQuest", &ElunaMethod<&LuaPlayer::CanShareQuest>::Call },
     // {"HasReceivedQuestReward", &LuaPlayer::HasReceivedQuestReward},                      // :HasReceivedQuestReward(entry) - UNDOCUMENTED - Returns true if the player has recieved the quest's reward
-    { "HasTalent", &LuaPlayer::HasTalent },
-    { "IsInSameGroupWith", &LuaPlayer::IsInSameGroupWith },
-    { "IsInSameRaidWith", &LuaPlayer::IsInSameRaidWith },
-    { "IsGroupVisibleFor", &LuaPlayer::IsGroupVisibleFor },
-    { "HasSkill", &LuaPlayer::HasSkill },
-    { "IsHonorOrXPTarget", &LuaPlayer::IsHonorOrXPTarget },
-    { "CanParry", &LuaPlayer::CanParry },
-    { "CanBlock", &LuaPlayer::CanBlock },
-    { "CanTitanGrip", &LuaPlayer::CanTitanGrip },
-    { "InBattleground", &LuaPlayer::InBattleground },
-    { "InArena", &LuaPlayer::InArena },
+    { "HasTalent", &ElunaMethod<&LuaPlayer::HasTalent>::Call },
+    { "IsInSameGroupWith", &ElunaMethod<&LuaPlayer::IsInSameGroupWith>::Call },
+    { "IsInSameRaidWith", &ElunaMethod<&LuaPlayer::IsInSameRaidWith>::Call },
+    { "IsGroupVisibleFor", &ElunaMethod<&LuaPlayer::IsGroupVisibleFor>::Call },
+    { "HasSkill", &ElunaMethod<&LuaPlayer::HasSkill>::Call },
+    { "IsHonorOrXPTarget", &ElunaMethod<&LuaPlayer::IsHonorOrXPTarget>::Call },
+    { "CanParry", &ElunaMethod<&LuaPlayer::CanParry>::Call },
+    { "CanBlock", &ElunaMethod<&LuaPlayer::CanBlock>::Call },
+    { "CanTitanGrip", &ElunaMethod<&LuaPlayer::CanTitanGrip>::Call },
+    { "InBattleground", &ElunaMethod<&LuaPlayer::InBattleground>::Call },
+    { "InArena", &ElunaMethod<&LuaPlayer::InArena>::Call },
     // {"IsOutdoorPvPActive", &LuaPlayer::IsOutdoorPvPActive},                              // :IsOutdoorPvPActive() - UNDOCUMENTED - Returns true if the player is outdoor pvp active
     // {"IsARecruiter", &LuaPlayer::IsARecruiter},                                          // :IsARecruiter() - UNDOCUMENTED - Returns true if the player is a recruiter
-    { "CanUseItem", &LuaPlayer::CanUseItem },
-    { "HasSpell", &LuaPlayer::HasSpell },
-    { "HasSpellCooldown", &LuaPlayer::HasSpellCooldown },
-    { "IsInWater", &LuaPlayer::IsInWater },
-    { "CanFly", &LuaPlayer::CanFly },
-    { "IsMoving", &LuaPlayer::IsMoving },
-    { "IsFlying", &LuaPlayer::IsFlying },
+    { "CanUseItem", &ElunaMethod<&LuaPlayer::CanUseItem>::Call },
+    { "HasSpell", &ElunaMethod<&LuaPlayer::HasSpell>::Call },
+    { "HasSpellCooldown", &ElunaMethod<&LuaPlayer::HasSpellCooldown>::Call },
+    { "IsInWater", &ElunaMethod<&LuaPlayer::IsInWater>::Call },
+    { "CanFly", &ElunaMethod<&LuaPlayer::CanFly>::Call },
+    { "IsMoving", &ElunaMethod<&LuaPlayer::IsMoving>::Call },
+    { "IsFlying", &ElunaMethod<&LuaPlayer::IsFlying>::Call },
 
     // Gossip
-    { "GossipMenuAddItem", &LuaPlayer::GossipMenuAddItem },
-    { "GossipSendMenu", &LuaPlayer::GossipSendMenu },
-    { "GossipComplete", &LuaPlayer::GossipComplete },
-    { "GossipClearMenu", &LuaPlayer::GossipClearMenu },
+    { "GossipMenuAddItem", &ElunaMethod<&LuaPlayer::GossipMenuAddItem>::Call },
+    { "GossipSendMenu", &ElunaMethod<&LuaPlayer::GossipSendMenu>::Call },
+    { "GossipComplete", &ElunaMethod<&LuaPlayer::GossipComplete>::Call },
+    { "GossipClearMenu", &ElunaMethod<&LuaPlayer::GossipClearMenu>::Call },
 
     // Other
-    { "SendBroadcastMessage", &LuaPlayer::SendBroadcastMessage },
-    { "SendAreaTriggerMessage", &LuaPlayer::SendAreaTriggerMessage },
-    { "SendNotification", &LuaPlayer::SendNotification },
-    { "SendPacket", &LuaPlayer::SendPacket },
-    { "SendAddonMessage", &LuaPlayer::SendAddonMessage },
-    { "ModifyMoney", &LuaPlayer::ModifyMoney },
-    { "LearnSpell", &LuaPlayer::LearnSpell },
-    { "LearnTalent", &LuaPlayer::LearnTalent },
-
-    { "RunCommand", &LuaPlayer::RunCommand },
-    { "SetGlyph", &LuaPlayer::SetGlyph },
-    { "GetGlyph", &LuaPlayer::GetGlyph },
-    { "RemoveArenaSpellCooldowns", &LuaPlayer::RemoveArenaSpellCooldowns },
-    { "RemoveItem", &LuaPlayer::RemoveItem },
-    { "RemoveLifetimeKills", &LuaPlayer::RemoveLifetimeKills },
-    { "ResurrectPlayer", &LuaPlayer::ResurrectPlayer },
-    { "EquipItem", &LuaPlayer::EquipItem },
-    { "ResetSpellCooldown", &LuaPlayer::ResetSpellCooldown },
-    { "ResetTypeCooldowns", &LuaPlayer::ResetTypeCooldowns },
-    { "ResetAllCooldowns", &LuaPlayer::ResetAllCooldowns },
-    { "GiveXP", &LuaPlayer::GiveXP },                                                       // :GiveXP(xp[, victim, pureXP, triggerHook]) - UNDOCUMENTED - Gives XP to the player. If pure is false, bonuses are count in. If triggerHook is false, GiveXp hook is not triggered.
+    { "SendBroadcastMessage", &ElunaMethod<&LuaPlayer::SendBroadcastMessage>::Call },
+    { "SendAreaTriggerMessage", &ElunaMethod<&LuaPlayer::SendAreaTriggerMessage>::Call },
+    { "SendNotification", &ElunaMethod<&LuaPlayer::SendNotification>::Call },
+    { "SendPacket", &ElunaMethod<&LuaPlayer::SendPacket>::Call },
+    { "SendAddonMessage", &ElunaMethod<&LuaPlayer::SendAddonMessage>::Call },
+    { "ModifyMoney", &ElunaMethod<&LuaPlayer::ModifyMoney>::Call },
+    { "LearnSpell", &ElunaMethod<&LuaPlayer::LearnSpell>::Call },
+    { "LearnTalent", &ElunaMethod<&LuaPlayer::LearnTalent>::Call },
+
+    { "RunCommand", &ElunaMethod<&LuaPlayer::RunCommand>::Call },
+    { "SetGlyph", &ElunaMethod<&LuaPlayer::SetGlyph>::Call },
+    { "GetGlyph", &ElunaMethod<&LuaPlayer::GetGlyph>::Call },
+    { "RemoveArenaSpellCooldowns", &ElunaMethod<&LuaPlayer::RemoveArenaSpellCooldowns>::Call },
+    { "RemoveItem", &ElunaMethod<&LuaPlayer::RemoveItem>::Call },
+    { "RemoveLifetimeKills", &ElunaMethod<&LuaPlayer::RemoveLifetimeKills>::Call },
+    { "ResurrectPlayer", &ElunaMethod<&LuaPlayer::ResurrectPlayer>::Call },
+    { "EquipItem", &ElunaMethod<&LuaPlayer::EquipItem>::Call },
+    { "ResetSpellCooldown", &ElunaMethod<&LuaPlayer::ResetSpellCooldown>::Call },
+    { "ResetTypeCooldowns", &ElunaMethod<&LuaPlayer::ResetTypeCooldowns>::Call },
+    { "ResetAllCooldowns", &ElunaMethod<&LuaPlayer::ResetAllCooldowns>::Call },
+    { "GiveXP", &ElunaMethod<&LuaPlayer::GiveXP>::Call },                                                       // :GiveXP(xp[, victim, pureXP, triggerHook]) - UNDOCUMENTED - Gives XP to the player. If pure is false, bonuses are count in. If triggerHook is false, GiveXp hook is not triggered.
     // {"RemovePet", &LuaPlayer::RemovePet},                                                // :RemovePet([mode, returnreagent]) - UNDOCUMENTED - Removes the player's pet. Mode determines if the pet is saved and how
     // {"SummonPet", &LuaPlayer::SummonPet},                                              // :SummonPet(entry, x, y, z, o, petType, despwtime) - Summons a pet for the player
-    { "Say", &LuaPlayer::Say },
-    { "Yell", &LuaPlayer::Yell },
-    { "TextEmote", &LuaPlayer::TextEmote },
-    { "Whisper", &LuaPlayer::Whisper },
-    { "CompleteQuest", &LuaPlayer::CompleteQuest },
-    { "IncompleteQuest", &LuaPlayer::IncompleteQuest },
-    { "FailQuest", &LuaPlayer::FailQuest },
-    { "AddQuest", &LuaPlayer::AddQuest },
-    { "RemoveQuest", &LuaPlayer::RemoveQuest },
+    { "Say", &ElunaMethod<&LuaPlayer::Say>::Call },
+    { "Yell", &ElunaMethod<&LuaPlayer::Yell>::Call },
+    { "TextEmote", &ElunaMethod<&LuaPlayer::TextEmote>::Call },
+    { "Whisper", &ElunaMethod<&LuaPlayer::Whisper>::Call },
+    { "CompleteQuest", &ElunaMethod<&LuaPlayer::CompleteQuest>::Call },
+    { "IncompleteQuest", &ElunaMethod<&LuaPlayer::IncompleteQuest>::Call },
+    { "FailQuest", &ElunaMethod<&LuaPlayer::FailQuest>::Call },
+    { "AddQuest", &ElunaMethod<&LuaPlayer::AddQuest>::Call },
+    { "RemoveQuest", &ElunaMethod<&LuaPlayer::RemoveQuest>::Call },
     // {"RemoveActiveQuest", &LuaPlayer::RemoveActiveQuest},                                // :RemoveActiveQuest(entry) - UNDOCUMENTED - Removes an active quest
     // {"RemoveRewardedQuest", &LuaPlayer::RemoveRewardedQuest},                            // :RemoveRewardedQuest(entry) - UNDOCUMENTED - Removes a rewarded quest
-    { "AreaExploredOrEventHappens", &LuaPlayer::AreaExploredOrEventHappens },
-    { "GroupEventHappens", &LuaPlayer::GroupEventHappens },
-    { "KilledMonsterCredit", &LuaPlayer::KilledMonsterCredit },
+    { "AreaExploredOrEventHappens", &ElunaMethod<&LuaPlayer::AreaExploredOrEventHappens>::Call },
+    { "GroupEventHappens", &ElunaMethod<&LuaPlayer::GroupEventHappens>::Call },
+    { "KilledMonsterCredit", &ElunaMethod<&LuaPlayer::KilledMonsterCredit>::Call },
     // {"KilledPlayerCredit", &LuaPlayer::KilledPlayerCredit},                              // :KilledPlayerCredit() - UNDOCUMENTED - Satisfies a player kill for the player
     // {"KillGOCredit", &LuaPlayer::KillGOCredit},                                          // :KillGOCredit(GOEntry[, GUID]) - UNDOCUMENTED - Credits the player for destroying a GO, guid is optional
-    { "TalkedToCreature", &LuaPlayer::TalkedToCreature },
-    { "ResetPetTalents", &LuaPlayer::ResetPetTalents },
-    { "AddComboPoints", &LuaPlayer::AddComboPoints },
+    { "TalkedToCreature", &ElunaMethod<&LuaPlayer::TalkedToCreature>::Call },
+    { "ResetPetTalents", &ElunaMethod<&LuaPlayer::ResetPetTalents>::Call },
+    { "AddComboPoints", &ElunaMethod<&LuaPlayer::AddComboPoints>::Call },
     // {"GainSpellComboPoints", &LuaPlayer::GainSpellComboPoints},                          // :GainSpellComboPoints(amount) - UNDOCUMENTED - Player gains spell combo points
-    { "ClearComboPoints", &LuaPlayer::ClearComboPoints },
-    { "RemoveSpell", &LuaPlayer::RemoveSpell },
-    { "ResetTalents", &LuaPlayer::ResetTalents },
-    { "ResetTalentsCost", &LuaPlayer::ResetTalentsCost },
+    { "ClearComboPoints", &ElunaMethod<&LuaPlayer::ClearComboPoints>::Call },
+    { "RemoveSpell", &ElunaMethod<&LuaPlayer::RemoveSpell>::Call },
+    { "ResetTalents", &ElunaMethod<&LuaPlayer::ResetTalents>::Call },
+    { "ResetTalentsCost", &ElunaMethod<&LuaPlayer::ResetTalentsCost>::Call },
     // {"AddTalent", &LuaPlayer::AddTalent},                                                // :AddTalent(spellid, spec, learning) - UNDOCUMENTED - Adds a talent spell for the player to given spec
-    { "RemoveFromGroup", &LuaPlayer::RemoveFromGroup },
-    { "KillPlayer", &LuaPlayer::KillPlayer },
-    { "DurabilityLossAll", &LuaPlayer::DurabilityLossAll },
-    { "DurabilityLoss", &LuaPlayer::DurabilityLoss },
-    { "DurabilityPointsLoss", &LuaPlayer::DurabilityPointsLoss },
-    { "DurabilityPointsLossAll", &LuaPlayer::DurabilityPointsLossAll },
-    { "DurabilityPointLossForEquipSlot", &LuaPlayer::DurabilityPointLossForEquipSlot },
-    { "DurabilityRepairAll", &LuaPlayer::DurabilityRepairAll },
-    { "DurabilityRepair", &LuaPlayer::DurabilityRepair },
-    { "ModifyHonorPoints", &LuaPlayer::ModifyHonorPoints },
-    { "ModifyArenaPoints", &LuaPlayer::ModifyArenaPoints },
-    { "LeaveBattleground", &LuaPlayer::LeaveBattleground },
+    { "RemoveFromGroup", &ElunaMethod<&LuaPlayer::RemoveFromGroup>::Call },
+    { "KillPlayer", &ElunaMethod<&LuaPlayer::KillPlayer>::Call },
+    { "DurabilityLossAll", &ElunaMethod<&LuaPlayer::DurabilityLossAll>::Call },
+    { "DurabilityLoss", &ElunaMethod<&LuaPlayer::DurabilityLoss>::Call },
+    { "DurabilityPointsLoss", &ElunaMethod<&LuaPlayer::DurabilityPointsLoss>::Call },
+    { "DurabilityPointsLossAll", &ElunaMethod<&LuaPlayer::DurabilityPointsLossAll>::Call },
+    { "DurabilityPointLossForEquipSlot", &ElunaMethod<&LuaPlayer::DurabilityPointLossForEquipSlot>::Call },
+    { "DurabilityRepairAll", &ElunaMethod<&LuaPlayer::DurabilityRepairAll>::Call },
+    { "DurabilityRepair", &ElunaMethod<&LuaPlayer::DurabilityRepair>::Call },
+    { "ModifyHonorPoints", &ElunaMethod<&LuaPlayer::ModifyHonorPoints>::Call },
+    { "ModifyArenaPoints", &ElunaMethod<&LuaPlayer::ModifyArenaPoints>::Call },
+    { "LeaveBattleground", &ElunaMethod<&LuaPlayer::LeaveBattleground>::Call },
     // {"BindToInstance", &LuaPlayer::BindToInstance},                                      // :BindToInstance() - UNDOCUMENTED - Binds the player to the current instance
-    { "UnbindInstance", &LuaPlayer::UnbindInstance },
-    { "UnbindAllInstances", &LuaPlayer::UnbindAllInstances },
-    { "RemoveFromBattlegroundRaid", &LuaPlayer::RemoveFromBattlegroundRaid },
-    { "ResetAchievements", &LuaPlayer::ResetAchievements },
-    { "KickPlayer", &LuaPlayer::KickPlayer },
-    { "LogoutPlayer", &LuaPlayer::LogoutPlayer },
-    { "SendTrainerList", &LuaPlayer::SendTrainerList },
-    { "SendListInventory", &LuaPlayer::SendListInventory },
-    { "SendShowBank", &LuaPlayer::SendShowBank },
-    { "SendTabardVendorActivate", &LuaPlayer::SendTabardVendorActivate },
-    { "SendSpiritResurrect", &LuaPlayer::SendSpiritResurrect },
-    { "SendTaxiMenu", &LuaPlayer::SendTaxiMenu },
-    { "SendUpdateWorldState", &LuaPlayer::SendUpdateWorldState },
-    { "RewardQuest", &LuaPlayer::RewardQuest },
-    { "SendAuctionMenu", &LuaPlayer::SendAuctionMenu },
-    { "SendShowMailBox", &LuaPlayer::SendShowMailBox },
-    { "StartTaxi", &LuaPlayer::StartTaxi },
-    { "GossipSendPOI", &LuaPlayer::GossipSendPOI },
-    { "GossipAddQuests", &LuaPlayer::GossipAddQuests },
-    { "SendQuestTemplate", &LuaPlayer::SendQuestTemplate },
-    { "SpawnBones", &LuaPlayer::SpawnBones },
-    { "RemovedInsignia", &LuaPlayer::RemovedInsignia },
-    { "SendGuildInvite", &LuaPlayer::SendGuildInvite },
-    { "Mute", &LuaPlayer::Mute },
-    { "SummonPlayer", &LuaPlayer::SummonPlayer },
-    { "SaveToDB", &LuaPlayer::SaveToDB },
-    { "GroupInvite", &LuaPlayer::GroupInvite },
-    { "GroupCreate", &LuaPlayer::GroupCreate },
-    { "SendCinematicStart", &LuaPlayer::SendCinematicStart },
-    { "SendMovieStart", &LuaPlayer::SendMovieStart },
-    { "UpdatePlayerSetting", &LuaPlayer::UpdatePlayerSetting },
-    { "TeleportTo", &LuaPlayer::TeleportTo },
+    { "UnbindInstance", &ElunaMethod<&LuaPlayer::UnbindInstance>::Call },
+    { "UnbindAllInstances", &ElunaMethod<&LuaPlayer::UnbindAllInstances>::Call },
+    { "RemoveFromBattlegroundRaid", &ElunaMethod<&LuaPlayer::RemoveFromBattlegroundRaid>::Call },
+    { "ResetAchievements", &ElunaMethod<&LuaPlayer::ResetAchievements>::Call },
+    { "KickPlayer", &ElunaMethod<&LuaPlayer::KickPlayer>::Call },
+    { "LogoutPlayer", &ElunaMethod<&LuaPlayer::LogoutPlayer>::Call },
+    { "SendTrainerList", &ElunaMethod<&LuaPlayer::SendTrainerList>::Call },
+    { "SendListInventory", &ElunaMethod<&LuaPlayer::SendListInventory>::Call },
+    { "SendShowBank", &ElunaMethod<&LuaPlayer::SendShowBank>::Call },
+    { "SendTabardVendorActivate", &ElunaMethod<&LuaPlayer::SendTabardVendorActivate>::Call },
+    { "SendSpiritResurrect", &ElunaMethod<&LuaPlayer::SendSpiritResurrect>::Call },
+    { "SendTaxiMenu", &ElunaMethod<&LuaPlayer::SendTaxiMenu>::Call },
+    { "SendUpdateWorldState", &ElunaMethod<&LuaPlayer::SendUpdateWorldState>::Call },
+    { "RewardQuest", &ElunaMethod<&LuaPlayer::RewardQuest>::Call },
+    { "SendAuctionMenu", &ElunaMethod<&LuaPlayer::SendAuctionMenu>::Call },
+    { "SendShowMailBox", &ElunaMethod<&LuaPlayer::SendShowMailBox>::Call },
+    { "StartTaxi", &ElunaMethod<&LuaPlayer::StartTaxi>::Call },
+    { "GossipSendPOI", &ElunaMethod<&LuaPlayer::GossipSendPOI>::Call },
+    { "GossipAddQuests", &ElunaMethod<&LuaPlayer::GossipAddQuests>::Call },
+    { "SendQuestTemplate", &ElunaMethod<&LuaPlayer::SendQuestTemplate>::Call },
+    { "SpawnBones", &ElunaMethod<&LuaPlayer::SpawnBones>::Call },
+    { "RemovedInsignia", &ElunaMethod<&LuaPlayer::RemovedInsignia>::Call },
+    { "SendGuildInvite", &ElunaMethod<&LuaPlayer::SendGuildInvite>::Call },
+    { "Mute", &ElunaMethod<&LuaPlayer::Mute>::Call },
+    { "SummonPlayer", &ElunaMethod<&LuaPlayer::SummonPlayer>::Call },
+    { "SaveToDB", &ElunaMethod<&LuaPlayer::SaveToDB>::Call },
+    { "GroupInvite", &ElunaMethod<&LuaPlayer::GroupInvite>::Call },
+    { "GroupCreate", &ElunaMethod<&LuaPlayer::GroupCreate>::Call },
+    { "SendCinematicStart", &ElunaMethod<&LuaPlayer::SendCinematicStart>::Call },
+    { "SendMovieStart", &ElunaMethod<&LuaPlayer::SendMovieStart>::Call },
+    { "UpdatePlayerSetting", &ElunaMethod<&LuaPlayer::UpdatePlayerSetting>::Call },
+    { "TeleportTo", &ElunaMethod<&LuaPlayer::TeleportTo>::Call },
 
     { NULL, NULL }
 };
@@ -761,100 +772,100 @@ ElunaRegister<Player> PlayerMethods[] =
 ElunaRegister<Creature> CreatureMethods[] =
 {
     // Getters
-    { "GetAITarget", &LuaCreature::GetAITarget },
-    { "GetAITargets", &LuaCreature::GetAITargets },
-    { "GetAITargetsCount", &LuaCreature::GetAITargetsCount },
-    { "GetHomePosition", &LuaCreature::GetHomePosition },
-    { "GetCorpseDelay", &LuaCreature::GetCorpseDelay },
-    { "GetCreatureSpellCooldownDelay", &LuaCreature::GetCreatureSpellCooldownDelay },
-    { "GetScriptId", &LuaCreature::GetScriptId },
-    { "GetAIName", &LuaCreature::GetAIName },
-    { "GetScriptName", &LuaCreature::GetScriptName },
-    { "GetAggroRange", &LuaCreature::GetAggroRange },
-    { "GetDefaultMovementType", &LuaCreature::GetDefaultMovementType },
-    { "GetRespawnDelay", &LuaCreature::GetRespawnDelay },
-    { "GetWanderRadius", &LuaCreature::GetWanderRadius },
-    { "GetCurrentWaypointId", &LuaCreature::GetCurrentWaypointId },
-    { "GetWaypointPath", &LuaCreature::GetWaypointPath },
-    { "GetLootMode", &LuaCreature::GetLootMode },
-    { "GetLootRecipient", &LuaCreature::GetLootRecipient },
-    { "GetLootRecipientGroup", &LuaCreature::GetLootRecipientGroup },
-    { "GetNPCFlags", &LuaCreature::GetNPCFlags },
-    { "GetUnitFlags", &LuaCreature::GetUnitFlags },
-    { "GetUnitFlagsTwo", &LuaCreature::GetUnitFlagsTwo },
-    { "GetExtraFlags", &LuaCreature::GetExtraFlags },
-    { "GetRank", &LuaCreature::GetRank },
-    { "GetShieldBlockValue", &LuaCreature::GetShieldBlockValue },
-    { "GetDBTableGUIDLow", &LuaCreature::GetDBTableGUIDLow },
-    { "GetCreatureFamily", &LuaCreature::GetCreatureFamily },
-    { "GetReactState", &LuaCreature::GetReactState },
+    { "GetAITarget", &ElunaMethod<&LuaCreature::GetAITarget>::Call },
+    { "GetAITargets", &ElunaMethod<&LuaCreature::GetAITargets>::Call },
+    { "GetAITargetsCount", &ElunaMethod<&LuaCreature::GetAITargetsCount>::Call },
+    { "GetHomePosition", &ElunaMethod<&LuaCreature::GetHomePosition>::Call },
+    { "GetCorpseDelay", &ElunaMethod<&LuaCreature::GetCorpseDelay>::Call },
+    { "GetCreatureSpellCooldownDelay", &ElunaMethod<&LuaCreature::GetCreatureSpellCooldownDelay>::Call },
+    { "GetScriptId", &ElunaMethod<&LuaCreature::GetScriptId>::Call },
+    { "GetAIName", &ElunaMethod<&LuaCreature::GetAIName>::Call },
+    { "GetScriptName", &ElunaMethod<&LuaCreature::GetScriptName>::Call },
+    { "GetAggroRange", &ElunaMethod<&LuaCreature::GetAggroRange>::Call },
+    { "GetDefaultMovementType", &ElunaMethod<&LuaCreature::GetDefaultMovementType>::Call },
+    { "GetRespawnDelay", &ElunaMethod<&LuaCreature::GetRespawnDelay>::Call },
+    { "GetWanderRadius", &ElunaMethod<&LuaCreature::GetWanderRadius>::Call },
+    { "GetCurrentWaypointId", &ElunaMethod<&LuaCreature::GetCurrentWaypointId>::Call },
+    { "GetWaypointPath", &ElunaMethod<&LuaCreature::GetWaypointPath>::Call },
+    { "GetLootMode", &ElunaMethod<&LuaCreature::GetLootMode>::Call },
+    { "GetLootRecipient", &ElunaMethod<&LuaCreature::GetLootRecipient>::Call },
+    { "GetLootRecipientGroup", &ElunaMethod<&LuaCreature::GetLootRecipientGroup>::Call },
+    { "GetNPCFlags", &ElunaMethod<&LuaCreature::GetNPCFlags>::Call },
+    { "GetUnitFlags", &ElunaMethod<&LuaCreature::GetUnitFlags>::Call },
+    { "GetUnitFlagsTwo", &ElunaMethod<&LuaCreature::GetUnitFlagsTwo>::Call },
+    { "GetExtraFlags", &ElunaMethod<&LuaCreature::GetExtraFlags>::Call },
+    { "GetRank", &ElunaMethod<&LuaCreature::GetRank>::Call },
+    { "GetShieldBlockValue", &ElunaMethod<&LuaCreature::GetShieldBlockValue>::Call },
+    { "GetDBTableGUIDLow", &ElunaMethod<&LuaCreature::GetDBTableGUIDLow>::Call },
+    { "GetCreatureFamily", &ElunaMethod<&LuaCreature::GetCreatureFamily>::Call },
+    { "GetReactState", &ElunaMethod<&LuaCreature::GetReactState>::Call },
 
     // Setters
-    { "SetRegeneratingHealth", &LuaCreature::SetRegeneratingHealth },
-    { "SetHover", &LuaCreature::SetHover },
-    { "SetDisableGravity", &LuaCreature::SetDisableGravity },
-    { "SetAggroEnabled", &LuaCreature::SetAggroEnabled },
-    { "SetNoCallAssistance", &LuaCreature::SetNoCallAssistance },
-    { "SetNoSearchAssistance", &LuaCreature::SetNoSearchAssistance },
-    { "SetDefaultMovementType", &LuaCreature::SetDefaultMovementType },
-    { "SetRespawnDelay", &LuaCreature::SetRespawnDelay },
-    { "SetWanderRadius", &LuaCreature::SetWanderRadius },
-    { "SetInCombatWithZone", &LuaCreature::SetInCombatWithZone },
-    { "SetDisableReputationGain", &LuaCreature::SetDisableReputationGain },
-    { "SetLootMode", &LuaCreature::SetLootMode },
-    { "SetNPCFlags", &LuaCreature::SetNPCFlags },
-    { "SetUnitFlags", &LuaCreature::SetUnitFlags },
-    { "SetUnitFlagsTwo", &LuaCreature::SetUnitFlagsTwo },
-    { "SetReactState", &LuaCreature::SetReactState },
-    { "SetDeathState", &LuaCreature::SetDeathState },
-    { "SetWalk", &LuaCreature::SetWalk },
-    { "SetHomePosition", &LuaCreature::SetHomePosition },
-    { "SetEquipmentSlots", &LuaCreature::SetEquipmentSlots },
+    { "SetRegeneratingHealth", &ElunaMethod<&LuaCreature::SetRegeneratingHealth>::Call },
+    { "SetHover", &ElunaMethod<&LuaCreature::SetHover>::Call },
+    { "SetDisableGravity", &ElunaMethod<&LuaCreature::SetDisableGravity>::Call },
+    { "SetAggroEnabled", &ElunaMethod<&LuaCreature::SetAggroEnabled>::Call },
+    { "SetNoCallAssistance", &ElunaMethod<&LuaCreature::SetNoCallAssistance>::Call },
+    { "SetNoSearchAssistance", &ElunaMethod<&LuaCreature::SetNoSearchAssistance>::Call },
+    { "SetDefaultMovementType", &ElunaMethod<&LuaCreature::SetDefaultMovementType>::Call },
+    { "SetRespawnDelay", &ElunaMethod<&LuaCreature::SetRespawnDelay>::Call },
+    { "SetWanderRadius", &ElunaMethod<&LuaCreature::SetWanderRadius>::Call },
+    { "SetInCombatWithZone", &ElunaMethod<&LuaCreature::SetInCombatWithZone>::Call },
+    { "SetDisableReputationGain", &ElunaMethod<&LuaCreature::SetDisableReputationGain>::Call },
+    { "SetLootMode", &ElunaMethod<&LuaCreature::SetLootMode>::Call },
+    { "SetNPCFlags", &ElunaMethod<&LuaCreature::SetNPCFlags>::Call },
+    { "SetUnitFlags", &ElunaMethod<&LuaCreature::SetUnitFlags>::Call },
+    { "SetUnitFlagsTwo", &ElunaMethod<&LuaCreature::SetUnitFlagsTwo>::Call },
+    { "SetReactState", &ElunaMethod<&LuaCreature::SetReactState>::Call },
+    { "SetDeathState", &ElunaMethod<&LuaCreature::SetDeathState>::Call },
+    { "SetWalk", &ElunaMethod<&LuaCreature::SetWalk>::Call },
+    { "SetHomePosition", &ElunaMethod<&LuaCreature::SetHomePosition>::Call },
+    { "SetEquipmentSlots", &ElunaMethod<&LuaCreature::SetEquipmentSlots>::Call },
 
     // Boolean
-    { "IsRegeneratingHealth", &LuaCreature::IsRegeneratingHealth },
-    { "IsDungeonBoss", &LuaCreature::IsDungeonBoss },
-    { "IsWorldBoss", &LuaCreature::IsWorldBoss },
-    { "IsRacialLeader", &LuaCreature::IsRacialLeader },
-    { "IsCivilian", &LuaCreature::IsCivilian },
-    { "IsTrigger", &LuaCreature::IsTrigger },
-    { "IsGuard", &LuaCreature::IsGuard },
-    { "IsElite", &LuaCreature::IsElite },
-    { "IsInEvadeMode", &LuaCreature::IsInEvadeMode },
-    { "HasCategoryCooldown", &LuaCreature::HasCategoryCooldown },
-    { "CanWalk", &LuaCreature::CanWalk },
-    { "CanSwim", &LuaCreature::CanSwim },
-    { "CanAggro", &LuaCreature::CanAggro },
-    { "CanStartAttack", &LuaCreature::CanStartAttack },
-    { "HasSearchedAssistance", &LuaCreature::HasSearchedAssistance },
-    { "IsTappedBy", &LuaCreature::IsTappedBy },
-    { "HasLootRecipient", &LuaCreature::HasLootRecipient },
-    { "CanAssistTo", &LuaCreature::CanAssistTo },
-    { "IsTargetableForAttack", &LuaCreature::IsTargetableForAttack },
-    { "CanCompleteQuest", &LuaCreature::CanCompleteQuest },
-    { "IsReputationGainDisabled", &LuaCreature::IsReputationGainDisabled },
-    { "IsDamageEnoughForLootingAndReward", &LuaCreature::IsDamageEnoughForLootingAndReward },
-    { "HasLootMode", &LuaCreature::HasLootMode },
-    { "HasSpell", &LuaCreature::HasSpell },
-    { "HasQuest", &LuaCreature::HasQuest },
-    { "HasSpellCooldown", &LuaCreature::HasSpellCooldown },
-    { "CanFly", &LuaCreature::CanFly },
+    { "IsRegeneratingHealth", &ElunaMethod<&LuaCreature::IsRegeneratingHealth>::Call },
+    { "IsDungeonBoss", &ElunaMethod<&LuaCreature::IsDungeonBoss>::Call },
+    { "IsWorldBoss", &ElunaMethod<&LuaCreature::IsWorldBoss>::Call },
+    { "IsRacialLeader", &ElunaMethod<&LuaCreature::IsRacialLeader>::Call },
+    { "IsCivilian", &ElunaMethod<&LuaCreature::IsCivilian>::Call },
+    { "IsTrigger", &ElunaMethod<&LuaCreature::IsTrigger>::Call },
+    { "IsGuard", &ElunaMethod<&LuaCreature::IsGuard>::Call },
+    { "IsElite", &ElunaMethod<&LuaCreature::IsElite>::Call },
+    { "IsInEvadeMode", &ElunaMethod<&LuaCreature::IsInEvadeMode>::Call },
+    { "HasCategoryCooldown", &ElunaMethod<&LuaCreature::HasCategoryCooldown>::Call },
+    { "CanWalk", &ElunaMethod<&LuaCreature::CanWalk>::Call },
+    { "CanSwim", &ElunaMethod<&LuaCreature::CanSwim>::Call },
+    { "CanAggro", &ElunaMethod<&LuaCreature::CanAggro>::Call },
+    { "CanStartAttack", &ElunaMethod<&LuaCreature::CanStartAttack>::Call },
+    { "HasSearchedAssistance", &ElunaMethod<&LuaCreature::HasSearchedAssistance>::Call },
+    { "IsTappedBy", &ElunaMethod<&LuaCreature::IsTappedBy>::Call },
+    { "HasLootRecipient", &ElunaMethod<&LuaCreature::HasLootRecipient>::Call },
+    { "CanAssistTo", &ElunaMethod<&LuaCreature::CanAssistTo>::Call },
+    { "IsTargetableForAttack", &ElunaMethod<&LuaCreature::IsTargetableForAttack>::Call },
+    { "CanCompleteQuest", &ElunaMethod<&LuaCreature::CanCompleteQuest>::Call },
+    { "IsReputationGainDisabled", &ElunaMethod<&LuaCreature::IsReputationGainDisabled>::Call },
+    { "IsDamageEnoughForLootingAndReward", &ElunaMethod<&LuaCreature::IsDamageEnoughForLootingAndReward>::Call },
+    { "HasLootMode", &ElunaMethod<&LuaCreature::HasLootMode>::Call },
+    { "HasSpell", &ElunaMethod<&LuaCreature::HasSpell>::Call },
+    { "HasQuest", &ElunaMethod<&LuaCreature::HasQuest>::Call },
+    { "HasSpellCooldown", &ElunaMethod<&LuaCreature::HasSpellCooldown>::Call },
+    { "CanFly", &ElunaMethod<&LuaCreature::CanFly>::Call },
 
     // Other
-    { "FleeToGetAssistance", &LuaCreature::FleeToGetAssistance },
-    { "CallForHelp", &LuaCreature::CallForHelp },
-    { "CallAssistance", &LuaCreature::CallAssistance },
-    { "RemoveCorpse", &LuaCreature::RemoveCorpse },
-    { "DespawnOrUnsummon", &LuaCreature::DespawnOrUnsummon },
-    { "Respawn", &LuaCreature::Respawn },
-    { "AttackStart", &LuaCreature::AttackStart },
-    { "AddLootMode", &LuaCreature::AddLootMode },
-    { "ResetLootMode", &LuaCreature::ResetLootMode },
-    { "RemoveLootMode", &LuaCreature::RemoveLootMode },
-    { "SaveToDB", &LuaCreature::SaveToDB },
-    { "SelectVictim", &LuaCreature::SelectVictim },
-    { "MoveWaypoint", &LuaCreature::MoveWaypoint },
-    { "UpdateEntry", &LuaCreature::UpdateEntry },
+    { "FleeToGetAssistance", &ElunaMethod<&LuaCreature::FleeToGetAssistance>::Call },
+    { "CallForHelp", &ElunaMethod<&LuaCreature::CallForHelp>::Call },
+    { "CallAssistance", &ElunaMethod<&LuaCreature::CallAssistance>::Call },
+    { "RemoveCorpse", &ElunaMethod<&LuaCreature::RemoveCorpse>::Call },
+    { "DespawnOrUnsummon", &ElunaMethod<&LuaCreature::DespawnOrUnsummon>::Call },
+    { "Respawn", &ElunaMethod<&LuaCreature::Respawn>::Call },
+    { "AttackStart", &ElunaMethod<&LuaCreature::AttackStart>::Call },
+    { "AddLootMode", &ElunaMethod<&LuaCreature::AddLootMode>::Call },
+    { "ResetLootMode", &ElunaMethod<&LuaCreature::ResetLootMode>::Call },
+    { "RemoveLootMode", &ElunaMethod<&LuaCreature::RemoveLootMode>::Call },
+    { "SaveToDB", &ElunaMethod<&LuaCreature::SaveToDB>::Call },
+    { "SelectVictim", &ElunaMethod<&LuaCreature::SelectVictim>::Call },
+    { "MoveWaypoint", &ElunaMethod<&LuaCreature::MoveWaypoint>::Call },
+    { "UpdateEntry", &ElunaMethod<&LuaCreature::UpdateEntry>::Call },
 
     { NULL, NULL }
 };
@@ -862,33 +873,33 @@ ElunaRegister<Creature> CreatureMethods[] =
 ElunaRegister<GameObject> GameObjectMethods[] =
 {
     // Getters
-    { "GetDisplayId", &LuaGameObject::GetDisplayId },
-    { "GetGoState", &LuaGameObject::GetGoState },
-    { "GetLootState", &LuaGameObject::GetLootState },
-    { "GetLootRecipient", &LuaGameObject::GetLootRecipient },
-    { "GetLootRecipientGroup", &LuaGameObject::GetLootRecipientGroup },
-    { "GetDBTableGUIDLow", &LuaGameObject::GetDBTableGUIDLow },
+    { "GetDisplayId", &ElunaMethod<&LuaGameObject::GetDisplayId>::Call },
+    { "GetGoState", &ElunaMethod<&LuaGameObject::GetGoState>::Call },
+    { "GetLootState", &ElunaMethod<&LuaGameObject::GetLootState>::Call },
+    { "GetLootRecipient", &ElunaMethod<&LuaGameObject::GetLootRecipient>::Call },
+    { "GetLootRecipientGroup", &ElunaMethod<&LuaGameObject::GetLootRecipientGroup>::Call },
+    { "GetDBTableGUIDLow", &ElunaMethod<&LuaGameObject::GetDBTableGUIDLow>::Call },
 
     // Setters
-    { "SetGoState", &LuaGameObject::SetGoState },
-    { "SetLootState", &LuaGameObject::SetLootState },
-    { "SetRespawnTime", &LuaGameObject::SetRespawnTime },
-    { "SetRespawnDelay", &LuaGameObject::SetRespawnDelay },
+    { "SetGoState", &ElunaMethod<&LuaGameObject::SetGoState>::Call },
+    { "SetLootState", &ElunaMethod<&LuaGameObject::SetLootState>::Call },
+    { "SetRespawnTime", &ElunaMethod<&LuaGameObject::SetRespawnTime>::Call },
+    { "SetRespawnDelay", &ElunaMethod<&LuaGameObject::SetRespawnDelay>::Call },
 
     // Boolean
-    { "IsTransport", &LuaGameObject::IsTransport },
+    { "IsTransport", &ElunaMethod<&LuaGameObject::IsTransport>::Call },
     // {"IsDestructible", &LuaGameObject::IsDestructible},    // :IsDestructible() - UNDOCUMENTED
-    { "IsActive", &LuaGameObject::IsActive },
-    { "HasQuest", &LuaGameObject::HasQuest },
-    { "IsSpawned", &LuaGameObject::IsSpawned },
+    { "IsActive", &ElunaMethod<&LuaGameObject::IsActive>::Call },
+    { "HasQuest", &ElunaMethod<&LuaGameObject::HasQuest>::Call },
+    { "IsSpawned", &ElunaMethod<&LuaGameObject::IsSpawned>::Call },
 
     // Other
-    { "RemoveFromWorld", &LuaGameObject::RemoveFromWorld },
-    { "UseDoorOrButton", &LuaGameObject::UseDoorOrButton },
-    { "Despawn", &LuaGameObject::Despawn },
-    { "Respawn", &LuaGameObject::Respawn },
-    { "SaveToDB", &LuaGameObject::SaveToDB },
-    { "AddLoot", &LuaGameObject::AddLoot },
+    { "RemoveFromWorld", &ElunaMethod<&LuaGameObject::RemoveFromWorld>::Call },
+    { "UseDoorOrButton", &ElunaMethod<&LuaGameObject::UseDoorOrButton>::Call },
+    { "Despawn", &ElunaMethod<&LuaGameObject::Despawn>::Call },
+    { "Respawn", &ElunaMethod<&LuaGameObject::Respawn>::Call },
+    { "SaveToDB", &ElunaMethod<&LuaGameObject::SaveToDB>::Call },
+    { "AddLoot", &ElunaMethod<&LuaGameObject::AddLoot>::Call },
 
     { NULL, NULL }
 };
@@ -896,113 +907,113 @@ ElunaRegister<GameObject> GameObjectMethods[] =
 ElunaRegister<Item> ItemMethods[] =
 {
     // Getters
-    { "GetOwnerGUID", &LuaItem::GetOwnerGUID },
-    { "GetOwner", &LuaItem::GetOwner },
-    { "GetCount", &LuaItem::GetCount },
-    { "GetMaxStackCount", &LuaItem::GetMaxStackCount },
-    { "GetSlot", &LuaItem::GetSlot },
-    { "GetBagSlot", &LuaItem::GetBagSlot },
-    { "GetEnchantmentId", &LuaItem::GetEnchantmentId },
-    { "GetSpellId", &LuaItem::GetSpellId },
-    { "GetSpellTrigger", &LuaItem::GetSpellTrigger },
-    { "GetItemLink", &LuaItem::GetItemLink },
-    { "GetClass", &LuaItem::GetClass },
-    { "GetSubClass", &LuaItem::GetSubClass },
-    { "GetName", &LuaItem::GetName },
-    { "GetDisplayId", &LuaItem::GetDisplayId },
-    { "GetQuality", &LuaItem::GetQuality },
-    { "GetBuyCount", &LuaItem::GetBuyCount },
-    { "GetBuyPrice", &LuaItem::GetBuyPrice },
-    { "GetSellPrice", &LuaItem::GetSellPrice },
-    { "GetInventoryType", &LuaItem::GetInventoryType },
-    { "GetAllowableClass", &LuaItem::GetAllowableClass },
-    { "GetAllowableRace", &LuaItem::GetAllowableRace },
-    { "GetItemLevel", &LuaItem::GetItemLevel },
-    { "GetRequiredLevel", &LuaItem::GetRequiredLevel },
-    { "GetStatsCount", &LuaItem::GetStatsCount },
-    { "GetRandomProperty", &LuaItem::GetRandomProperty },
-    { "GetRandomSuffix", &LuaItem::GetRandomSuffix },
-    { "GetItemSet", &LuaItem::GetItemSet },
-    { "GetBagSize", &LuaItem::GetBagSize },
-    { "GetItemTemplate", &LuaItem::GetItemTemplate },
+    { "GetOwnerGUID", &ElunaMethod<&LuaItem::GetOwnerGUID>::Call },
+    { "GetOwner", &ElunaMethod<&LuaItem::GetOwner>::Call },
+    { "GetCount", &ElunaMethod<&LuaItem::GetCount>::Call },
+    { "GetMaxStackCount", &ElunaMethod<&LuaItem::GetMaxStackCount>::Call },
+    { "GetSlot", &ElunaMethod<&LuaItem::GetSlot>::Call },
+    { "GetBagSlot", &ElunaMethod<&LuaItem::GetBagSlot>::Call },
+    { "GetEnchantmentId", &ElunaMethod<&LuaItem::GetEnchantmentId>::Call },
+    { "GetSpellId", &ElunaMethod<&LuaItem::GetSpellId>::Call },
+    { "GetSpellTrigger", &ElunaMethod<&LuaItem::GetSpellTrigger>::Call },
+    { "GetItemLink", &ElunaMethod<&LuaItem::GetItemLink>::Call },
+    { "GetClass", &ElunaMethod<&LuaItem::GetClass>::Call },
+    { "GetSubClass", &ElunaMethod<&LuaItem::GetSubClass>::Call },
+    { "GetName", &ElunaMethod<&LuaItem::GetName>::Call },
+    { "GetDisplayId", &ElunaMethod<&LuaItem::GetDisplayId>::Call },
+    { "GetQuality", &ElunaMethod<&LuaItem::GetQuality>::Call },
+    { "GetBuyCount", &ElunaMethod<&LuaItem::GetBuyCount>::Call },
+    { "GetBuyPrice", &ElunaMethod<&LuaItem::GetBuyPrice>::Call },
+    { "GetSellPrice", &ElunaMethod<&LuaItem::GetSellPrice>::Call },
+    { "GetInventoryType", &ElunaMethod<&LuaItem::GetInventoryType>::Call },
+    { "GetAllowableClass", &ElunaMethod<&LuaItem::GetAllowableClass>::Call },
+    { "GetAllowableRace", &ElunaMethod<&LuaItem::GetAllowableRace>::Call },
+    { "GetItemLevel", &ElunaMethod<&LuaItem::GetItemLevel>::Call },
+    { "GetRequiredLevel", &ElunaMethod<&LuaItem::GetRequiredLevel>::Call },
+    { "GetStatsCount", &ElunaMethod<&LuaItem::GetStatsCount>::Call },
+    { "GetRandomProperty", &ElunaMethod<&LuaItem::GetRandomProperty>::Call },
+    { "GetRandomSuffix", &ElunaMethod<&LuaItem::GetRandomSuffix>::Call },
+    { "GetItemSet", &ElunaMethod<&LuaItem::GetItemSet>::Call },
+    { "GetBagSize", &ElunaMethod<&LuaItem::GetBagSize>::Call },
+    { "GetItemTemplate", &ElunaMethod<&LuaItem::GetItemTemplate>::Call },
 
     // Setters
-    { "SetOwner", &LuaItem::SetOwner },
-    { "SetBinding", &LuaItem::SetBinding },
-    { "SetCount", &LuaItem::SetCount },
-    { "SetRandomProperty", &LuaItem::SetRandomProperty },
-    { "SetRandomSuffix", &LuaItem::SetRandomSuffix },
+    { "SetOwner", &ElunaMethod<&LuaItem::SetOwner>::Call },
+    { "SetBinding", &ElunaMethod<&LuaItem::SetBinding>::Call },
+    { "SetCount", &ElunaMethod<&LuaItem::SetCount>::Call },
+    { "SetRandomProperty", &ElunaMethod<&LuaItem::SetRandomProperty>::Call },
+    { "SetRandomSuffix", &ElunaMethod<&LuaItem::SetRandomSuffix>::Call },
 
     // Boolean
-    { "IsSoulBound", &LuaItem::IsSoulBound },
-    { "IsBoundAccountWide", &LuaItem::IsBoundAccountWide },
-    { "IsBoundByEnchant", &LuaItem::IsBoundByEnchant },
-    { "IsNotBoundToPlayer", &LuaItem::IsNotBoundToPlayer },
-    { "IsLocked", &LuaItem::IsLocked },
-    { "IsBag", &LuaItem::IsBag },
-    { "IsCurrencyToken", &LuaItem::IsCurrencyToken },
-    { "IsNotEmptyBag", &LuaItem::IsNotEmptyBag },
-    { "IsBroken", &LuaItem::IsBroken },
-    { "CanBeTraded", &LuaItem::CanBeTraded },
-    { "IsInTrade", &LuaItem::IsInTrade },
-    { "IsInBag", &LuaItem::IsInBag },
-    { "IsEquipped", &LuaItem::IsEquipped },
-    { "HasQuest", &LuaItem::HasQuest },
-    { "IsPotion", &LuaItem::IsPotion },
-    { "IsWeaponVellum", &LuaItem::IsWeaponVellum },
-    { "IsArmorVellum", &LuaItem::IsArmorVellum },
-    { "IsConjuredConsumable", &LuaItem::IsConjuredConsumable },
+    { "IsSoulBound", &ElunaMethod<&LuaItem::IsSoulBound>::Call },
+    { "IsBoundAccountWide", &ElunaMethod<&LuaItem::IsBoundAccountWide>::Call },
+    { "IsBoundByEnchant", &ElunaMethod<&LuaItem::IsBoundByEnchant>::Call },
+    { "IsNotBoundToPlayer", &ElunaMethod<&LuaItem::IsNotBoundToPlayer>::Call },
+    { "IsLocked", &ElunaMethod<&LuaItem::IsLocked>::Call },
+    { "IsBag", &ElunaMethod<&LuaItem::IsBag>::Call },
+    { "IsCurrencyToken", &ElunaMethod<&LuaItem::IsCurrencyToken>::Call },
+    { "IsNotEmptyBag", &ElunaMethod<&LuaItem::IsNotEmptyBag>::Call },
+    { "IsBroken", &ElunaMethod<&LuaItem::IsBroken>::Call },
+    { "CanBeTraded", &ElunaMethod<&LuaItem::CanBeTraded>::Call },
+    { "IsInTrade", &ElunaMethod<&LuaItem::IsInTrade>::Call },
+    { "IsInBag", &ElunaMethod<&LuaItem::IsInBag>::Call },
+    { "IsEquipped", &ElunaMethod<&LuaItem::IsEquipped>::Call },
+    { "HasQuest", &ElunaMethod<&LuaItem::HasQuest>::Call },
+    { "IsPotion", &ElunaMethod<&LuaItem::IsPotion>::Call },
+    { "IsWeaponVellum", &ElunaMethod<&LuaItem::IsWeaponVellum>::Call },
+    { "IsArmorVellum", &ElunaMethod<&LuaItem::IsArmorVellum>::Call },
+    { "IsConjuredConsumable", &ElunaMethod<&LuaItem::IsConjuredConsumable>::Call },
     //{"IsRefundExpired", &LuaItem::IsRefundExpired},               // :IsRefundExpired() - UNDOCUMENTED - Returns true if the item's refund time has expired
-    { "SetEnchantment", &LuaItem::SetEnchantment },
-    { "ClearEnchantment", &LuaItem::ClearEnchantment },
+    { "SetEnchantment", &ElunaMethod<&LuaItem::SetEnchantment>::Call },
+    { "ClearEnchantment", &ElunaMethod<&LuaItem::ClearEnchantment>::Call },
 
     // Other
-    { "SaveToDB", &LuaItem::SaveToDB },
+    { "SaveToDB", &ElunaMethod<&LuaItem::SaveToDB>::Call },
 
     { NULL, NULL }
 };
 
 ElunaRegister<ItemTemplate> ItemTemplateMethods[] =
 {
-    { "GetItemId", &LuaItemTemplate::GetItemId },
-    { "GetClass", &LuaItemTemplate::GetClass },
-    { "GetSubClass", &LuaItemTemplate::GetSubClass },
-    { "GetName", &LuaItemTemplate::GetName },
-    { "GetDisplayId", &LuaItemTemplate::GetDisplayId },
-    { "GetQuality", &LuaItemTemplate::GetQuality },
-    { "GetFlags", &LuaItemTemplate::GetFlags },
-    { "GetExtraFlags", &LuaItemTemplate::GetExtraFlags },
-    { "GetBuyCount", &LuaItemTemplate::GetBuyCount },
-    { "GetBuyPrice", &LuaItemTemplate::GetBuyPrice },
-    { "GetSellPrice", &LuaItemTemplate::GetSellPrice },
-    { "GetInventoryType", &LuaItemTemplate::GetInventoryType },
-    { "GetAllowableClass", &LuaItemTemplate::GetAllowableClass },
-    { "GetAllowableRace", &LuaItemTemplate::GetAllowableRace },
-    { "GetItemLevel", &LuaItemTemplate::GetItemLevel },
-    { "GetRequiredLevel", &LuaItemTemplate::GetRequiredLevel },
-    { "GetIcon", &LuaItemTemplate::GetIcon },
+    { "GetItemId", &ElunaMethod<&LuaItemTemplate::GetItemId>::Call },
+    { "GetClass", &ElunaMethod<&LuaItemTemplate::GetClass>::Call },
+    { "GetSubClass", &ElunaMethod<&LuaItemTemplate::GetSubClass>::Call },
+    { "GetName", &ElunaMethod<&LuaItemTemplate::GetName>::Call },
+    { "GetDisplayId", &ElunaMethod<&LuaItemTemplate::GetDisplayId>::Call },
+    { "GetQuality", &ElunaMethod<&LuaItemTemplate::GetQuality>::Call },
+    { "GetFlags", &ElunaMethod<&LuaItemTemplate::GetFlags>::Call },
+    { "GetExtraFlags", &ElunaMethod<&LuaItemTemplate::GetExtraFlags>::Call },
+    { "GetBuyCount", &ElunaMethod<&LuaItemTemplate::GetBuyCount>::Call },
+    { "GetBuyPrice", &ElunaMethod<&LuaItemTemplate::GetBuyPrice>::Call },
+    { "GetSellPrice", &ElunaMethod<&LuaItemTemplate::GetSellPrice>::Call },
+    { "GetInventoryType", &ElunaMethod<&LuaItemTemplate::GetInventoryType>::Call },
+    { "GetAllowableClass", &ElunaMethod<&LuaItemTemplate::GetAllowableClass>::Call },
+    { "GetAllowableRace", &ElunaMethod<&LuaItemTemplate::GetAllowableRace>::Call },
+    { "GetItemLevel", &ElunaMethod<&LuaItemTemplate::GetItemLevel>::Call },
+    { "GetRequiredLevel", &ElunaMethod<&LuaItemTemplate::GetRequiredLevel>::Call },
+    { "GetIcon", &ElunaMethod<&LuaItemTemplate::GetIcon>::Call },
     { NULL, NULL }
 };
 
 ElunaRegister<Aura> AuraMethods[] =
 {
     // Getters
-    { "GetCaster", &LuaAura::GetCaster },
-    { "GetCasterGUID", &LuaAura::GetCasterGUID },
-    { "GetCasterLevel", &LuaAura::GetCasterLevel },
-    { "GetDuration", &LuaAura::GetDuration },
-    { "GetMaxDuration", &LuaAura::GetMaxDuration },
-    { "GetAuraId", &LuaAura::GetAuraId },
-    { "GetStackAmount", &LuaAura::GetStackAmount },
-    { "GetOwner", &LuaAura::GetOwner },
+    { "GetCaster", &ElunaMethod<&LuaAura::GetCaster>::Call },
+    { "GetCasterGUID", &ElunaMethod<&LuaAura::GetCasterGUID>::Call },
+    { "GetCasterLevel", &ElunaMethod<&LuaAura::GetCasterLevel>::Call },
+    { "GetDuration", &ElunaMethod<&LuaAura::GetDuration>::Call },
+    { "GetMaxDuration", &ElunaMethod<&LuaAura::GetMaxDuration>::Call },
+    { "GetAuraId", &ElunaMethod<&LuaAura::GetAuraId>::Call },
+    { "GetStackAmount", &ElunaMethod<&LuaAura::GetStackAmount>::Call },
+    { "GetOwner", &ElunaMethod<&LuaAura::GetOwner>::Call },
 
     // Setters
-    { "SetDuration", &LuaAura::SetDuration },
-    { "SetMaxDuration", &LuaAura::SetMaxDuration },
-    { "SetStackAmount", &LuaAura::SetStackAmount },
+    { "SetDuration", &ElunaMethod<&LuaAura::SetDuration>::Call },
+    { "SetMaxDuration", &ElunaMethod<&LuaAura::SetMaxDuration>::Call },
+    { "SetStackAmount", &ElunaMethod<&LuaAura::SetStackAmount>::Call },
 
     // Other
-    { "Remove", &LuaAura::Remove },
+    { "Remove", &ElunaMethod<&LuaAura::Remove>::Call },
 
     { NULL, NULL }
 };
@@ -1010,25 +1021,25 @@ ElunaRegister<Aura> AuraMethods[] =
 ElunaRegister<Spell> SpellMethods[] =
 {
     // Getters
-    { "GetCaster", &LuaSpell::GetCaster },
-    { "GetCastTime", &LuaSpell::GetCastTime },
-    { "GetEntry", &LuaSpell::GetEntry },
-    { "GetDuration", &LuaSpell::GetDuration },
-    { "GetPowerCost", &LuaSpell::GetPowerCost },
-    { "GetReagentCost", &LuaSpell::GetReagentCost },
-    { "GetTargetDest", &LuaSpell::GetTargetDest },
-    { "GetTarget", &LuaSpell::GetTarget },
+    { "GetCaster", &ElunaMethod<&LuaSpell::GetCaster>::Call },
+    { "GetCastTime", &ElunaMethod<&LuaSpell::GetCastTime>::Call },
+    { "GetEntry", &ElunaMethod<&LuaSpell::GetEntry>::Call },
+    { "GetDuration", &ElunaMethod<&LuaSpell::GetDuration>::Call },
+    { "GetPowerCost", &ElunaMethod<&LuaSpell::GetPowerCost>::Call },
+    { "GetReagentCost", &ElunaMethod<&LuaSpell::GetReagentCost>::Call },
+    { "GetTargetDest", &ElunaMethod<&LuaSpell::GetTargetDest>::Call },
+    { "GetTarget", &ElunaMethod<&LuaSpell::GetTarget>::Call },
 
     // Setters
-    { "SetAutoRepeat", &LuaSpell::SetAutoRepeat },
+    { "SetAutoRepeat", &ElunaMethod<&LuaSpell::SetAutoRepeat>::Call },
 
     // Boolean
-    { "IsAutoRepeat", &LuaSpell::IsAutoRepeat },
+    { "IsAutoRepeat", &ElunaMethod<&LuaSpell::IsAutoRepeat>::Call },
 
     // Other
-    { "Cancel", &LuaSpell::Cancel },
-    { "Cast", &LuaSpell::Cast },
-    { "Finish", &LuaSpell::Finish },
+    { "Cancel", &ElunaMethod<&LuaSpell::Cancel>::Call },
+    { "Cast", &ElunaMethod<&LuaSpell::Cast>::Call },
+    { "Finish", &ElunaMethod<&LuaSpell::Finish>::Call },
 
     { NULL, NULL }
 };
@@ -1036,20 +1047,20 @@ ElunaRegister<Spell> SpellMethods[] =
 ElunaRegister<Quest> QuestMethods[] =
 {
     // Getters
-    { "GetId", &LuaQuest::GetId },
-    { "GetLevel", &LuaQuest::GetLevel },
+    { "GetId", &ElunaMethod<&LuaQuest::GetId>::Call },
+    { "GetLevel", &ElunaMethod<&LuaQuest::GetLevel>::Call },
     // {"GetMaxLevel", &LuaQuest::GetMaxLevel},                   // :GetMaxLevel() - UNDOCUMENTED - Returns the quest's max level
-    { "GetMinLevel", &LuaQuest::GetMinLevel },
-    { "GetNextQuestId", &LuaQuest::GetNextQuestId },
-    { "GetPrevQuestId", &LuaQuest::GetPrevQuestId },
-    { "GetNextQuestInChain", &LuaQuest::GetNextQuestInChain },
-    { "GetFlags", &LuaQuest::GetFlags },
-    { "GetType", &LuaQuest::GetType },
+    { "GetMinLevel", &ElunaMethod<&LuaQuest::GetMinLevel>::Call },
+    { "GetNextQuestId", &ElunaMethod<&LuaQuest::GetNextQuestId>::Call },
+    { "GetPrevQuestId", &ElunaMethod<&LuaQuest::GetPrevQuestId>::Call },
+    { "GetNextQuestInChain", &ElunaMethod<&LuaQuest::GetNextQuestInChain>::Call },
+    { "GetFlags", &ElunaMethod<&LuaQuest::GetFlags>::Call },
+    { "GetType", &ElunaMethod<&LuaQuest::GetType>::Call },
 
     // Boolean
-    { "HasFlag", &LuaQuest::HasFlag },
-    { "IsDaily", &LuaQuest::IsDaily },
-    { "IsRepeatable", &LuaQuest::IsRepeatable },
+    { "HasFlag", &ElunaMethod<&LuaQuest::HasFlag>::Call },
+    { "IsDaily", &ElunaMethod<&LuaQuest::IsDaily>::Call },
+    { "IsRepeatable", &ElunaMethod<&LuaQuest::IsRepeatable>::Call },
 
     { NULL, NULL }
 };
@@ -1057,39 +1068,39 @@ ElunaRegister<Quest> QuestMethods[] =
 ElunaRegister<Group> GroupMethods[] =
 {
     // Getters
-    { "GetMembers", &LuaGroup::GetMembers },
-    { "GetLeaderGUID", &LuaGroup::GetLeaderGUID },
-    { "GetGUID", &LuaGroup::GetGUID },
-    { "GetMemberGroup", &LuaGroup::GetMemberGroup },
-    { "GetMemberGUID", &LuaGroup::GetMemberGUID },
-    { "GetMembersCount", &LuaGroup::GetMembersCount },
-    { "GetGroupType", &LuaGroup::GetGroupType },
+    { "GetMembers", &ElunaMethod<&LuaGroup::GetMembers>::Call },
+    { "GetLeaderGUID", &ElunaMethod<&LuaGroup::GetLeaderGUID>::Call },
+    { "GetGUID", &ElunaMethod<&LuaGroup::GetGUID>::Call },
+    { "GetMemberGroup", &ElunaMethod<&LuaGroup::GetMemberGroup>::Call },
+    { "GetMemberGUID", &ElunaMethod<&LuaGroup::GetMemberGUID>::Call },
+    { "GetMembersCount", &ElunaMethod<&LuaGroup::GetMembersCount>::Call },
+    { "GetGroupType", &ElunaMethod<&LuaGroup::GetGroupType>::Call },
 
     // Setters
-    { "SetLeader", &LuaGroup::SetLeader },
-    { "SetMembersGroup", &LuaGroup::SetMembersGroup },
-    { "SetTargetIcon", &LuaGroup::SetTargetIcon },
-    { "SetMemberFlag", &LuaGroup::SetMemberFlag },
+    { "SetLeader", &ElunaMethod<&LuaGroup::SetLeader>::Call },
+    { "SetMembersGroup", &ElunaMethod<&LuaGroup::SetMembersGroup>::Call },
+    { "SetTargetIcon", &ElunaMethod<&LuaGroup::SetTargetIcon>::Call },
+    { "SetMemberFlag", &ElunaMethod<&LuaGroup::SetMemberFlag>::Call },
 
     // Boolean
-    { "IsLeader", &LuaGroup::IsLeader },
-    { "AddMember", &LuaGroup::AddMember },
-    { "RemoveMember", &LuaGroup::RemoveMember },
-    { "Disband", &LuaGroup::Disband },
-    { "IsFull", &LuaGroup::IsFull },
-    { "IsLFGGroup", &LuaGroup::IsLFGGroup },
-    { "IsRaidGroup", &LuaGroup::IsRaidGroup },
-    { "IsBGGroup", &LuaGroup::IsBGGroup },
+    { "IsLeader", &ElunaMethod<&LuaGroup::IsLeader>::Call },
+    { "AddMember", &ElunaMethod<&LuaGroup::AddMember>::Call },
+    { "RemoveMember", &ElunaMethod<&LuaGroup::RemoveMember>::Call },
+    { "Disband", &ElunaMethod<&LuaGroup::Disband>::Call },
+    { "IsFull", &ElunaMethod<&LuaGroup::IsFull>::Call },
+    { "IsLFGGroup", &ElunaMethod<&LuaGroup::IsLFGGroup>::Call },
+    { "IsRaidGroup", &ElunaMethod<&LuaGroup::IsRaidGroup>::Call },
+    { "IsBGGroup", &ElunaMethod<&LuaGroup::IsBGGroup>::Call },
     // {"IsBFGroup", &LuaGroup::IsBFGroup},                       // :IsBFGroup() - UNDOCUMENTED - Returns true if the group is a battlefield group
-    { "IsMember", &LuaGroup::IsMember },
-    { "IsAssistant", &LuaGroup::IsAssistant },
-    { "SameSubGroup", &LuaGroup::SameSubGroup },
-    { "HasFreeSlotSubGroup", &LuaGroup::HasFreeSlotSubGroup },
+    { "IsMember", &ElunaMethod<&LuaGroup::IsMember>::Call },
+    { "IsAssistant", &ElunaMethod<&LuaGroup::IsAssistant>::Call },
+    { "SameSubGroup", &ElunaMethod<&LuaGroup::SameSubGroup>::Call },
+    { "HasFreeSlotSubGroup", &ElunaMethod<&LuaGroup::HasFreeSlotSubGroup>::Call },
 
     // Other
-    { "SendPacket", &LuaGroup::SendPacket },
+    { "SendPacket", &ElunaMethod<&LuaGroup::SendPacket>::Call },
     // {"ConvertToLFG", &LuaGroup::ConvertToLFG},                 // :ConvertToLFG() - UNDOCUMENTED - Converts the group to an LFG group
-    { "ConvertToRaid", &LuaGroup::ConvertToRaid },
+    { "ConvertToRaid", &ElunaMethod<&LuaGroup::ConvertToRaid>::Call },
 
     { NULL, NULL }
 };
@@ -1097,36 +1108,36 @@ ElunaRegister<Group> GroupMethods[] =
 ElunaRegister<Guild> GuildMethods[] =
 {
     // Getters
-    { "GetMembers", &LuaGuild::GetMembers },
-    { "GetLeader", &LuaGuild::GetLeader },
-    { "GetLeaderGUID", &LuaGuild::GetLeaderGUID },
-    { "GetId", &LuaGuild::GetId },
-    { "GetName", &LuaGuild::GetName },
-    { "GetMOTD", &LuaGuild::GetMOTD },
-    { "GetInfo", &LuaGuild::GetInfo },
-    { "GetMemberCount", &LuaGuild::GetMemberCount },
-    { "GetCreatedDate", &LuaGuild::GetCreatedDate },
-    { "GetTotalBankMoney", &LuaGuild::GetTotalBankMoney },
+    { "GetMembers", &ElunaMethod<&LuaGuild::GetMembers>::Call },
+    { "GetLeader", &ElunaMethod<&LuaGuild::GetLeader>::Call },
+    { "GetLeaderGUID", &ElunaMethod<&LuaGuild::GetLeaderGUID>::Call },
+    { "GetId", &ElunaMethod<&LuaGuild::GetId>::Call },
+    { "GetName", &ElunaMethod<&LuaGuild::GetName>::Call },
+    { "GetMOTD", &ElunaMethod<&LuaGuild::GetMOTD>::Call },
+    { "GetInfo", &ElunaMethod<&LuaGuild::GetInfo>::Call },
+    { "GetMemberCount", &ElunaMethod<&LuaGuild::GetMemberCount>::Call },
+    { "GetCreatedDate", &ElunaMethod<&LuaGuild::GetCreatedDate>::Call },
+    { "GetTotalBankMoney", &ElunaMethod<&LuaGuild::GetTotalBankMoney>::Call },
 
     // Setters
-    { "SetBankTabText", &LuaGuild::SetBankTabText },
-    { "SetMemberRank", &LuaGuild::SetMemberRank },
-    { "SetLeader", &LuaGuild::SetLeader },
-    { "SetName", &LuaGuild::SetName },
+    { "SetBankTabText", &ElunaMethod<&LuaGuild::SetBankTabText>::Call },
+    { "SetMemberRank", &ElunaMethod<&LuaGuild::SetMemberRank>::Call },
+    { "SetLeader", &ElunaMethod<&LuaGuild::SetLeader>::Call },
+    { "SetName", &ElunaMethod<&LuaGuild::SetName>::Call },
 
     // Other
-    { "SendPacket", &LuaGuild::SendPacket },
-    { "SendPacketToRanked", &LuaGuild::SendPacketToRanked },
-    { "Disband", &LuaGuild::Disband },
-    { "AddMember", &LuaGuild::AddMember },
-    { "DeleteMember", &LuaGuild::DeleteMember },
-    { "SendMessage", &LuaGuild::SendMessage },
-    { "UpdateMemberData", &LuaGuild::UpdateMemberData },
-    { "MassInviteToEvent", &LuaGuild::MassInviteToEvent },
-    { "SwapItems", &LuaGuild::SwapItems },
-    { "SwapItemsWithInventory", &LuaGuild::SwapItemsWithInventory },
-    { "ResetTimes", &LuaGuild::ResetTimes },
-    { "ModifyBankMoney", &LuaGuild::ModifyBankMoney },
+    { "SendPacket", &ElunaMethod<&LuaGuild::SendPacket>::Call },
+    { "SendPacketToRanked", &ElunaMethod<&LuaGuild::SendPacketToRanked>::Call },
+    { "Disband", &ElunaMethod<&LuaGuild::Disband>::Call },
+    { "AddMember", &ElunaMethod<&LuaGuild::AddMember>::Call },
+    { "DeleteMember", &ElunaMethod<&LuaGuild::DeleteMember>::Call },
+    { "SendMessage", &ElunaMethod<&LuaGuild::SendMessage>::Call },
+    { "UpdateMemberData", &ElunaMethod<&LuaGuild::UpdateMemberData>::Call },
+    { "MassInviteToEvent", &ElunaMethod<&LuaGuild::MassInviteToEvent>::Call },
+    { "SwapItems", &ElunaMethod<&LuaGuild::SwapItems>::Call },
+    { "SwapItemsWithInventory", &ElunaMethod<&LuaGuild::SwapItemsWithInventory>::Call },
+    { "ResetTimes", &ElunaMethod<&LuaGuild::ResetTimes>::Call },
+    { "ModifyBankMoney", &ElunaMethod<&LuaGuild::ModifyBankMoney>::Call },
 
     { NULL, NULL }
 };
@@ -1134,16 +1145,16 @@ ElunaRegister<Guild> GuildMethods[] =
 ElunaRegister<Vehicle> VehicleMethods[] =
 {
     // Getters
-    { "GetOwner", &LuaVehicle::GetOwner },
-    { "GetEntry", &LuaVehicle::GetEntry },
-    { "GetPassenger", &LuaVehicle::GetPassenger },
+    { "GetOwner", &ElunaMethod<&LuaVehicle::GetOwner>::Call },
+    { "GetEntry", &ElunaMethod<&LuaVehicle::GetEntry>::Call },
+    { "GetPassenger", &ElunaMethod<&LuaVehicle::GetPassenger>::Call },
 
     // Boolean
-    { "IsOnBoard", &LuaVehicle::IsOnBoard },
+    { "IsOnBoard", &ElunaMethod<&LuaVehicle::IsOnBoard>::Call },
 
     // Other
-    { "AddPassenger", &LuaVehicle::AddPassenger },
-    { "RemovePassenger", &LuaVehicle::RemovePassenger },
+    { "AddPassenger", &ElunaMethod<&LuaVehicle::AddPassenger>::Call },
+    { "RemovePassenger", &ElunaMethod<&LuaVehicle::RemovePassenger>::Call },
 
     { NULL, NULL }
 };
@@ -1151,25 +1162,41 @@ ElunaRegister<Vehicle> VehicleMethods[] =
 ElunaRegister<ElunaQuery> QueryMethods[] =
 {
     // Getters
-    { "GetColumnCount", &LuaQuery::GetColumnCount },
-    { "GetRowCount", &LuaQuery::GetRowCount },
-    { "GetRow", &LuaQuery::GetRow },
-    { "GetBool", &LuaQuery::GetBool },
-    { "GetUInt8", &LuaQuery::GetUInt8 },
-    { "GetUInt16", &LuaQuery::GetUInt16 },
-    { "GetUInt32", &LuaQuery::GetUInt32 },
-    { "GetUInt64", &LuaQuery::GetUInt64 },
-    { "GetInt8", &LuaQuery::GetInt8 },
-    { "GetInt16", &LuaQuery::GetInt16 },
-    { "GetInt32", &LuaQuery::GetInt32 },
-    { "GetInt64", &LuaQuery::GetInt64 },
-    { "GetFloat", &LuaQuery::GetFloat },
-    { "GetDouble", &LuaQuery::GetDouble },
-    { "GetString", &LuaQuery::GetString },
+    { "GetColumnCount", &ElunaMethod<&LuaQuery::GetColumnCount>::Call },
+    { "GetRowCount", &ElunaMethod<&LuaQuery::GetRowCount>::Call },
+    { "GetRow", &ElunaMethod<&LuaQuery::GetRow>::Call },
+    { "GetBool", &ElunaMethod<&LuaQuery::GetBool>::Call },
+    { "GetUInt8", &ElunaMethod<&LuaQuery::GetUInt8>::Call },
+    { "GetUInt16", &ElunaMethod<&LuaQuery::GetUInt16>::Call },
+    { "GetUInt32", &ElunaMethod<&LuaQuery::GetUInt32>::Call },
+    { "GetUInt64", &ElunaMethod<&LuaQuery::GetUInt64>::Call },
+    { "GetInt8", &ElunaMethod<&LuaQuery::GetInt8>::Call },
+    { "GetInt16", &ElunaMethod<&LuaQuery::GetInt16>::Call },
+    { "GetInt32", &ElunaMethod<&LuaQuery::GetInt32>::Call },
+    { "GetInt64", &ElunaMethod<&LuaQuery::GetInt64>::Call },
+    { "GetFloat", &ElunaMethod<&LuaQuery::GetFloat>::Call },
+    { "GetDouble", &ElunaMethod<&LuaQuery::GetDouble>::Call },
+    { "GetString", &ElunaMethod<&LuaQuery::GetString>::Call },
 
     // Boolean
-    { "NextRow", &LuaQuery::NextRow },
-    { "IsNull", &LuaQuery::IsNull },
+    { "NextRow", &ElunaMethod<&LuaQuery::NextRow>::Call },
+    { "IsNull", &ElunaMethod<&LuaQuery::IsNull>::Call },
+
+    { NULL, NULL }
+};
+
+ElunaRegister<ElunaTextMatcher> TextMatcherMethods[] =
+{
+    // Getters
+    { "GetWordCount", &ElunaMethod<&LuaTextMatcher::GetWordCount>::Call },
+
+    // Boolean
+    { "IsCaseInsensitive", &ElunaMethod<&LuaTextMatcher::IsCaseInsensitive>::Call },
+
+    // Other
+    { "Test", &ElunaMethod<&LuaTextMatcher::Test>::Call },
+    { "Find", &ElunaMethod<&LuaTextMatcher::Find>::Call },
+    { "Censor", &ElunaMethod<&LuaTextMatcher::Censor>::Call },
 
     { NULL, NULL }
 };
@@ -1177,36 +1204,40 @@ ElunaRegister<ElunaQuery> QueryMethods[] =
 ElunaRegister<WorldPacket> PacketMethods[] =
 {
     // Getters
-    { "GetOpcode", &LuaPacket::GetOpcode },
-    { "GetSize", &LuaPacket::GetSize },
+    { "GetOpcode", &ElunaMethod<&LuaPacket::GetOpcode>::Call },
+    { "GetSize", &ElunaMethod<&LuaPacket::GetSize>::Call },
 
     // Setters
-    { "SetOpcode", &LuaPacket::SetOpcode },
+    { "SetOpcode", &ElunaMethod<&LuaPacket::SetOpcode>::Call },
 
     // Readers
-    { "ReadByte", &LuaPacket::ReadByte },
-    { "ReadUByte", &LuaPacket::ReadUByte },
-    { "ReadShort", &LuaPacket::ReadShort },
-    { "ReadUShort", &LuaPacket::ReadUShort },
-    { "ReadLong", &LuaPacket::ReadLong },
-    { "ReadULong", &LuaPacket::ReadULong },
-    { "ReadGUID", &LuaPacket::ReadGUID },
-    { "ReadPackedGUID", &LuaPacket::ReadPackedGUID },
-    { "ReadString", &LuaPacket::ReadString },
-    { "ReadFloat", &LuaPacket::ReadFloat },
-    { "ReadDouble", &LuaPacket::ReadDouble },
+    { "ReadByte", &ElunaMethod<&LuaPacket::ReadByte>::Call },
+    { "ReadUByte", &ElunaMethod<&LuaPacket::ReadUByte>::Call },
+    { "ReadShort", &ElunaMethod<&LuaPacket::ReadShort>::Call },
+    { "ReadUShort", &ElunaMethod<&LuaPacket::ReadUShort>::Call },
+    { "ReadLong", &ElunaMethod<&LuaPacket::ReadLong>::Call },
+    { "ReadULong", &ElunaMethod<&LuaPacket::ReadULong>::Call },
+    { "ReadGUID", &ElunaMethod<&LuaPacket::ReadGUID>::Call },
+    { "ReadPackedGUID", &ElunaMethod<&LuaPacket::ReadPackedGUID>::Call },
+    { "ReadString", &ElunaMethod<&LuaPacket::ReadString>::Call },
+    { "ReadFloat", &ElunaMethod<&LuaPacket::ReadFloat>::Call },
+    { "ReadDouble", &ElunaMethod<&LuaPacket::ReadDouble>::Call },
+    { "ReadBytes", &ElunaMethod<&LuaPacket::ReadBytes>::Call },
+    { "Unpack", &ElunaMethod<&LuaPacket::Unpack>::Call },
 
     // Writers
-    { "WriteByte", &LuaPacket::WriteByte },
-    { "WriteUByte", &LuaPacket::WriteUByte },
-    { "WriteShort", &LuaPacket::WriteShort },
-    { "WriteUShort", &LuaPacket::WriteUShort },
-    { "WriteLong", &LuaPacket::WriteLong },
-    { "WriteULong", &LuaPacket::WriteULong },
-    { "WriteGUID", &LuaPacket::WriteGUID },
-    { "WriteString", &LuaPacket::WriteString },
-    { "WriteFloat", &LuaPacket::WriteFloat },
-    { "WriteDouble", &LuaPacket::WriteDouble },
+    { "WriteByte", &ElunaMethod<&LuaPacket::WriteByte>::Call },
+    { "WriteUByte", &ElunaMethod<&LuaPacket::WriteUByte>::Call },
+    { "WriteShort", &ElunaMethod<&LuaPacket::WriteShort>::Call },
+    { "WriteUShort", &ElunaMethod<&LuaPacket::WriteUShort>::Call },
+    { "WriteLong", &ElunaMethod<&LuaPacket::WriteLong>::Call },
+    { "WriteULong", &ElunaMethod<&LuaPacket::WriteULong>::Call },
+    { "WriteGUID", &ElunaMethod<&LuaPacket::WriteGUID>::Call },
+    { "WriteString", &ElunaMethod<&LuaPacket::WriteString>::Call },
+    { "WriteFloat", &ElunaMethod<&LuaPacket::WriteFloat>::Call },
+    { "WriteDouble", &ElunaMethod<&LuaPacket::WriteDouble>::Call },
+    { "WriteBytes", &ElunaMethod<&LuaPacket::WriteBytes>::Call },
+    { "Pack", &ElunaMethod<&LuaPacket::Pack>::Call },
 
     { NULL, NULL }
 };
@@ -1214,33 +1245,33 @@ ElunaRegister<WorldPacket> PacketMethods[] =
 ElunaRegister<Map> MapMethods[] =
 {
     // Getters
-    { "GetName", &LuaMap::GetName },
-    { "GetDifficulty", &LuaMap::GetDifficulty },
-    { "GetInstanceId", &LuaMap::GetInstanceId },
-    { "GetInstanceData", &LuaMap::GetInstanceData },
-    { "GetPlayerCount", &LuaMap::GetPlayerCount },
-    { "GetPlayers", &LuaMap::GetPlayers },
-    { "GetMapId", &LuaMap::GetMapId },
-    { "GetAreaId", &LuaMap::GetAreaId },
-    { "GetHeight", &LuaMap::GetHeight },
-    { "GetWorldObject", &LuaMap::GetWorldObject },
-    { "GetCreatures", &LuaMap::GetCreatures },
-    { "GetCreaturesByAreaId", &LuaMap::GetCreaturesByAreaId },
+    { "GetName", &ElunaMethod<&LuaMap::GetName>::Call },
+    { "GetDifficulty", &ElunaMethod<&LuaMap::GetDifficulty>::Call },
+    { "GetInstanceId", &ElunaMethod<&LuaMap::GetInstanceId>::Call },
+    { "GetInstanceData", &ElunaMethod<&LuaMap::GetInstanceData>::Call },
+    { "GetPlayerCount", &ElunaMethod<&LuaMap::GetPlayerCount>::Call },
+    { "GetPlayers", &ElunaMethod<&LuaMap::GetPlayers>::Call },
+    { "GetMapId", &ElunaMethod<&LuaMap::GetMapId>::Call },
+    { "GetAreaId", &ElunaMethod<&LuaMap::GetAreaId>::Call },
+    { "GetHeight", &ElunaMethod<&LuaMap::GetHeight>::Call },
+    { "GetWorldObject", &ElunaMethod<&LuaMap::GetWorldObject>::Call },
+    { "GetCreatures", &ElunaMethod<&LuaMap::GetCreatures>::Call },
+    { "GetCreaturesByAreaId", &ElunaMethod<&LuaMap::GetCreaturesByAreaId>::Call },
 
 
     // Setters
-    { "SetWeather", &LuaMap::SetWeather },
+    { "SetWeather", &ElunaMethod<&LuaMap::SetWeather>::Call },
 
     // Boolean
-    { "IsArena", &LuaMap::IsArena },
-    { "IsBattleground", &LuaMap::IsBattleground },
-    { "IsDungeon", &LuaMap::IsDungeon },
-    { "IsEmpty", &LuaMap::IsEmpty },
-    { "IsHeroic", &LuaMap::IsHeroic },
-    { "IsRaid", &LuaMap::IsRaid },
+    { "IsArena", &ElunaMethod<&LuaMap::IsArena>::Call },
+    { "IsBattleground", &ElunaMethod<&LuaMap::IsBattleground>::Call },
+    { "IsDungeon", &ElunaMethod<&LuaMap::IsDungeon>::Call },
+    { "IsEmpty", &ElunaMethod<&LuaMap::IsEmpty>::Call },
+    { "IsHeroic", &ElunaMethod<&LuaMap::IsHeroic>::Call },
+    { "IsRaid", &ElunaMethod<&LuaMap::IsRaid>::Call },
 
     // Other
-    { "SaveInstanceData", &LuaMap::SaveInstanceData },
+    { "SaveInstanceData", &ElunaMethod<&LuaMap::SaveInstanceData>::Call },
 
     { NULL, NULL }
 };
@@ -1248,13 +1279,13 @@ ElunaRegister<Map> MapMethods[] =
 ElunaRegister<Corpse> CorpseMethods[] =
 {
     // Getters
-    { "GetOwnerGUID", &LuaCorpse::GetOwnerGUID },
-    { "GetGhostTime", &LuaCorpse::GetGhostTime },
-    { "GetType", &LuaCorpse::GetType },
+    { "GetOwnerGUID", &ElunaMethod<&LuaCorpse::GetOwnerGUID>::Call },
+    { "GetGhostTime", &ElunaMethod<&LuaCorpse::GetGhostTime>::Call },
+    { "GetType", &ElunaMethod<&LuaCorpse::GetType>::Call },
 
     // Other
-    { "ResetGhostTime", &LuaCorpse::ResetGhostTime },
-    { "SaveToDB", &LuaCorpse::SaveToDB },
+    { "ResetGhostTime", &ElunaMethod<&LuaCorpse::ResetGhostTime>::Call },
+    { "SaveToDB", &ElunaMethod<&LuaCorpse::SaveToDB>::Call },
 
     { NULL, NULL }
 };
@@ -1267,103 +1298,103 @@ ElunaRegister<AuctionHouseEntry> AuctionMethods[] =
 ElunaRegister<BattleGround> BattleGroundMethods[] =
 {
     // Getters
-    { "GetName", &LuaBattleGround::GetName },
-    { "GetAlivePlayersCountByTeam", &LuaBattleGround::GetAlivePlayersCountByTeam },
-    { "GetMap", &LuaBattleGround::GetMap },
-    { "GetBonusHonorFromKillCount", &LuaBattleGround::GetBonusHonorFromKillCount },
-    { "GetEndTime", &LuaBattleGround::GetEndTime },
-    { "GetFreeSlotsForTeam", &LuaBattleGround::GetFreeSlotsForTeam },
-    { "GetInstanceId", &LuaBattleGround::GetInstanceId },
-    { "GetMapId", &LuaBattleGround::GetMapId },
-    { "GetTypeId", &LuaBattleGround::GetTypeId },
-    { "GetMaxLevel", &LuaBattleGround::GetMaxLevel },
-    { "GetMinLevel", &LuaBattleGround::GetMinLevel },
-    { "GetMaxPlayers", &LuaBattleGround::GetMaxPlayers },
-    { "GetMinPlayers", &LuaBattleGround::GetMinPlayers },
-    { "GetMaxPlayersPerTeam", &LuaBattleGround::GetMaxPlayersPerTeam },
-    { "GetMinPlayersPerTeam", &LuaBattleGround::GetMinPlayersPerTeam },
-    { "GetWinner", &LuaBattleGround::GetWinner },
-    { "GetStatus", &LuaBattleGround::GetStatus },
+    { "GetName", &ElunaMethod<&LuaBattleGround::GetName>::Call },
+    { "GetAlivePlayersCountByTeam", &ElunaMethod<&LuaBattleGround::GetAlivePlayersCountByTeam>::Call },
+    { "GetMap", &ElunaMethod<&LuaBattleGround::GetMap>::Call },
+    { "GetBonusHonorFromKillCount", &ElunaMethod<&LuaBattleGround::GetBonusHonorFromKillCount>::Call },
+    { "GetEndTime", &ElunaMethod<&LuaBattleGround::GetEndTime>::Call },
+    { "GetFreeSlotsForTeam", &ElunaMethod<&LuaBattleGround::GetFreeSlotsForTeam>::Call },
+    { "GetInstanceId", &ElunaMethod<&LuaBattleGround::GetInstanceId>::Call },
+    { "GetMapId", &ElunaMethod<&LuaBattleGround::GetMapId>::Call },
+    { "GetTypeId", &ElunaMethod<&LuaBattleGround::GetTypeId>::Call },
+    { "GetMaxLevel", &ElunaMethod<&LuaBattleGround::GetMaxLevel>::Call },
+    { "GetMinLevel", &ElunaMethod<&LuaBattleGround::GetMinLevel>::Call },
+    { "GetMaxPlayers", &ElunaMethod<&LuaBattleGround::GetMaxPlayers>::Call },
+    { "GetMinPlayers", &ElunaMethod<&LuaBattleGround::GetMinPlayers>::Call },
+    { "GetMaxPlayersPerTeam", &ElunaMethod<&LuaBattleGround::GetMaxPlayersPerTeam>::Call },
+    { "GetMinPlayersPerTeam", &ElunaMethod<&LuaBattleGround::GetMinPlayersPerTeam>::Call },
+    { "GetWinner", &ElunaMethod<&LuaBattleGround::GetWinner>::Call },
+    { "GetStatus", &ElunaMethod<&LuaBattleGround::GetStatus>::Call },
 
     { NULL, NULL }
 };
 
 ElunaRegister<ChatHandler> ChatHandlerMethods[] =
 {
-    { "SendSysMessage", &LuaChatHandler::SendSysMessage },
-    { "IsConsole", &LuaChatHandler::IsConsole },
-    { "GetPlayer", &LuaChatHandler::GetPlayer },
-    { "SendGlobalSysMessage", &LuaChatHandler::SendGlobalSysMessage },
-    { "SendGlobalGMSysMessage", &LuaChatHandler::SendGlobalGMSysMessage },
-    { "HasLowerSecurity", &LuaChatHandler::HasLowerSecurity },
-    { "HasLowerSecurityAccount", &LuaChatHandler::HasLowerSecurityAccount },
-    { "GetSelectedPlayer", &LuaChatHandler::GetSelectedPlayer },
-    { "GetSelectedCreature", &LuaChatHandler::GetSelectedCreature },
-    { "GetSelectedUnit", &LuaChatHandler::GetSelectedUnit },
-    { "GetSelectedObject", &LuaChatHandler::GetSelectedObject },
-    { "GetSelectedPlayerOrSelf", &LuaChatHandler::GetSelectedPlayerOrSelf },
-    { "IsAvailable", &LuaChatHandler::IsAvailable },
-    { "HasSentErrorMessage", &LuaChatHandler::HasSentErrorMessage },
+    { "SendSysMessage", &ElunaMethod<&LuaChatHandler::SendSysMessage>::Call },
+    { "IsConsole", &ElunaMethod<&LuaChatHandler::IsConsole>::Call },
+    { "GetPlayer", &ElunaMethod<&LuaChatHandler::GetPlayer>::Call },
+    { "SendGlobalSysMessage", &ElunaMethod<&LuaChatHandler::SendGlobalSysMessage>::Call },
+    { "SendGlobalGMSysMessage", &ElunaMethod<&LuaChatHandler::SendGlobalGMSysMessage>::Call },
+    { "HasLowerSecurity", &ElunaMethod<&LuaChatHandler::HasLowerSecurity>::Call },
+    { "HasLowerSecurityAccount", &ElunaMethod<&LuaChatHandler::HasLowerSecurityAccount>::Call },
+    { "GetSelectedPlayer", &ElunaMethod<&LuaChatHandler::GetSelectedPlayer>::Call },
+    { "GetSelectedCreature", &ElunaMethod<&LuaChatHandler::GetSelectedCreature>::Call },
+    { "GetSelectedUnit", &ElunaMethod<&LuaChatHandler::GetSelectedUnit>::Call },
+    { "GetSelectedObject", &ElunaMethod<&LuaChatHandler::GetSelectedObject>::Call },
+    { "GetSelectedPlayerOrSelf", &ElunaMethod<&LuaChatHandler::GetSelectedPlayerOrSelf>::Call },
+    { "IsAvailable", &ElunaMethod<&LuaChatHandler::IsAvailable>::Call },
+    { "HasSentErrorMessage", &ElunaMethod<&LuaChatHandler::HasSentErrorMessage>::Call },
 
     { NULL, NULL }
 };
 
 ElunaRegister<AchievementEntry> AchievementMethods[] =
 {
-    { "GetId", &LuaAchievement::GetId },
-    { "GetName", &LuaAchievement::GetName },
+    { "GetId", &ElunaMethod<&LuaAchievement::GetId>::Call },
+    { "GetName", &ElunaMethod<&LuaAchievement::GetName>::Call },
 
     { NULL, NULL }
 };
 
 ElunaRegister<Roll> RollMethods[] =
 {
-    { "GetItemGUID", &LuaRoll::GetItemGUID },
-    { "GetItemId", &LuaRoll::GetItemId },
-    { "GetItemRandomPropId", &LuaRoll::GetItemRandomPropId },
-    { "GetItemRandomSuffix", &LuaRoll::GetItemRandomSuffix },
-    { "GetItemCount", &LuaRoll::GetItemCount },
-    { "GetPlayerVote", &LuaRoll::GetPlayerVote },
-    { "GetPlayerVoteGUIDs", &LuaRoll::GetPlayerVoteGUIDs },
-    { "GetTotalPlayersRolling", &LuaRoll::GetTotalPlayersRolling },
-    { "GetTotalNeed", &LuaRoll::GetTotalNeed },
-    { "GetTotalGreed", &LuaRoll::GetTotalGreed },
-    { "GetTotalPass", &LuaRoll::GetTotalPass },
-    { "GetItemSlot", &LuaRoll::GetItemSlot },
-    { "GetRollVoteMask", &LuaRoll::GetRollVoteMask },
+    { "GetItemGUID", &ElunaMethod<&LuaRoll::GetItemGUID>::Call },
+    { "GetItemId", &ElunaMethod<&LuaRoll::GetItemId>::Call },
+    { "GetItemRandomPropId", &ElunaMethod<&LuaRoll::GetItemRandomPropId>::Call },
+    { "GetItemRandomSuffix", &ElunaMethod<&LuaRoll::GetItemRandomSuffix>::Call },
+    { "GetItemCount", &ElunaMethod<&LuaRoll::GetItemCount>::Call },
+    { "GetPlayerVote", &ElunaMethod<&LuaRoll::GetPlayerVote>::Call },
+    { "GetPlayerVoteGUIDs", &ElunaMethod<&LuaRoll::GetPlayerVoteGUIDs>::Call },
+    { "GetTotalPlayersRolling", &ElunaMethod<&LuaRoll::GetTotalPlayersRolling>::Call },
+    { "GetTotalNeed", &ElunaMethod<&LuaRoll::GetTotalNeed>::Call },
+    { "GetTotalGreed", &ElunaMethod<&LuaRoll::GetTotalGreed>::Call },
+    { "GetTotalPass", &ElunaMethod<&LuaRoll::GetTotalPass>::Call },
+    { "GetItemSlot", &ElunaMethod<&LuaRoll::GetItemSlot>::Call },
+    { "GetRollVoteMask", &ElunaMethod<&LuaRoll::GetRollVoteMask>::Call },
 
     { NULL, NULL }
 };
 
 ElunaRegister<GmTicket> TicketMethods[] =
 {
-    { "IsClosed", &LuaTicket::IsClosed },
-    { "IsCompleted", &LuaTicket::IsCompleted },
-    { "IsFromPlayer", &LuaTicket::IsFromPlayer },
-    { "IsAssigned", &LuaTicket::IsAssigned },
-    { "IsAssignedTo", &LuaTicket::IsAssignedTo },
-    { "IsAssignedNotTo", &LuaTicket::IsAssignedNotTo },
-
-    { "GetId", &LuaTicket::GetId },
-    { "GetPlayer", &LuaTicket::GetPlayer },
-    { "GetPlayerName", &LuaTicket::GetPlayerName },
-    { "GetMessage", &LuaTicket::GetMessage },
-    { "GetAssignedPlayer", &LuaTicket::GetAssignedPlayer },
-    { "GetAssignedToGUID", &LuaTicket::GetAssignedToGUID },
-    { "GetLastModifiedTime", &LuaTicket::GetLastModifiedTime },
-    { "GetResponse", &LuaTicket::GetResponse },
-    { "GetChatLog", &LuaTicket::GetChatLog },
-
-    { "SetAssignedTo", &LuaTicket::SetAssignedTo },
-    { "SetResolvedBy", &LuaTicket::SetResolvedBy },
-    { "SetCompleted", &LuaTicket::SetCompleted },
-    { "SetMessage", &LuaTicket::SetMessage },
-    { "SetComment", &LuaTicket::SetComment },
-    { "SetViewed", &LuaTicket::SetViewed },
-    { "SetUnassigned", &LuaTicket::SetUnassigned },
-    { "SetPosition", &LuaTicket::SetPosition },
-    { "AppendResponse", &LuaTicket::AppendResponse },
-    { "DeleteResponse", &LuaTicket::DeleteResponse },
+    { "IsClosed", &ElunaMethod<&LuaTicket::IsClosed>::Call },
+    { "IsCompleted", &ElunaMethod<&LuaTicket::IsCompleted>::Call },
+    { "IsFromPlayer", &ElunaMethod<&LuaTicket::IsFromPlayer>::Call },
+    { "IsAssigned", &ElunaMethod<&LuaTicket::IsAssigned>::Call },
+    { "IsAssignedTo", &ElunaMethod<&LuaTicket::IsAssignedTo>::Call },
+    { "IsAssignedNotTo", &ElunaMethod<&LuaTicket::IsAssignedNotTo>::Call },
+
+    { "GetId", &ElunaMethod<&LuaTicket::GetId>::Call },
+    { "GetPlayer", &ElunaMethod<&LuaTicket::GetPlayer>::Call },
+    { "GetPlayerName", &ElunaMethod<&LuaTicket::GetPlayerName>::Call },
+    { "GetMessage", &ElunaMethod<&LuaTicket::GetMessage>::Call },
+    { "GetAssignedPlayer", &ElunaMethod<&LuaTicket::GetAssignedPlayer>::Call },
+    { "GetAssignedToGUID", &ElunaMethod<&LuaTicket::GetAssignedToGUID>::Call },
+    { "GetLastModifiedTime", &ElunaMethod<&LuaTicket::GetLastModifiedTime>::Call },
+    { "GetResponse", &ElunaMethod<&LuaTicket::GetResponse>::Call },
+    { "GetChatLog", &ElunaMethod<&LuaTicket::GetChatLog>::Call },
+
+    { "SetAssignedTo", &ElunaMethod<&LuaTicket::SetAssignedTo>::Call },
+    { "SetResolvedBy", &ElunaMethod<&LuaTicket::SetResolvedBy>::Call },
+    { "SetCompleted", &ElunaMethod<&LuaTicket::SetCompleted>::Call },
+    { "SetMessage", &ElunaMethod<&LuaTicket::SetMessage>::Call },
+    { "SetComment", &ElunaMethod<&LuaTicket::SetComment>::Call },
+    { "SetViewed", &ElunaMethod<&LuaTicket::SetViewed>::Call },
+    { "SetUnassigned", &ElunaMethod<&LuaTicket::SetUnassigned>::Call },
+    { "SetPosition", &ElunaMethod<&LuaTicket::SetPosition>::Call },
+    { "AppendResponse", &ElunaMethod<&LuaTicket::AppendResponse>::Call },
+    { "DeleteResponse", &ElunaMethod<&LuaTicket::DeleteResponse>::Call },
   
     { NULL, NULL }
 };
@@ -1371,70 +1402,70 @@ ElunaRegister<GmTicket> TicketMethods[] =
 ElunaRegister<SpellInfo> SpellInfoMethods[] =
 {
     // Getters
-    { "GetAttributes", &LuaSpellInfo::GetAttributes },
-    { "GetCategory", &LuaSpellInfo::GetCategory },
-    { "GetName", &LuaSpellInfo::GetName },
-    { "CheckShapeshift", &LuaSpellInfo::CheckShapeshift },
-    { "CheckLocation", &LuaSpellInfo::CheckLocation },
-    { "CheckTarget", &LuaSpellInfo::CheckTarget },
-    { "CheckExplicitTarget", &LuaSpellInfo::CheckExplicitTarget },
-    { "CheckTargetCreatureType", &LuaSpellInfo::CheckTargetCreatureType },
-    { "CheckTargetCreatureType", &LuaSpellInfo::CheckTargetCreatureType },
-    { "GetSchoolMask", &LuaSpellInfo::GetSchoolMask },
-    { "GetAllEffectsMechanicMask", &LuaSpellInfo::GetAllEffectsMechanicMask },
-    { "GetEffectMechanicMask", &LuaSpellInfo::GetEffectMechanicMask },
-    { "GetSpellMechanicMaskByEffectMask", &LuaSpellInfo::GetSpellMechanicMaskByEffectMask },
-    { "GetEffectMechanic", &LuaSpellInfo::GetEffectMechanic },
-    { "GetDispelMask", &LuaSpellInfo::GetDispelMask },
-    { "GetExplicitTargetMask", &LuaSpellInfo::GetExplicitTargetMask },
-    { "GetAuraState", &LuaSpellInfo::GetAuraState },
-    { "GetSpellSpecific", &LuaSpellInfo::GetSpellSpecific },
+    { "GetAttributes", &ElunaMethod<&LuaSpellInfo::GetAttributes>::Call },
+    { "GetCategory", &ElunaMethod<&LuaSpellInfo::GetCategory>::Call },
+    { "GetName", &ElunaMethod<&LuaSpellInfo::GetName>::Call },
+    { "CheckShapeshift", &ElunaMethod<&LuaSpellInfo::CheckShapeshift>::Call },
+    { "CheckLocation", &ElunaMethod<&LuaSpellInfo::CheckLocation>::Call },
+    { "CheckTarget", &ElunaMethod<&LuaSpellInfo::CheckTarget>::Call },
+    { "CheckExplicitTarget", &ElunaMethod<&LuaSpellInfo::CheckExplicitTarget>::Call },
+    { "CheckTargetCreatureType", &ElunaMethod<&LuaSpellInfo::CheckTargetCreatureType>::Call },
+    { "CheckTargetCreatureType", &ElunaMethod<&LuaSpellInfo::CheckTargetCreatureType>::Call },
+    { "GetSchoolMask", &ElunaMethod<&LuaSpellInfo::GetSchoolMask>::Call },
+    { "GetAllEffectsMechanicMask", &ElunaMethod<&LuaSpellInfo::GetAllEffectsMechanicMask>::Call },
+    { "GetEffectMechanicMask", &ElunaMethod<&LuaSpellInfo::GetEffectMechanicMask>::Call },
+    { "GetSpellMechanicMaskByEffectMask", &ElunaMethod<&LuaSpellInfo::GetSpellMechanicMaskByEffectMask>::Call },
+    { "GetEffectMechanic", &ElunaMethod<&LuaSpellInfo::GetEffectMechanic>::Call },
+    { "GetDispelMask", &ElunaMethod<&LuaSpellInfo::GetDispelMask>::Call },
+    { "GetExplicitTargetMask", &ElunaMethod<&LuaSpellInfo::GetExplicitTargetMask>::Call },
+    { "GetAuraState", &ElunaMethod<&LuaSpellInfo::GetAuraState>::Call },
+    { "GetSpellSpecific", &ElunaMethod<&LuaSpellInfo::GetSpellSpecific>::Call },
 
     // Setters
 
     // Boolean
-    { "HasAreaAuraEffect", &LuaSpellInfo::HasAreaAuraEffect },
-    { "HasAttribute", &LuaSpellInfo::HasAttribute },
-    { "HasAura", &LuaSpellInfo::HasAura },
-    { "HasEffect", &LuaSpellInfo::HasEffect },
-
-    { "IsAbilityLearnedWithProfession", &LuaSpellInfo::IsAbilityLearnedWithProfession },
-    { "IsAbilityOfSkillType", &LuaSpellInfo::IsAbilityOfSkillType },
-    { "IsAffectingArea", &LuaSpellInfo::IsAffectingArea },
-    { "IsAllowingDeadTarget", &LuaSpellInfo::IsAllowingDeadTarget },
-    { "IsAutocastable", &LuaSpellInfo::IsAutocastable },
-    { "IsAutoRepeatRangedSpell", &LuaSpellInfo::IsAutoRepeatRangedSpell },
-    { "IsBreakingStealth", &LuaSpellInfo::IsBreakingStealth },
-    { "IsChanneled", &LuaSpellInfo::IsChanneled },
-    { "IsCooldownStartedOnEvent", &LuaSpellInfo::IsCooldownStartedOnEvent },
-    { "IsDeathPersistent", &LuaSpellInfo::IsDeathPersistent },
-    { "IsExplicitDiscovery", &LuaSpellInfo::IsExplicitDiscovery },
-    { "IsLootCrafting", &LuaSpellInfo::IsLootCrafting },
-    { "IsMultiSlotAura", &LuaSpellInfo::IsMultiSlotAura },
-    { "IsPassive", &LuaSpellInfo::IsPassive },
-    { "IsPassiveStackableWithRanks", &LuaSpellInfo::IsPassiveStackableWithRanks },
-    { "IsPositive", &LuaSpellInfo::IsPositive },
-    { "IsPositiveEffect", &LuaSpellInfo::IsPositiveEffect },
-    { "IsPrimaryProfession", &LuaSpellInfo::IsPrimaryProfession },
-    { "IsPrimaryProfessionFirstRank", &LuaSpellInfo::IsPrimaryProfessionFirstRank },
-    { "IsProfession", &LuaSpellInfo::IsProfession },
-    { "IsProfessionOrRiding", &LuaSpellInfo::IsProfessionOrRiding },
-    { "IsRangedWeaponSpell", &LuaSpellInfo::IsRangedWeaponSpell },
-    { "IsRequiringDeadTarget", &LuaSpellInfo::IsRequiringDeadTarget },
-    { "IsStackableWithRanks", &LuaSpellInfo::IsStackableWithRanks },
-    { "IsTargetingArea", &LuaSpellInfo::IsTargetingArea },
-    { "IsAffectedBySpellMods", &LuaSpellInfo::IsAffectedBySpellMods },
-    /* { "IsAffectedBySpellMod", &LuaSpellInfo::IsAffectedBySpellMod }, */
-    { "CanPierceImmuneAura", &LuaSpellInfo::CanPierceImmuneAura },
-    { "CanDispelAura", &LuaSpellInfo::CanDispelAura },
-    { "IsSingleTarget", &LuaSpellInfo::IsSingleTarget },
-    { "IsAuraExclusiveBySpecificWith", &LuaSpellInfo::IsAuraExclusiveBySpecificWith },
-    { "IsAuraExclusiveBySpecificPerCasterWith", &LuaSpellInfo::IsAuraExclusiveBySpecificPerCasterWith },
-    { "CanBeUsedInCombat", &LuaSpellInfo::CanBeUsedInCombat },
-
-    { "NeedsComboPoints", &LuaSpellInfo::NeedsComboPoints },
-    { "NeedsExplicitUnitTarget", &LuaSpellInfo::NeedsExplicitUnitTarget },
-    { "NeedsToBeTriggeredByCaster", &LuaSpellInfo::NeedsToBeTriggeredByCaster },
+    { "HasAreaAuraEffect", &ElunaMethod<&LuaSpellInfo::HasAreaAuraEffect>::Call },
+    { "HasAttribute", &ElunaMethod<&LuaSpellInfo::HasAttribute>::Call },
+    { "HasAura", &ElunaMethod<&LuaSpellInfo::HasAura>::Call },
+    { "HasEffect", &ElunaMethod<&LuaSpellInfo::HasEffect>::Call },
+
+    { "IsAbilityLearnedWithProfession", &ElunaMethod<&LuaSpellInfo::IsAbilityLearnedWithProfession>::Call },
+    { "IsAbilityOfSkillType", &ElunaMethod<&LuaSpellInfo::IsAbilityOfSkillType>::Call },
+    { "IsAffectingArea", &ElunaMethod<&LuaSpellInfo::IsAffectingArea>::Call },
+    { "IsAllowingDeadTarget", &ElunaMethod<&LuaSpellInfo::IsAllowingDeadTarget>::Call },
+    { "IsAutocastable", &ElunaMethod<&LuaSpellInfo::IsAutocastable>::Call },
+    { "IsAutoRepeatRangedSpell", &ElunaMethod<&LuaSpellInfo::IsAutoRepeatRangedSpell>::Call },
+    { "IsBreakingStealth", &ElunaMethod<&LuaSpellInfo::IsBreakingStealth>::Call },
+    { "IsChanneled", &ElunaMethod<&LuaSpellInfo::IsChanneled>::Call },
+    { "IsCooldownStartedOnEvent", &ElunaMethod<&LuaSpellInfo::IsCooldownStartedOnEvent>::Call },
+    { "IsDeathPersistent", &ElunaMethod<&LuaSpellInfo::IsDeathPersistent>::Call },
+    { "IsExplicitDiscovery", &ElunaMethod<&LuaSpellInfo::IsExplicitDiscovery>::Call },
+    { "IsLootCrafting", &ElunaMethod<&LuaSpellInfo::IsLootCrafting>::Call },
+    { "IsMultiSlotAura", &ElunaMethod<&LuaSpellInfo::IsMultiSlotAura>::Call },
+    { "IsPassive", &ElunaMethod<&LuaSpellInfo::IsPassive>::Call },
+    { "IsPassiveStackableWithRanks", &ElunaMethod<&LuaSpellInfo::IsPassiveStackableWithRanks>::Call },
+    { "IsPositive", &ElunaMethod<&LuaSpellInfo::IsPositive>::Call },
+    { "IsPositiveEffect", &ElunaMethod<&LuaSpellInfo::IsPositiveEffect>::Call },
+    { "IsPrimaryProfession", &ElunaMethod<&LuaSpellInfo::IsPrimaryProfession>::Call },
+    { "IsPrimaryProfessionFirstRank", &ElunaMethod<&LuaSpellInfo::IsPrimaryProfessionFirstRank>::Call },
+    { "IsProfession", &ElunaMethod<&LuaSpellInfo::IsProfession>::Call },
+    { "IsProfessionOrRiding", &ElunaMethod<&LuaSpellInfo::IsProfessionOrRiding>::Call },
+    { "IsRangedWeaponSpell", &ElunaMethod<&LuaSpellInfo::IsRangedWeaponSpell>::Call },
+    { "IsRequiringDeadTarget", &ElunaMethod<&LuaSpellInfo::IsRequiringDeadTarget>::Call },
+    { "IsStackableWithRanks", &ElunaMethod<&LuaSpellInfo::IsStackableWithRanks>::Call },
+    { "IsTargetingArea", &ElunaMethod<&LuaSpellInfo::IsTargetingArea>::Call },
+    { "IsAffectedBySpellMods", &ElunaMethod<&LuaSpellInfo::IsAffectedBySpellMods>::Call },
+    /* { "IsAffectedBySpellMod", &ElunaMethod<&LuaSpellInfo::IsAffectedBySpellMod>::Call }, */
+    { "CanPierceImmuneAura", &ElunaMethod<&LuaSpellInfo::CanPierceImmuneAura>::Call },
+    { "CanDispelAura", &ElunaMethod<&LuaSpellInfo::CanDispelAura>::Call },
+    { "IsSingleTarget", &ElunaMethod<&LuaSpellInfo::IsSingleTarget>::Call },
+    { "IsAuraExclusiveBySpecificWith", &ElunaMethod<&LuaSpellInfo::IsAuraExclusiveBySpecificWith>::Call },
+    { "IsAuraExclusiveBySpecificPerCasterWith", &ElunaMethod<&LuaSpellInfo::IsAuraExclusiveBySpecificPerCasterWith>::Call },
+    { "CanBeUsedInCombat", &ElunaMethod<&LuaSpellInfo::CanBeUsedInCombat>::Call },
+
+    { "NeedsComboPoints", &ElunaMethod<&LuaSpellInfo::NeedsComboPoints>::Call },
+    { "NeedsExplicitUnitTarget", &ElunaMethod<&LuaSpellInfo::NeedsExplicitUnitTarget>::Call },
+    { "NeedsToBeTriggeredByCaster", &ElunaMethod<&LuaSpellInfo::NeedsToBeTriggeredByCaster>::Call },
 
     { NULL, NULL }
 };
@@ -1442,8 +1473,8 @@ ElunaRegister<SpellInfo> SpellInfoMethods[] =
 ElunaRegister<GemPropertiesEntry> GemPropertiesEntryMethods[] =
 {
     // Getters
-    { "GetId", &LuaGemPropertiesEntry::GetId },
-    { "GetSpellItemEnchantement", &LuaGemPropertiesEntry::GetSpellItemEnchantement },
+    { "GetId", &ElunaMethod<&LuaGemPropertiesEntry::GetId>::Call },
+    { "GetSpellItemEnchantement", &ElunaMethod<&LuaGemPropertiesEntry::GetSpellItemEnchantement>::Call },
 
     { NULL, NULL }
 };
@@ -1451,98 +1482,98 @@ ElunaRegister<GemPropertiesEntry> GemPropertiesEntryMethods[] =
 ElunaRegister<SpellEntry> SpellEntryMethods[] =
 {
     // Getters
-    { "GetId", &LuaSpellEntry::GetId },
-    { "GetCategory", &LuaSpellEntry::GetCategory },
-    { "GetDispel", &LuaSpellEntry::GetDispel },
-    { "GetMechanic", &LuaSpellEntry::GetMechanic },
-    { "GetAttributes", &LuaSpellEntry::GetAttributes },
-    { "GetAttributesEx", &LuaSpellEntry::GetAttributesEx },
-    { "GetAttributesEx2", &LuaSpellEntry::GetAttributesEx2 },
-    { "GetAttributesEx3", &LuaSpellEntry::GetAttributesEx3 },
-    { "GetAttributesEx4", &LuaSpellEntry::GetAttributesEx4 },
-    { "GetAttributesEx5", &LuaSpellEntry::GetAttributesEx5 },
-    { "GetAttributesEx6", &LuaSpellEntry::GetAttributesEx6 },
-    { "GetAttributesEx7", &LuaSpellEntry::GetAttributesEx7 },
-    { "GetStances", &LuaSpellEntry::GetStances },
-    { "GetStancesNot", &LuaSpellEntry::GetStancesNot },
-    { "GetTargets", &LuaSpellEntry::GetTargets },
-    { "GetTargetCreatureType", &LuaSpellEntry::GetTargetCreatureType },
-    { "GetRequiresSpellFocus", &LuaSpellEntry::GetRequiresSpellFocus },
-    { "GetFacingCasterFlags", &LuaSpellEntry::GetFacingCasterFlags },
-    { "GetCasterAuraState", &LuaSpellEntry::GetCasterAuraState },
-    { "GetTargetAuraState", &LuaSpellEntry::GetTargetAuraState },
-    { "GetCasterAuraStateNot", &LuaSpellEntry::GetCasterAuraStateNot },
-    { "GetTargetAuraStateNot", &LuaSpellEntry::GetTargetAuraStateNot },
-    { "GetCasterAuraSpell", &LuaSpellEntry::GetCasterAuraSpell },
-    { "GetTargetAuraSpell", &LuaSpellEntry::GetTargetAuraSpell },
-    { "GetExcludeCasterAuraSpell", &LuaSpellEntry::GetExcludeCasterAuraSpell },
-    { "GetExcludeTargetAuraSpell", &LuaSpellEntry::GetExcludeTargetAuraSpell },
-    { "GetCastingTimeIndex", &LuaSpellEntry::GetCastingTimeIndex },
-    { "GetRecoveryTime", &LuaSpellEntry::GetRecoveryTime },
-    { "GetCategoryRecoveryTime", &LuaSpellEntry::GetCategoryRecoveryTime },
-    { "GetInterruptFlags", &LuaSpellEntry::GetInterruptFlags },
-    { "GetAuraInterruptFlags", &LuaSpellEntry::GetAuraInterruptFlags },
-    { "GetChannelInterruptFlags", &LuaSpellEntry::GetChannelInterruptFlags },
-    { "GetProcFlags", &LuaSpellEntry::GetProcFlags },
-    { "GetProcChance", &LuaSpellEntry::GetProcChance },
-    { "GetProcCharges", &LuaSpellEntry::GetProcCharges },
-    { "GetMaxLevel", &LuaSpellEntry::GetMaxLevel },
-    { "GetBaseLevel", &LuaSpellEntry::GetBaseLevel },
-    { "GetSpellLevel", &LuaSpellEntry::GetSpellLevel },
-    { "GetDurationIndex", &LuaSpellEntry::GetDurationIndex },
-    { "GetPowerType", &LuaSpellEntry::GetPowerType },
-    { "GetManaCost", &LuaSpellEntry::GetManaCost },
-    { "GetManaCostPerlevel", &LuaSpellEntry::GetManaCostPerlevel },
-    { "GetManaPerSecond", &LuaSpellEntry::GetManaPerSecond },
-    { "GetManaPerSecondPerLevel", &LuaSpellEntry::GetManaPerSecondPerLevel },
-    { "GetRangeIndex", &LuaSpellEntry::GetRangeIndex },
-    { "GetSpeed", &LuaSpellEntry::GetSpeed },
-    { "GetStackAmount", &LuaSpellEntry::GetStackAmount },
-    { "GetTotem", &LuaSpellEntry::GetTotem },
-    { "GetReagent", &LuaSpellEntry::GetReagent },
-    { "GetReagentCount", &LuaSpellEntry::GetReagentCount },
-    { "GetEquippedItemClass", &LuaSpellEntry::GetEquippedItemClass },
-    { "GetEquippedItemSubClassMask", &LuaSpellEntry::GetEquippedItemSubClassMask },
-    { "GetEquippedItemInventoryTypeMask", &LuaSpellEntry::GetEquippedItemInventoryTypeMask },
-    { "GetEffect", &LuaSpellEntry::GetEffect },
-    { "GetEffectDieSides", &LuaSpellEntry::GetEffectDieSides },
-    { "GetEffectRealPointsPerLevel", &LuaSpellEntry::GetEffectRealPointsPerLevel },
-    { "GetEffectBasePoints", &LuaSpellEntry::GetEffectBasePoints },
-    { "GetEffectMechanic", &LuaSpellEntry::GetEffectMechanic },
-    { "GetEffectImplicitTargetA", &LuaSpellEntry::GetEffectImplicitTargetA },
-    { "GetEffectImplicitTargetB", &LuaSpellEntry::GetEffectImplicitTargetB },
-    { "GetEffectRadiusIndex", &LuaSpellEntry::GetEffectRadiusIndex },
-    { "GetEffectApplyAuraName", &LuaSpellEntry::GetEffectApplyAuraName },
-    { "GetEffectAmplitude", &LuaSpellEntry::GetEffectAmplitude },
-    { "GetEffectValueMultiplier", &LuaSpellEntry::GetEffectValueMultiplier },
-    { "GetEffectChainTarget", &LuaSpellEntry::GetEffectChainTarget },
-    { "GetEffectItemType", &LuaSpellEntry::GetEffectItemType },
-    { "GetEffectMiscValue", &LuaSpellEntry::GetEffectMiscValue },
-    { "GetEffectMiscValueB", &LuaSpellEntry::GetEffectMiscValueB },
-    { "GetEffectTriggerSpell", &LuaSpellEntry::GetEffectTriggerSpell },
-    { "GetEffectPointsPerComboPoint", &LuaSpellEntry::GetEffectPointsPerComboPoint },
-    { "GetEffectSpellClassMask", &LuaSpellEntry::GetEffectSpellClassMask },
-    { "GetSpellVisual", &LuaSpellEntry::GetSpellVisual },
-    { "GetSpellIconID", &LuaSpellEntry::GetSpellIconID },
-    { "GetActiveIconID", &LuaSpellEntry::GetActiveIconID },
-    { "GetSpellPriority", &LuaSpellEntry::GetSpellPriority },
-    { "GetSpellName", &LuaSpellEntry::GetSpellName },
-    { "GetRank", &LuaSpellEntry::GetRank },
-    { "GetManaCostPercentage", &LuaSpellEntry::GetManaCostPercentage },
-    { "GetStartRecoveryCategory", &LuaSpellEntry::GetStartRecoveryCategory },
-    { "GetStartRecoveryTime", &LuaSpellEntry::GetStartRecoveryTime },
-    { "GetMaxTargetLevel", &LuaSpellEntry::GetMaxTargetLevel },
-    { "GetSpellFamilyName", &LuaSpellEntry::GetSpellFamilyName },
-    { "GetSpellFamilyFlags", &LuaSpellEntry::GetSpellFamilyFlags },
-    { "GetMaxAffectedTargets", &LuaSpellEntry::GetMaxAffectedTargets },
-    { "GetDmgClass", &LuaSpellEntry::GetDmgClass },
-    { "GetPreventionType", &LuaSpellEntry::GetPreventionType },
-    { "GetEffectDamageMultiplier", &LuaSpellEntry::GetEffectDamageMultiplier },
-    { "GetTotemCategory", &LuaSpellEntry::GetTotemCategory },
-    { "GetAreaGroupId", &LuaSpellEntry::GetAreaGroupId },
-    { "GetSchoolMask", &LuaSpellEntry::GetSchoolMask },
-    { "GetRuneCostID", &LuaSpellEntry::GetRuneCostID },
-    { "GetEffectBonusMultiplier", &LuaSpellEntry::GetEffectBonusMultiplier },
+    { "GetId", &ElunaMethod<&LuaSpellEntry::GetId>::Call },
+    { "GetCategory", &ElunaMethod<&LuaSpellEntry::GetCategory>::Call },
+    { "GetDispel", &ElunaMethod<&LuaSpellEntry::GetDispel>::Call },
+    { "GetMechanic", &ElunaMethod<&LuaSpellEntry::GetMechanic>::Call },
+    { "GetAttributes", &ElunaMethod<&LuaSpellEntry::GetAttributes>::Call },
+    { "GetAttributesEx", &ElunaMethod<&LuaSpellEntry::GetAttributesEx>::Call },
+    { "GetAttributesEx2", &ElunaMethod<&LuaSpellEntry::GetAttributesEx2>::Call },
+    { "GetAttributesEx3", &ElunaMethod<&LuaSpellEntry::GetAttributesEx3>::Call },
+    { "GetAttributesEx4", &ElunaMethod<&LuaSpellEntry::GetAttributesEx4>::Call },
+    { "GetAttributesEx5", &ElunaMethod<&LuaSpellEntry::GetAttributesEx5>::Call },
+    { "GetAttributesEx6", &ElunaMethod<&LuaSpellEntry::GetAttributesEx6>::Call },
+    { "GetAttributesEx7", &ElunaMethod<&LuaSpellEntry::GetAttributesEx7>::Call },
+    { "GetStances", &ElunaMethod<&LuaSpellEntry::GetStances>::Call },
+    { "GetStancesNot", &ElunaMethod<&LuaSpellEntry::GetStancesNot>::Call },
+    { "GetTargets", &ElunaMethod<&LuaSpellEntry::GetTargets>::Call },
+    { "GetTargetCreatureType", &ElunaMethod<&LuaSpellEntry::GetTargetCreatureType>::Call },
+    { "GetRequiresSpellFocus", &ElunaMethod<&LuaSpellEntry::GetRequiresSpellFocus>::Call },
+    { "GetFacingCasterFlags", &ElunaMethod<&LuaSpellEntry::GetFacingCasterFlags>::Call },
+    { "GetCasterAuraState", &ElunaMethod<&LuaSpellEntry::GetCasterAuraState>::Call },
+    { "GetTargetAuraState", &ElunaMethod<&LuaSpellEntry::GetTargetAuraState>::Call },
+    { "GetCasterAuraStateNot", &ElunaMethod<&LuaSpellEntry::GetCasterAuraStateNot>::Call },
+    { "GetTargetAuraStateNot", &ElunaMethod<&LuaSpellEntry::GetTargetAuraStateNot>::Call },
+    { "GetCasterAuraSpell", &ElunaMethod<&LuaSpellEntry::GetCasterAuraSpell>::Call },
+    { "GetTargetAuraSpell", &ElunaMethod<&LuaSpellEntry::GetTargetAuraSpell>::Call },
+    { "GetExcludeCasterAuraSpell", &ElunaMethod<&LuaSpellEntry::GetExcludeCasterAuraSpell>::Call },
+    { "GetExcludeTargetAuraSpell", &ElunaMethod<&LuaSpellEntry::GetExcludeTargetAuraSpell>::Call },
+    { "GetCastingTimeIndex", &ElunaMethod<&LuaSpellEntry::GetCastingTimeIndex>::Call },
+    { "GetRecoveryTime", &ElunaMethod<&LuaSpellEntry::GetRecoveryTime>::Call },
+    { "GetCategoryRecoveryTime", &ElunaMethod<&LuaSpellEntry::GetCategoryRecoveryTime>::Call },
+    { "GetInterruptFlags", &ElunaMethod<&LuaSpellEntry::GetInterruptFlags>::Call },
+    { "GetAuraInterruptFlags", &ElunaMethod<&LuaSpellEntry::GetAuraInterruptFlags>::Call },
+    { "GetChannelInterruptFlags", &ElunaMethod<&LuaSpellEntry::GetChannelInterruptFlags>::Call },
+    { "GetProcFlags", &ElunaMethod<&LuaSpellEntry::GetProcFlags>::Call },
+    { "GetProcChance", &ElunaMethod<&LuaSpellEntry::GetProcChance>::Call },
+    { "GetProcCharges", &ElunaMethod<&LuaSpellEntry::GetProcCharges>::Call },
+    { "GetMaxLevel", &ElunaMethod<&LuaSpellEntry::GetMaxLevel>::Call },
+    { "GetBaseLevel", &ElunaMethod<&LuaSpellEntry::GetBaseLevel>::Call },
+    { "GetSpellLevel", &ElunaMethod<&LuaSpellEntry::GetSpellLevel>::Call },
+    { "GetDurationIndex", &ElunaMethod<&LuaSpellEntry::GetDurationIndex>::Call },
+    { "GetPowerType", &ElunaMethod<&LuaSpellEntry::GetPowerType>::Call },
+    { "GetManaCost", &ElunaMethod<&LuaSpellEntry::GetManaCost>::Call },
+    { "GetManaCostPerlevel", &ElunaMethod<&LuaSpellEntry::GetManaCostPerlevel>::Call },
+    { "GetManaPerSecond", &ElunaMethod<&LuaSpellEntry::GetManaPerSecond>::Call },
+    { "GetManaPerSecondPerLevel", &ElunaMethod<&LuaSpellEntry::GetManaPerSecondPerLevel>::Call },
+    { "GetRangeIndex", &ElunaMethod<&LuaSpellEntry::GetRangeIndex>::Call },
+    { "GetSpeed", &ElunaMethod<&LuaSpellEntry::GetSpeed>::Call },
+    { "GetStackAmount", &ElunaMethod<&LuaSpellEntry::GetStackAmount>::Call },
+    { "GetTotem", &ElunaMethod<&LuaSpellEntry::GetTotem>::Call },
+    { "GetReagent", &ElunaMethod<&LuaSpellEntry::GetReagent>::Call },
+    { "GetReagentCount", &ElunaMethod<&LuaSpellEntry::GetReagentCount>::Call },
+    { "GetEquippedItemClass", &ElunaMethod<&LuaSpellEntry::GetEquippedItemClass>::Call },
+    { "GetEquippedItemSubClassMask", &ElunaMethod<&LuaSpellEntry::GetEquippedItemSubClassMask>::Call },
+    { "GetEquippedItemInventoryTypeMask", &ElunaMethod<&LuaSpellEntry::GetEquippedItemInventoryTypeMask>::Call },
+    { "GetEffect", &ElunaMethod<&LuaSpellEntry::GetEffect>::Call },
+    { "GetEffectDieSides", &ElunaMethod<&LuaSpellEntry::GetEffectDieSides>::Call },
+    { "GetEffectRealPointsPerLevel", &ElunaMethod<&LuaSpellEntry::GetEffectRealPointsPerLevel>::Call },
+    { "GetEffectBasePoints", &ElunaMethod<&LuaSpellEntry::GetEffectBasePoints>::Call },
+    { "GetEffectMechanic", &ElunaMethod<&LuaSpellEntry::GetEffectMechanic>::Call },
+    { "GetEffectImplicitTargetA", &ElunaMethod<&LuaSpellEntry::GetEffectImplicitTargetA>::Call },
+    { "GetEffectImplicitTargetB", &ElunaMethod<&LuaSpellEntry::GetEffectImplicitTargetB>::Call },
+    { "GetEffectRadiusIndex", &ElunaMethod<&LuaSpellEntry::GetEffectRadiusIndex>::Call },
+    { "GetEffectApplyAuraName", &ElunaMethod<&LuaSpellEntry::GetEffectApplyAuraName>::Call },
+    { "GetEffectAmplitude", &ElunaMethod<&LuaSpellEntry::GetEffectAmplitude>::Call },
+    { "GetEffectValueMultiplier", &ElunaMethod<&LuaSpellEntry::GetEffectValueMultiplier>::Call },
+    { "GetEffectChainTarget", &ElunaMethod<&LuaSpellEntry::GetEffectChainTarget>::Call },
+    { "GetEffectItemType", &ElunaMethod<&LuaSpellEntry::GetEffectItemType>::Call },
+    { "GetEffectMiscValue", &ElunaMethod<&LuaSpellEntry::GetEffectMiscValue>::Call },
+    { "GetEffectMiscValueB", &ElunaMethod<&LuaSpellEntry::GetEffectMiscValueB>::Call },
+    { "GetEffectTriggerSpell", &ElunaMethod<&LuaSpellEntry::GetEffectTriggerSpell>::Call },
+    { "GetEffectPointsPerComboPoint", &ElunaMethod<&LuaSpellEntry::GetEffectPointsPerComboPoint>::Call },
+    { "GetEffectSpellClassMask", &ElunaMethod<&LuaSpellEntry::GetEffectSpellClassMask>::Call },
+    { "GetSpellVisual", &ElunaMethod<&LuaSpellEntry::GetSpellVisual>::Call },
+    { "GetSpellIconID", &ElunaMethod<&LuaSpellEntry::GetSpellIconID>::Call },
+    { "GetActiveIconID", &ElunaMethod<&LuaSpellEntry::GetActiveIconID>::Call },
+    { "GetSpellPriority", &ElunaMethod<&LuaSpellEntry::GetSpellPriority>::Call },
+    { "GetSpellName", &ElunaMethod<&LuaSpellEntry::GetSpellName>::Call },
+    { "GetRank", &ElunaMethod<&LuaSpellEntry::GetRank>::Call },
+    { "GetManaCostPercentage", &ElunaMethod<&LuaSpellEntry::GetManaCostPercentage>::Call },
+    { "GetStartRecoveryCategory", &ElunaMethod<&LuaSpellEntry::GetStartRecoveryCategory>::Call },
+    { "GetStartRecoveryTime", &ElunaMethod<&LuaSpellEntry::GetStartRecoveryTime>::Call },
+    { "GetMaxTargetLevel", &ElunaMethod<&LuaSpellEntry::GetMaxTargetLevel>::Call },
+    { "GetSpellFamilyName", &ElunaMethod<&LuaSpellEntry::GetSpellFamilyName>::Call },
+    { "GetSpellFamilyFlags", &ElunaMethod<&LuaSpellEntry::GetSpellFamilyFlags>::Call },
+    { "GetMaxAffectedTargets", &ElunaMethod<&LuaSpellEntry::GetMaxAffectedTargets>::Call },
+    { "GetDmgClass", &ElunaMethod<&LuaSpellEntry::GetDmgClass>::Call },
+    { "GetPreventionType", &ElunaMethod<&LuaSpellEntry::GetPreventionType>::Call },
+    { "GetEffectDamageMultiplier", &ElunaMethod<&LuaSpellEntry::GetEffectDamageMultiplier>::Call },
+    { "GetTotemCategory", &ElunaMethod<&LuaSpellEntry::GetTotemCategory>::Call },
+    { "GetAreaGroupId", &ElunaMethod<&LuaSpellEntry::GetAreaGroupId>::Call },
+    { "GetSchoolMask", &ElunaMethod<&LuaSpellEntry::GetSchoolMask>::Call },
+    { "GetRuneCostID", &ElunaMethod<&LuaSpellEntry::GetRuneCostID>::Call },
+    { "GetEffectBonusMultiplier", &ElunaMethod<&LuaSpellEntry::GetEffectBonusMultiplier>::Call },
 
     { NULL, NULL }
 };
@@ -1554,7 +1585,8 @@ template<> int ElunaTemplate<Vehicle>::CollectGarbage(lua_State* L)
 
     // Get object pointer (and check type, no error)
     ElunaObject* obj = Eluna::CHECKOBJ<ElunaObject>(L, 1, false);
-    delete obj;
+    if (obj)
+        obj->~ElunaObject();
     return 0;
 }
 
@@ -1686,6 +1718,9 @@ void RegisterFunctions(Eluna* E)
     ElunaTemplate<ElunaQuery>::Register(E, "ElunaQuery", true);
     ElunaTemplate<ElunaQuery>::SetMethods(E, QueryMethods);
 
+    ElunaTemplate<ElunaTextMatcher>::Register(E, "TextMatcher", true);
+    ElunaTemplate<ElunaTextMatcher>::SetMethods(E, TextMatcherMethods);
+
     ElunaTemplate<AchievementEntry>::Register(E, "AchievementEntry");
     ElunaTemplate<AchievementEntry>::SetMethods(E, AchievementMethods);
 
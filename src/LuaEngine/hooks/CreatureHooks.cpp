@@ -21,7 +21,7 @@ using namespace Hooks;
     if (!CreatureEventBindings->HasBindingsFor(entry_key))\
         if (!CreatureUniqueBindings->HasBindingsFor(unique_key))\
             return;\
-    LOCK_ELUNA
+    LOCK_ELUNA_STATE(this)
 
 #define START_HOOK_WITH_RETVAL(EVENT, CREATURE, RETVAL) \
     if (!IsEnabled())\
@@ -31,7 +31,7 @@ using namespace Hooks;
     if (!CreatureEventBindings->HasBindingsFor(entry_key))\
         if (!CreatureUniqueBindings->HasBindingsFor(unique_key))\
             return RETVAL;\
-    LOCK_ELUNA
+    LOCK_ELUNA_STATE(this)
 
 void Eluna::OnDummyEffect(WorldObject* pCaster, uint32 spellId, SpellEffIndex effIndex, Creature* pTarget)
 {
@@ -136,6 +136,9 @@ bool Eluna::DamageTaken(Creature* me, Unit* attacker, uint32& damage)
         }
 
         lua_pop(L, 2);
+
+        if (result && StopsDispatch(n))
+            break;
     }
 
     CleanUpStack(3);
@@ -259,6 +262,9 @@ bool Eluna::CorpseRemoved(Creature* me, uint32& respawnDelay)
         }
 
         lua_pop(L, 2);
+
+        if (result && StopsDispatch(n))
+            break;
     }
 
     CleanUpStack(2);
@@ -18,10 +18,15 @@ using namespace Hooks;
     auto key = EventKey<GroupEvents>(EVENT);\
     if (!GroupEventBindings->HasBindingsFor(key))\
         return;\
-    LOCK_ELUNA
+    LOCK_ELUNA_STATE(this)
+
+#define DEFER_HOOK(EVENT, ...) \
+    if (IsEnabled() && GroupEventDeferredBindings->HasBindingsFor(EventKey<GroupEvents>(EVENT)))\
+        QueueDeferredHook(DeferredHook(REGTYPE_GROUP, EVENT, { __VA_ARGS__ }))
 
 void Eluna::OnAddMember(Group* group, ObjectGuid guid)
 {
+    DEFER_HOOK(GROUP_EVENT_ON_MEMBER_ADD, group, guid);
     START_HOOK(GROUP_EVENT_ON_MEMBER_ADD);
     Push(group);
     Push(guid);
@@ -30,6 +35,7 @@ void Eluna::OnAddMember(Group* group, ObjectGuid guid)
 
 void Eluna::OnInviteMember(Group* group, ObjectGuid guid)
 {
+    DEFER_HOOK(GROUP_EVENT_ON_MEMBER_INVITE, group, guid);
     START_HOOK(GROUP_EVENT_ON_MEMBER_INVITE);
     Push(group);
     Push(guid);
@@ -38,6 +44,7 @@ void Eluna::OnInviteMember(Group* group, ObjectGuid guid)
 
 void Eluna::OnRemoveMember(Group* group, ObjectGuid guid, uint8 method)
 {
+    DEFER_HOOK(GROUP_EVENT_ON_MEMBER_REMOVE, group, guid, method);
     START_HOOK(GROUP_EVENT_ON_MEMBER_REMOVE);
     Push(group);
     Push(guid);
@@ -47,6 +54,7 @@ void Eluna::OnRemoveMember(Group* group, ObjectGuid guid, uint8 method)
 
 void Eluna::OnChangeLeader(Group* group, ObjectGuid newLeaderGuid, ObjectGuid oldLeaderGuid)
 {
+    DEFER_HOOK(GROUP_EVENT_ON_LEADER_CHANGE, group, newLeaderGuid, oldLeaderGuid);
     START_HOOK(GROUP_EVENT_ON_LEADER_CHANGE);
     Push(group);
     Push(newLeaderGuid);
@@ -56,6 +64,7 @@ void Eluna::OnChangeLeader(Group* group, ObjectGuid newLeaderGuid, ObjectGuid ol
 
 void Eluna::OnDisband(Group* group)
 {
+    DEFER_HOOK(GROUP_EVENT_ON_DISBAND, group);
     START_HOOK(GROUP_EVENT_ON_DISBAND);
     Push(group);
     CallAllFunctions(GroupEventBindings, key);
@@ -63,6 +72,7 @@ void Eluna::OnDisband(Group* group)
 
 void Eluna::OnCreate(Group* group, ObjectGuid leaderGuid, GroupType groupType)
 {
+    DEFER_HOOK(GROUP_EVENT_ON_CREATE, group, leaderGuid, groupType);
     START_HOOK(GROUP_EVENT_ON_CREATE);
     Push(group);
     Push(leaderGuid);
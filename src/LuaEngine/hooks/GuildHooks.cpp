@@ -18,10 +18,15 @@ using namespace Hooks;
     auto key = EventKey<GuildEvents>(EVENT);\
     if (!GuildEventBindings->HasBindingsFor(key))\
         return;\
-    LOCK_ELUNA
+    LOCK_ELUNA_STATE(this)
+
+#define DEFER_HOOK(EVENT, ...) \
+    if (IsEnabled() && GuildEventDeferredBindings->HasBindingsFor(EventKey<GuildEvents>(EVENT)))\
+        QueueDeferredHook(DeferredHook(REGTYPE_GUILD, EVENT, { __VA_ARGS__ }))
 
 void Eluna::OnAddMember(Guild* guild, Player* player, uint32 plRank)
 {
+    DEFER_HOOK(GUILD_EVENT_ON_ADD_MEMBER, guild, player, plRank);
     START_HOOK(GUILD_EVENT_ON_ADD_MEMBER);
     Push(guild);
     Push(player);
@@ -31,6 +36,7 @@ void Eluna::OnAddMember(Guild* guild, Player* player, uint32 plRank)
 
 void Eluna::OnRemoveMember(Guild* guild, Player* player, bool isDisbanding)
 {
+    DEFER_HOOK(GUILD_EVENT_ON_REMOVE_MEMBER, guild, player, isDisbanding);
     START_HOOK(GUILD_EVENT_ON_REMOVE_MEMBER);
     Push(guild);
     Push(player);
@@ -40,6 +46,7 @@ void Eluna::OnRemoveMember(Guild* guild, Player* player, bool isDisbanding)
 
 void Eluna::OnMOTDChanged(Guild* guild, const std::string& newMotd)
 {
+    DEFER_HOOK(GUILD_EVENT_ON_MOTD_CHANGE, guild, newMotd);
     START_HOOK(GUILD_EVENT_ON_MOTD_CHANGE);
     Push(guild);
     Push(newMotd);
@@ -48,6 +55,7 @@ void Eluna::OnMOTDChanged(Guild* guild, const std::string& newMotd)
 
 void Eluna::OnInfoChanged(Guild* guild, const std::string& newInfo)
 {
+    DEFER_HOOK(GUILD_EVENT_ON_INFO_CHANGE, guild, newInfo);
     START_HOOK(GUILD_EVENT_ON_INFO_CHANGE);
     Push(guild);
     Push(newInfo);
@@ -56,6 +64,7 @@ void Eluna::OnInfoChanged(Guild* guild, const std::string& newInfo)
 
 void Eluna::OnCreate(Guild* guild, Player* leader, const std::string& name)
 {
+    DEFER_HOOK(GUILD_EVENT_ON_CREATE, guild, leader, name);
     START_HOOK(GUILD_EVENT_ON_CREATE);
     Push(guild);
     Push(leader);
@@ -65,6 +74,7 @@ void Eluna::OnCreate(Guild* guild, Player* leader, const std::string& name)
 
 void Eluna::OnDisband(Guild* guild)
 {
+    DEFER_HOOK(GUILD_EVENT_ON_DISBAND, guild);
     START_HOOK(GUILD_EVENT_ON_DISBAND);
     Push(guild);
     CallAllFunctions(GuildEventBindings, key);
@@ -141,6 +151,7 @@ void Eluna::OnItemMove(Guild* guild, Player* player, Item* pItem, bool isSrcBank
 
 void Eluna::OnEvent(Guild* guild, uint8 eventType, uint32 playerGuid1, uint32 playerGuid2, uint8 newRank)
 {
+    DEFER_HOOK(GUILD_EVENT_ON_EVENT, guild, eventType, playerGuid1, playerGuid2, newRank);
     START_HOOK(GUILD_EVENT_ON_EVENT);
     Push(guild);
     Push(eventType);
@@ -152,6 +163,7 @@ void Eluna::OnEvent(Guild* guild, uint8 eventType, uint32 playerGuid1, uint32 pl
 
 void Eluna::OnBankEvent(Guild* guild, uint8 eventType, uint8 tabId, uint32 playerGuid, uint32 itemOrMoney, uint16 itemStackCount, uint8 destTabId)
 {
+    DEFER_HOOK(GUILD_EVENT_ON_BANK_EVENT, guild, eventType, tabId, playerGuid, itemOrMoney, itemStackCount, destTabId);
     START_HOOK(GUILD_EVENT_ON_BANK_EVENT);
     Push(guild);
     Push(eventType);
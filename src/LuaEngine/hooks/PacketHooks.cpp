@@ -13,13 +13,14 @@
 
 using namespace Hooks;
 
-#define START_HOOK_SERVER(EVENT) \
+#define START_HOOK_SERVER(EVENT, OPCODE) \
     if (!IsEnabled())\
         return;\
     auto key = EventKey<ServerEvents>(EVENT);\
-    if (!ServerEventBindings->HasBindingsFor(key))\
+    BindingFilterArgs filter = BindingFilterArgs().Set(BINDING_FILTER_OPCODE, OPCODE);\
+    if (!ServerEventBindings->HasBindingsFor(key, filter))\
         return;\
-    LOCK_ELUNA
+    LOCK_ELUNA_STATE(this)
 
 #define START_HOOK_PACKET(EVENT, OPCODE) \
     if (!IsEnabled())\
@@ -27,7 +28,14 @@ using namespace Hooks;
     auto key = EntryKey<PacketEvents>(EVENT, OPCODE);\
     if (!PacketEventBindings->HasBindingsFor(key))\
         return;\
-    LOCK_ELUNA
+    LOCK_ELUNA_STATE(this)
+
+/*
+ * Handlers get a read-only view of the packet instead of a copy, see LuaPacket::Writable.
+ *
+ * Reading from the view moves the read position of the server's packet,
+ *   so it is put back once the handlers are done.
+ */
 
 bool Eluna::OnPacketSend(WorldSession* session, const WorldPacket& packet)
 {
@@ -41,10 +49,11 @@ bool Eluna::OnPacketSend(WorldSession* session, const WorldPacket& packet)
 }
 void Eluna::OnPacketSendAny(Player* player, const WorldPacket& packet, bool& result)
 {
-    START_HOOK_SERVER(SERVER_EVENT_ON_PACKET_SEND);
-    Push(new WorldPacket(packet));
+    START_HOOK_SERVER(SERVER_EVENT_ON_PACKET_SEND, packet.GetOpcode());
+    size_t rpos = packet.rpos();
+    ElunaObject* view = PushView(&packet);
     Push(player);
-    int n = SetupStack(ServerEventBindings, key, 2);
+    int n = SetupStack(ServerEventBindings, key, 2, &filter);
 
     while (n > 0)
     {
@@ -54,15 +63,23 @@ void Eluna::OnPacketSendAny(Player* player, const WorldPacket& packet, bool& res
             result = false;
 
         lua_pop(L, 1);
+
+        if (!result && StopsDispatch(n))
+            break;
     }
 
+    // CleanUpStack doesn't invalidate objects of nested hooks, and the packet may not outlive this one
+    if (view)
+        view->Invalidate();
     CleanUpStack(2);
+    const_cast<WorldPacket&>(packet).rpos(rpos);
 }
 
 void Eluna::OnPacketSendOne(Player* player, const WorldPacket& packet, bool& result)
 {
     START_HOOK_PACKET(PACKET_EVENT_ON_PACKET_SEND, packet.GetOpcode());
-    Push(new WorldPacket(packet));
+    size_t rpos = packet.rpos();
+    ElunaObject* view = PushView(&packet);
     Push(player);
     int n = SetupStack(PacketEventBindings, key, 2);
 
@@ -74,9 +91,16 @@ void Eluna::OnPacketSendOne(Player* player, const WorldPacket& packet, bool& res
             result = false;
 
         lua_pop(L, 1);
+
+        if (!result && StopsDispatch(n))
+            break;
     }
 
+    // CleanUpStack doesn't invalidate objects of nested hooks, and the packet may not outlive this one
+    if (view)
+        view->Invalidate();
     CleanUpStack(2);
+    const_cast<WorldPacket&>(packet).rpos(rpos);
 }
 
 bool Eluna::OnPacketReceive(WorldSession* session, WorldPacket& packet)
@@ -92,10 +116,11 @@ bool Eluna::OnPacketReceive(WorldSession* session, WorldPacket& packet)
 
 void Eluna::OnPacketReceiveAny(Player* player, WorldPacket& packet, bool& result)
 {
-    START_HOOK_SERVER(SERVER_EVENT_ON_PACKET_RECEIVE);
-    Push(new WorldPacket(packet));
+    START_HOOK_SERVER(SERVER_EVENT_ON_PACKET_RECEIVE, packet.GetOpcode());
+    size_t rpos = packet.rpos();
+    ElunaObject* view = PushView(&packet);
     Push(player);
-    int n = SetupStack(ServerEventBindings, key, 2);
+    int n = SetupStack(ServerEventBindings, key, 2, &filter);
 
     while (n > 0)
     {
@@ -104,20 +129,33 @@ void Eluna::OnPacketReceiveAny(Player* player, WorldPacket& packet, bool& result
         if (lua_isboolean(L, r + 0) && !lua_toboolean(L, r + 0))
             result = false;
 
+        // Returning the view itself doesn't replace anything
         if (lua_isuserdata(L, r + 1))
             if (WorldPacket* data = CHECKOBJ<WorldPacket>(L, r + 1, false))
-                packet = *data;
+                if (data != &packet)
+                {
+                    packet = *data;
+                    rpos = packet.rpos();
+                }
 
         lua_pop(L, 2);
+
+        if (!result && StopsDispatch(n))
+            break;
     }
 
+    // CleanUpStack doesn't invalidate objects of nested hooks, and the packet may not outlive this one
+    if (view)
+        view->Invalidate();
     CleanUpStack(2);
+    packet.rpos(rpos);
 }
 
 void Eluna::OnPacketReceiveOne(Player* player, WorldPacket& packet, bool& result)
 {
     START_HOOK_PACKET(PACKET_EVENT_ON_PACKET_RECEIVE, packet.GetOpcode());
-    Push(new WorldPacket(packet));
+    size_t rpos = packet.rpos();
+    ElunaObject* view = PushView(&packet);
     Push(player);
     int n = SetupStack(PacketEventBindings, key, 2);
 
@@ -128,12 +166,24 @@ void Eluna::OnPacketReceiveOne(Player* player, WorldPacket& packet, bool& result
         if (lua_isboolean(L, r + 0) && !lua_toboolean(L, r + 0))
             result = false;
 
+        // Returning the view itself doesn't replace anything
         if (lua_isuserdata(L, r + 1))
             if (WorldPacket* data = CHECKOBJ<WorldPacket>(L, r + 1, false))
-                packet = *data;
+                if (data != &packet)
+                {
+                    packet = *data;
+                    rpos = packet.rpos();
+                }
 
         lua_pop(L, 2);
+
+        if (!result && StopsDispatch(n))
+            break;
     }
 
+    // CleanUpStack doesn't invalidate objects of nested hooks, and the packet may not outlive this one
+    if (view)
+        view->Invalidate();
     CleanUpStack(2);
+    packet.rpos(rpos);
 }
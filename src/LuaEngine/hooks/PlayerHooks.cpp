@@ -8,6 +8,7 @@
 #include "HookHelpers.h"
 #include "LuaEngine.h"
 #include "BindingMap.h"
+#include "CommandTrie.h"
 #include "ElunaIncludes.h"
 #include "ElunaTemplate.h"
 
@@ -19,7 +20,7 @@ using namespace Hooks;
     auto key = EventKey<PlayerEvents>(EVENT);\
     if (!PlayerEventBindings->HasBindingsFor(key))\
         return;\
-    LOCK_ELUNA
+    LOCK_ELUNA_STATE(this)
 
 #define START_HOOK_WITH_RETVAL(EVENT, RETVAL) \
     if (!IsEnabled())\
@@ -27,7 +28,35 @@ using namespace Hooks;
     auto key = EventKey<PlayerEvents>(EVENT);\
     if (!PlayerEventBindings->HasBindingsFor(key))\
         return RETVAL;\
-    LOCK_ELUNA
+    LOCK_ELUNA_STATE(this)
+
+#define START_HOOK_FILTERED(EVENT, FILTER) \
+    if (!IsEnabled())\
+        return;\
+    auto key = EventKey<PlayerEvents>(EVENT);\
+    if (!PlayerEventBindings->HasBindingsFor(key, FILTER))\
+        return;\
+    LOCK_ELUNA_STATE(this)
+
+#define START_HOOK_FILTERED_WITH_RETVAL(EVENT, FILTER, RETVAL) \
+    if (!IsEnabled())\
+        return RETVAL;\
+    auto key = EventKey<PlayerEvents>(EVENT);\
+    if (!PlayerEventBindings->HasBindingsFor(key, FILTER))\
+        return RETVAL;\
+    LOCK_ELUNA_STATE(this)
+
+#define DEFER_HOOK(EVENT, ...) \
+    if (IsEnabled() && PlayerEventDeferredBindings->HasBindingsFor(EventKey<PlayerEvents>(EVENT)))\
+        QueueDeferredHook(DeferredHook(REGTYPE_PLAYER, EVENT, { __VA_ARGS__ }))
+
+// Filter arguments for the location of `player`
+static BindingFilterArgs PlayerFilter(const Player* player)
+{
+    return BindingFilterArgs()
+        .Set(BINDING_FILTER_ZONE, player->GetZoneId())
+        .Set(BINDING_FILTER_MAP, player->GetMapId());
+}
 
 void Eluna::OnLearnTalents(Player* pPlayer, uint32 talentId, uint32 talentRank, uint32 spellid)
 {
@@ -45,13 +74,51 @@ bool Eluna::OnCommand(ChatHandler& handler, const char* text)
     // If from console, player is NULL
     if (!player || player->GetSession()->GetSecurity() >= SEC_ADMINISTRATOR)
     {
-        std::string reload = text;
-        std::transform(reload.begin(), reload.end(), reload.begin(), ::tolower);
-        if (reload.find("reload eluna") == 0)
+        // Compared in place, the command text is not copied
+        static const char reload[] = "reload eluna";
+        size_t i = 0;
+        while (reload[i] && std::tolower(static_cast<unsigned char>(text[i])) == reload[i])
+            ++i;
+        if (!reload[i])
         {
             ReloadEluna();
             return false;
         }
+
+        if (HandleElunaCommand(handler, text))
+            return false;
+    }
+
+    if (!IsEnabled())
+        return true;
+
+    // Commands registered with RegisterCommand are handled here and don't reach the core
+    // Handlers are filtered by the security level they were registered with, the console has the highest
+    CommandTrie::Key commandKey;
+    const char* args;
+    BindingFilterArgs security = BindingFilterArgs().Set(BINDING_FILTER_SECURITY, player ? uint32(player->GetSession()->GetSecurity()) : uint32(SEC_CONSOLE));
+    auto hasHandlers = [this, &security](const CommandTrie::Key& key)
+    {
+        return CommandBindings->HasMatchingBindingsFor(key, security);
+    };
+    if (Commands->Match(text, commandKey, args, hasHandlers))
+    {
+        LOCK_ELUNA_STATE(this);
+        Push(player);
+
+        lua_newtable(L);
+        int index = 0;
+        CommandTrie::Tokenize(args, [this, &index](const char* token, size_t length)
+        {
+            lua_pushlstring(L, token, length);
+            lua_rawseti(L, -2, ++index);
+            return true;
+        });
+        ++push_counter;
+
+        Push(&handler);
+        CallAllFunctions(CommandBindings, commandKey, &security);
+        return false;
     }
 
     START_HOOK_WITH_RETVAL(PLAYER_EVENT_ON_COMMAND, true);
@@ -63,16 +130,19 @@ bool Eluna::OnCommand(ChatHandler& handler, const char* text)
 
 void Eluna::OnLootItem(Player* pPlayer, Item* pItem, uint32 count, ObjectGuid guid)
 {
-    START_HOOK(PLAYER_EVENT_ON_LOOT_ITEM);
+    DEFER_HOOK(PLAYER_EVENT_ON_LOOT_ITEM, pPlayer, pItem, count, guid);
+    BindingFilterArgs filter = PlayerFilter(pPlayer).Set(BINDING_FILTER_ENTRY, pItem->GetEntry());
+    START_HOOK_FILTERED(PLAYER_EVENT_ON_LOOT_ITEM, filter);
     Push(pPlayer);
     Push(pItem);
     Push(count);
     Push(guid);
-    CallAllFunctions(PlayerEventBindings, key);
+    CallAllFunctions(PlayerEventBindings, key, &filter);
 }
 
 void Eluna::OnLootMoney(Player* pPlayer, uint32 amount)
 {
+    DEFER_HOOK(PLAYER_EVENT_ON_LOOT_MONEY, pPlayer, amount);
     START_HOOK(PLAYER_EVENT_ON_LOOT_MONEY);
     Push(pPlayer);
     Push(amount);
@@ -81,6 +151,7 @@ void Eluna::OnLootMoney(Player* pPlayer, uint32 amount)
 
 void Eluna::OnFirstLogin(Player* pPlayer)
 {
+    DEFER_HOOK(PLAYER_EVENT_ON_FIRST_LOGIN, pPlayer);
     START_HOOK(PLAYER_EVENT_ON_FIRST_LOGIN);
     Push(pPlayer);
     CallAllFunctions(PlayerEventBindings, key);
@@ -110,21 +181,23 @@ void Eluna::OnQuestAbandon(Player* pPlayer, uint32 questId)
 
 void Eluna::OnEquip(Player* pPlayer, Item* pItem, uint8 bag, uint8 slot)
 {
-    START_HOOK(PLAYER_EVENT_ON_EQUIP);
+    BindingFilterArgs filter = PlayerFilter(pPlayer).Set(BINDING_FILTER_ENTRY, pItem->GetEntry());
+    START_HOOK_FILTERED(PLAYER_EVENT_ON_EQUIP, filter);
     Push(pPlayer);
     Push(pItem);
     Push(bag);
     Push(slot);
-    CallAllFunctions(PlayerEventBindings, key);
+    CallAllFunctions(PlayerEventBindings, key, &filter);
 }
 
 InventoryResult Eluna::OnCanUseItem(const Player* pPlayer, uint32 itemEntry)
 {
-    START_HOOK_WITH_RETVAL(PLAYER_EVENT_ON_CAN_USE_ITEM, EQUIP_ERR_OK);
+    BindingFilterArgs filter = BindingFilterArgs().Set(BINDING_FILTER_ENTRY, itemEntry);
+    START_HOOK_FILTERED_WITH_RETVAL(PLAYER_EVENT_ON_CAN_USE_ITEM, filter, EQUIP_ERR_OK);
     InventoryResult result = EQUIP_ERR_OK;
     Push(pPlayer);
     Push(itemEntry);
-    int n = SetupStack(PlayerEventBindings, key, 2);
+    int n = SetupStack(PlayerEventBindings, key, 2, &filter);
 
     while (n > 0)
     {
@@ -134,6 +207,9 @@ InventoryResult Eluna::OnCanUseItem(const Player* pPlayer, uint32 itemEntry)
             result = (InventoryResult)CHECKVAL<uint32>(L, r);
 
         lua_pop(L, 1);
+
+        if (result != EQUIP_ERR_OK && StopsDispatch(n))
+            break;
     }
 
     CleanUpStack(2);
@@ -164,22 +240,25 @@ void Eluna::OnPVPKill(Player* pKiller, Player* pKilled)
 
 void Eluna::OnCreatureKill(Player* pKiller, Creature* pKilled)
 {
-    START_HOOK(PLAYER_EVENT_ON_KILL_CREATURE);
+    BindingFilterArgs filter = PlayerFilter(pKiller).Set(BINDING_FILTER_ENTRY, pKilled->GetEntry());
+    START_HOOK_FILTERED(PLAYER_EVENT_ON_KILL_CREATURE, filter);
     Push(pKiller);
     Push(pKilled);
-    CallAllFunctions(PlayerEventBindings, key);
+    CallAllFunctions(PlayerEventBindings, key, &filter);
 }
 
 void Eluna::OnPlayerKilledByCreature(Creature* pKiller, Player* pKilled)
 {
-    START_HOOK(PLAYER_EVENT_ON_KILLED_BY_CREATURE);
+    BindingFilterArgs filter = PlayerFilter(pKilled).Set(BINDING_FILTER_ENTRY, pKiller->GetEntry());
+    START_HOOK_FILTERED(PLAYER_EVENT_ON_KILLED_BY_CREATURE, filter);
     Push(pKiller);
     Push(pKilled);
-    CallAllFunctions(PlayerEventBindings, key);
+    CallAllFunctions(PlayerEventBindings, key, &filter);
 }
 
 void Eluna::OnLevelChanged(Player* pPlayer, uint8 oldLevel)
 {
+    DEFER_HOOK(PLAYER_EVENT_ON_LEVEL_CHANGE, pPlayer, oldLevel);
     START_HOOK(PLAYER_EVENT_ON_LEVEL_CHANGE);
     Push(pPlayer);
     Push(oldLevel);
@@ -279,6 +358,9 @@ bool Eluna::OnReputationChange(Player* pPlayer, uint32 factionID, int32& standin
         }
 
         lua_pop(L, 1);
+
+        if (!result && StopsDispatch(n))
+            break;
     }
 
     CleanUpStack(4);
@@ -330,15 +412,17 @@ void Eluna::OnTextEmote(Player* pPlayer, uint32 textEmote, uint32 emoteNum, Obje
 
 void Eluna::OnPlayerSpellCast(Player* pPlayer, Spell* pSpell, bool skipCheck)
 {
-    START_HOOK(PLAYER_EVENT_ON_SPELL_CAST);
+    BindingFilterArgs filter = PlayerFilter(pPlayer).Set(BINDING_FILTER_SPELL, pSpell->GetSpellInfo()->Id);
+    START_HOOK_FILTERED(PLAYER_EVENT_ON_SPELL_CAST, filter);
     Push(pPlayer);
     Push(pSpell);
     Push(skipCheck);
-    CallAllFunctions(PlayerEventBindings, key);
+    CallAllFunctions(PlayerEventBindings, key, &filter);
 }
 
 void Eluna::OnLogin(Player* pPlayer)
 {
+    DEFER_HOOK(PLAYER_EVENT_ON_LOGIN, pPlayer);
     START_HOOK(PLAYER_EVENT_ON_LOGIN);
     Push(pPlayer);
     CallAllFunctions(PlayerEventBindings, key);
@@ -346,6 +430,7 @@ void Eluna::OnLogin(Player* pPlayer)
 
 void Eluna::OnLogout(Player* pPlayer)
 {
+    DEFER_HOOK(PLAYER_EVENT_ON_LOGOUT, pPlayer);
     START_HOOK(PLAYER_EVENT_ON_LOGOUT);
     Push(pPlayer);
     CallAllFunctions(PlayerEventBindings, key);
@@ -393,18 +478,20 @@ void Eluna::OnUpdateArea(Player* pPlayer, uint32 oldArea, uint32 newArea)
 
 void Eluna::OnUpdateZone(Player* pPlayer, uint32 newZone, uint32 newArea)
 {
-    START_HOOK(PLAYER_EVENT_ON_UPDATE_ZONE);
+    BindingFilterArgs filter = PlayerFilter(pPlayer).Set(BINDING_FILTER_ZONE, newZone);
+    START_HOOK_FILTERED(PLAYER_EVENT_ON_UPDATE_ZONE, filter);
     Push(pPlayer);
     Push(newZone);
     Push(newArea);
-    CallAllFunctions(PlayerEventBindings, key);
+    CallAllFunctions(PlayerEventBindings, key, &filter);
 }
 
 void Eluna::OnMapChanged(Player* player)
 {
-    START_HOOK(PLAYER_EVENT_ON_MAP_CHANGE);
+    BindingFilterArgs filter = PlayerFilter(player);
+    START_HOOK_FILTERED(PLAYER_EVENT_ON_MAP_CHANGE, filter);
     Push(player);
-    CallAllFunctions(PlayerEventBindings, key);
+    CallAllFunctions(PlayerEventBindings, key, &filter);
 }
 
 bool Eluna::OnChat(Player* pPlayer, uint32 type, uint32 lang, std::string& msg)
@@ -431,6 +518,9 @@ bool Eluna::OnChat(Player* pPlayer, uint32 type, uint32 lang, std::string& msg)
             msg = std::string(lua_tostring(L, r + 1));
 
         lua_pop(L, 2);
+
+        if (!result && StopsDispatch(n))
+            break;
     }
 
     CleanUpStack(4);
@@ -462,6 +552,9 @@ bool Eluna::OnChat(Player* pPlayer, uint32 type, uint32 lang, std::string& msg,
             msg = std::string(lua_tostring(L, r + 1));
 
         lua_pop(L, 2);
+
+        if (!result && StopsDispatch(n))
+            break;
     }
 
     CleanUpStack(5);
@@ -493,6 +586,9 @@ bool Eluna::OnChat(Player* pPlayer, uint32 type, uint32 lang, std::string& msg,
             msg = std::string(lua_tostring(L, r + 1));
 
         lua_pop(L, 2);
+
+        if (!result && StopsDispatch(n))
+            break;
     }
 
     CleanUpStack(5);
@@ -524,6 +620,9 @@ bool Eluna::OnChat(Player* pPlayer, uint32 type, uint32 lang, std::string& msg,
             msg = std::string(lua_tostring(L, r + 1));
 
         lua_pop(L, 2);
+
+        if (!result && StopsDispatch(n))
+            break;
     }
 
     CleanUpStack(5);
@@ -555,6 +654,9 @@ bool Eluna::OnChat(Player* pPlayer, uint32 type, uint32 lang, std::string& msg,
             msg = std::string(lua_tostring(L, r + 1));
 
         lua_pop(L, 2);
+
+        if (!result && StopsDispatch(n))
+            break;
     }
 
     CleanUpStack(5);
@@ -571,14 +673,17 @@ void Eluna::OnPetAddedToWorld(Player* player, Creature* pet)
 
 void Eluna::OnLearnSpell(Player* player, uint32 spellId)
 {
-    START_HOOK(PLAYER_EVENT_ON_LEARN_SPELL);
+    DEFER_HOOK(PLAYER_EVENT_ON_LEARN_SPELL, player, spellId);
+    BindingFilterArgs filter = BindingFilterArgs().Set(BINDING_FILTER_SPELL, spellId);
+    START_HOOK_FILTERED(PLAYER_EVENT_ON_LEARN_SPELL, filter);
     Push(player);
     Push(spellId);
-    CallAllFunctions(PlayerEventBindings, key);
+    CallAllFunctions(PlayerEventBindings, key, &filter);
 }
 
 void Eluna::OnAchiComplete(Player* player, AchievementEntry const* achievement)
 {
+    DEFER_HOOK(PLAYER_EVENT_ON_ACHIEVEMENT_COMPLETE, player, achievement);
     START_HOOK(PLAYER_EVENT_ON_ACHIEVEMENT_COMPLETE);
     Push(player);
     Push(achievement);
@@ -701,10 +806,11 @@ void Eluna::OnBattlegroundDesertion(Player* player, const BattlegroundDesertionT
 
 void Eluna::OnCreatureKilledByPet(Player* player, Creature* killed)
 {
-    START_HOOK(PLAYER_EVENT_ON_PET_KILL);
+    BindingFilterArgs filter = PlayerFilter(player).Set(BINDING_FILTER_ENTRY, killed->GetEntry());
+    START_HOOK_FILTERED(PLAYER_EVENT_ON_PET_KILL, filter);
     Push(player);
     Push(killed);
-    CallAllFunctions(PlayerEventBindings, key);
+    CallAllFunctions(PlayerEventBindings, key, &filter);
 }
 
 bool Eluna::OnPlayerCanUpdateSkill(Player* player, uint32 skill_id)
@@ -7,6 +7,7 @@
 #include "Hooks.h"
 #include "HookHelpers.h"
 #include "LuaEngine.h"
+#include "ElunaSampler.h"
 #include "BindingMap.h"
 #include "ElunaEventMgr.h"
 #include "ElunaIncludes.h"
@@ -20,7 +21,7 @@ using namespace Hooks;
     auto key = EventKey<ServerEvents>(EVENT);\
     if (!ServerEventBindings->HasBindingsFor(key))\
         return;\
-    LOCK_ELUNA
+    LOCK_ELUNA_STATE(this)
 
 #define START_HOOK_WITH_RETVAL(EVENT, RETVAL) \
     if (!IsEnabled())\
@@ -28,27 +29,51 @@ using namespace Hooks;
     auto key = EventKey<ServerEvents>(EVENT);\
     if (!ServerEventBindings->HasBindingsFor(key))\
         return RETVAL;\
-    LOCK_ELUNA
+    LOCK_ELUNA_STATE(this)
+
+#define START_HOOK_FILTERED(EVENT, FILTER) \
+    if (!IsEnabled())\
+        return;\
+    auto key = EventKey<ServerEvents>(EVENT);\
+    if (!ServerEventBindings->HasBindingsFor(key, FILTER))\
+        return;\
+    LOCK_ELUNA_STATE(this)
+
+#define START_HOOK_FILTERED_WITH_RETVAL(EVENT, FILTER, RETVAL) \
+    if (!IsEnabled())\
+        return RETVAL;\
+    auto key = EventKey<ServerEvents>(EVENT);\
+    if (!ServerEventBindings->HasBindingsFor(key, FILTER))\
+        return RETVAL;\
+    LOCK_ELUNA_STATE(this)
+
+#define DEFER_HOOK(EVENT, ...) \
+    if (IsEnabled() && ServerEventDeferredBindings->HasBindingsFor(EventKey<ServerEvents>(EVENT)))\
+        QueueDeferredHook(DeferredHook(REGTYPE_SERVER, EVENT, { __VA_ARGS__ }))
 
 bool Eluna::OnAddonMessage(Player* sender, uint32 type, std::string& msg, Player* receiver, Guild* guild, Group* group, Channel* channel)
 {
-    START_HOOK_WITH_RETVAL(ADDON_EVENT_ON_MESSAGE, true);
-    Push(sender);
-    Push(type);
+    if (!IsEnabled())
+        return true;
 
+    // The prefix is the part before the first tab, the whole message if there is none
     auto delimeter_position = msg.find('\t');
+    size_t prefix_length = delimeter_position == std::string::npos ? msg.size() : delimeter_position;
+
+    // Handlers of the prefix are looked up in one step, before the handlers of every message
+    auto key = EventKey<ServerEvents>(ADDON_EVENT_ON_MESSAGE);
+    auto prefixKey = PrefixKey<ServerEvents>(ADDON_EVENT_ON_MESSAGE, msg.data(), prefix_length);
+    if (!ServerEventBindings->HasBindingsFor(key) && !AddonMessageBindings->HasBindingsFor(prefixKey))
+        return true;
+
+    LOCK_ELUNA_STATE(this);
+    Push(sender);
+    Push(type);
+    Push(msg.data(), prefix_length);
     if (delimeter_position == std::string::npos)
-    {
-        Push(msg); // prefix
         Push(); // msg
-    }
     else
-    {
-        std::string prefix = msg.substr(0, delimeter_position);
-        std::string content = msg.substr(delimeter_position + 1, std::string::npos);
-        Push(prefix);
-        Push(content);
-    }
+        Push(msg.data() + delimeter_position + 1, msg.size() - delimeter_position - 1);
 
     if (receiver)
         Push(receiver);
@@ -61,12 +86,12 @@ bool Eluna::OnAddonMessage(Player* sender, uint32 type, std::string& msg, Player
     else
         Push();
 
-    return CallAllFunctionsBool(ServerEventBindings, key, true);
+    return CallAllFunctionsBool(ServerEventBindings, AddonMessageBindings, key, prefixKey, true);
 }
 
 void Eluna::OnTimedEvent(int funcRef, uint32 delay, uint32 calls, WorldObject* obj)
 {
-    LOCK_ELUNA;
+    LOCK_ELUNA_STATE(this);
     ASSERT(!event_level);
 
     // Get function
@@ -114,11 +139,14 @@ void Eluna::OnLuaStateOpen()
 // AreaTrigger
 bool Eluna::OnAreaTrigger(Player* pPlayer, AreaTriggerEntry const* pTrigger)
 {
-    START_HOOK_WITH_RETVAL(TRIGGER_EVENT_ON_TRIGGER, false);
+    BindingFilterArgs filter = BindingFilterArgs()
+        .Set(BINDING_FILTER_ENTRY, pTrigger->entry)
+        .Set(BINDING_FILTER_MAP, pPlayer->GetMapId());
+    START_HOOK_FILTERED_WITH_RETVAL(TRIGGER_EVENT_ON_TRIGGER, filter, false);
     Push(pPlayer);
     Push(pTrigger->entry);
 
-    return CallAllFunctionsBool(ServerEventBindings, key);
+    return CallAllFunctionsBool(ServerEventBindings, key, false, &filter);
 }
 
 // Weather
@@ -260,12 +288,59 @@ void Eluna::OnWorldUpdate(uint32 diff)
     eventMgr->globalProcessor->Update(diff);
     httpManager.HandleHttpResponses();
     queryProcessor.ProcessReadyCallbacks();
+    RunDeferredHooks();
+    FlushErrorReports();
+    StepGC();
+    if (sampler.IsExpired())
+        StopSampling(NULL);
+    UpdateSampling();
 
     START_HOOK(WORLD_EVENT_ON_UPDATE);
     Push(diff);
     CallAllFunctions(ServerEventBindings, key);
 }
 
+/*
+ * Calls the deferred handlers of every hook queued since the last call,
+ *   in the order the hooks were fired.
+ */
+void Eluna::RunDeferredHooks()
+{
+    if (deferredHooks.Empty())
+        return;
+
+    LOCK_ELUNA_STATE(this);
+    deferredHooks.DequeueAll([this](DeferredHook& hook)
+    {
+        if (!IsEnabled())
+            return;
+
+        for (DeferredArg const& arg : hook.args)
+        {
+            arg.Push(L);
+            ++push_counter;
+        }
+
+        switch (hook.regtype)
+        {
+            case REGTYPE_SERVER:
+                CallAllFunctions(ServerEventDeferredBindings, EventKey<ServerEvents>((ServerEvents)hook.event_id));
+                break;
+            case REGTYPE_PLAYER:
+                CallAllFunctions(PlayerEventDeferredBindings, EventKey<PlayerEvents>((PlayerEvents)hook.event_id));
+                break;
+            case REGTYPE_GUILD:
+                CallAllFunctions(GuildEventDeferredBindings, EventKey<GuildEvents>((GuildEvents)hook.event_id));
+                break;
+            case REGTYPE_GROUP:
+                CallAllFunctions(GroupEventDeferredBindings, EventKey<GroupEvents>((GroupEvents)hook.event_id));
+                break;
+            default:
+                ASSERT(false);
+        }
+    });
+}
+
 void Eluna::OnStartup()
 {
     START_HOOK(WORLD_EVENT_ON_STARTUP);
@@ -295,18 +370,22 @@ void Eluna::OnDestroy(Map* map)
 
 void Eluna::OnPlayerEnter(Map* map, Player* player)
 {
-    START_HOOK(MAP_EVENT_ON_PLAYER_ENTER);
+    DEFER_HOOK(MAP_EVENT_ON_PLAYER_ENTER, map, player);
+    BindingFilterArgs filter = BindingFilterArgs().Set(BINDING_FILTER_MAP, map->GetId());
+    START_HOOK_FILTERED(MAP_EVENT_ON_PLAYER_ENTER, filter);
     Push(map);
     Push(player);
-    CallAllFunctions(ServerEventBindings, key);
+    CallAllFunctions(ServerEventBindings, key, &filter);
 }
 
 void Eluna::OnPlayerLeave(Map* map, Player* player)
 {
-    START_HOOK(MAP_EVENT_ON_PLAYER_LEAVE);
+    DEFER_HOOK(MAP_EVENT_ON_PLAYER_LEAVE, map, player);
+    BindingFilterArgs filter = BindingFilterArgs().Set(BINDING_FILTER_MAP, map->GetId());
+    START_HOOK_FILTERED(MAP_EVENT_ON_PLAYER_LEAVE, filter);
     Push(map);
     Push(player);
-    CallAllFunctions(ServerEventBindings, key);
+    CallAllFunctions(ServerEventBindings, key, &filter);
 }
 
 void Eluna::OnUpdate(Map* map, uint32 diff)
@@ -321,14 +400,20 @@ void Eluna::OnUpdate(Map* map, uint32 diff)
 
 void Eluna::OnRemove(GameObject* gameobject)
 {
-    START_HOOK(WORLD_EVENT_ON_DELETE_GAMEOBJECT);
+    BindingFilterArgs filter = BindingFilterArgs()
+        .Set(BINDING_FILTER_ENTRY, gameobject->GetEntry())
+        .Set(BINDING_FILTER_MAP, gameobject->GetMapId());
+    START_HOOK_FILTERED(WORLD_EVENT_ON_DELETE_GAMEOBJECT, filter);
     Push(gameobject);
-    CallAllFunctions(ServerEventBindings, key);
+    CallAllFunctions(ServerEventBindings, key, &filter);
 }
 
 void Eluna::OnRemove(Creature* creature)
 {
-    START_HOOK(WORLD_EVENT_ON_DELETE_CREATURE);
+    BindingFilterArgs filter = BindingFilterArgs()
+        .Set(BINDING_FILTER_ENTRY, creature->GetEntry())
+        .Set(BINDING_FILTER_MAP, creature->GetMapId());
+    START_HOOK_FILTERED(WORLD_EVENT_ON_DELETE_CREATURE, filter);
     Push(creature);
-    CallAllFunctions(ServerEventBindings, key);
+    CallAllFunctions(ServerEventBindings, key, &filter);
 }
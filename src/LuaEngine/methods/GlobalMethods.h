@@ -104,8 +104,7 @@ namespace LuaGlobalFunctions
      */
     int GetStateMap(lua_State* L)
     {
-        // Until AC supports multistate, this will always return nil
-        Eluna::Push(L);
+        Eluna::Push(L, Eluna::GetEluna(L)->GetStateMap());
         return 1;
     }
 
@@ -116,8 +115,7 @@ namespace LuaGlobalFunctions
      */
     int GetStateMapId(lua_State* L)
     {
-        // Until AC supports multistate, this will always return -1
-        Eluna::Push(L, -1);
+        Eluna::Push(L, Eluna::GetEluna(L)->GetStateMapId());
         return 1;
     }
 
@@ -128,11 +126,135 @@ namespace LuaGlobalFunctions
      */
     int GetStateInstanceId(lua_State* L)
     {
-        // Until AC supports multistate, this will always return 0
-        Eluna::Push(L, 0);
+        Eluna::Push(L, Eluna::GetEluna(L)->GetStateInstanceId());
+        return 1;
+    }
+
+    /**
+     * Returns the time the garbage collector of the Lua state spent in the server updates, see `Eluna.GCStepBudget`.
+     *
+     * The table has the fields `lastTime` and `totalTime` in microseconds, `steps` and `cycles` taken by the
+     *   scheduled collector, `memory` used by the state in KB and `generational` set if the collector runs in generational mode.
+     *   Collection done by Lua itself during allocations is not included.
+     *
+     * @return table stats
+     */
+    int GetGCStats(lua_State* L)
+    {
+        const ElunaGCStats& stats = Eluna::GetEluna(L)->GetGCStats();
+
+        lua_createtable(L, 0, 6);
+        Eluna::Push(L, stats.lastTime);
+        lua_setfield(L, -2, "lastTime");
+        Eluna::Push(L, stats.totalTime);
+        lua_setfield(L, -2, "totalTime");
+        Eluna::Push(L, stats.steps);
+        lua_setfield(L, -2, "steps");
+        Eluna::Push(L, stats.cycles);
+        lua_setfield(L, -2, "cycles");
+        Eluna::Push(L, lua_gc(L, LUA_GCCOUNT, 0));
+        lua_setfield(L, -2, "memory");
+        Eluna::Push(L, Eluna::GetEluna(L)->IsGCGenerational());
+        lua_setfield(L, -2, "generational");
+        return 1;
+    }
+
+    /**
+     * Returns the memory use of the Lua state in bytes, see `Eluna.MemoryLimit`.
+     *
+     * The table has the fields `used`, `peak`, `pooled` for the memory reserved by the allocator pools, `limit` which is 0
+     *   if there is none, and `refused` for the allocations that failed because of the limit.
+     *   With LuaJIT only `used` is known, the other fields are 0.
+     *
+     * @return table stats
+     */
+    int GetMemoryStats(lua_State* L)
+    {
+        const ElunaAllocator* allocator = Eluna::GetEluna(L)->GetAllocator();
+
+        lua_createtable(L, 0, 5);
+        if (allocator)
+            Eluna::Push(L, allocator->GetUsed());
+        else
+            Eluna::Push(L, static_cast<size_t>(lua_gc(L, LUA_GCCOUNT, 0)) * 1024 + lua_gc(L, LUA_GCCOUNTB, 0));
+        lua_setfield(L, -2, "used");
+        Eluna::Push(L, allocator ? allocator->GetPeak() : 0);
+        lua_setfield(L, -2, "peak");
+        Eluna::Push(L, allocator ? allocator->GetPooled() : 0);
+        lua_setfield(L, -2, "pooled");
+        Eluna::Push(L, allocator ? allocator->GetLimit() : 0);
+        lua_setfield(L, -2, "limit");
+        Eluna::Push(L, allocator ? allocator->GetFailures() : 0);
+        lua_setfield(L, -2, "refused");
         return 1;
     }
 
+    /**
+     * Returns the latencies of the hooks and event handlers of the Lua state, see `Eluna.HookProfiling`.
+     *
+     * Hooks are the calls of all handlers of an event, handlers the single functions, including timed events.
+     *   Functions defined at the same place, such as the closures of one `function() ... end`, share an entry.
+     *   Each entry has the fields `count`, and `total`, `max`, `p50` and `p99` in microseconds. The percentiles
+     *   are estimates. Hook entries also have `type`, e.g. "Player", and `event`, handler entries have `source`,
+     *   the file and line the function is defined at.
+     *
+     *     local hooks, handlers = GetHookStats()
+     *     for _, h in ipairs(handlers) do
+     *         print(h.source, h.count, h.total)
+     *     end
+     *
+     * @return table hooks
+     * @return table handlers
+     */
+    int GetHookStats(lua_State* L)
+    {
+        auto pushStats = [L](const LatencyStats& stats)
+        {
+            lua_createtable(L, 0, 7);
+            Eluna::Push(L, stats.count);
+            lua_setfield(L, -2, "count");
+            Eluna::Push(L, stats.total / 1000.0);
+            lua_setfield(L, -2, "total");
+            Eluna::Push(L, stats.max / 1000.0);
+            lua_setfield(L, -2, "max");
+            Eluna::Push(L, stats.GetPercentile(50) / 1000.0);
+            lua_setfield(L, -2, "p50");
+            Eluna::Push(L, stats.GetPercentile(99) / 1000.0);
+            lua_setfield(L, -2, "p99");
+        };
+
+        // Copied first, Lua errors must not leave the profiler locked
+        std::vector< std::pair<HookProfiler::HookId, LatencyStats> > hooks;
+        std::vector< std::pair<std::string, LatencyStats> > handlers;
+        Eluna::GetEluna(L)->profiler->Read([&](const HookProfiler::HookMap& stateHooks, const HookProfiler::HandlerMap& stateHandlers)
+        {
+            hooks.assign(stateHooks.begin(), stateHooks.end());
+            for (auto itr = stateHandlers.begin(); itr != stateHandlers.end(); ++itr)
+                handlers.push_back(std::make_pair(itr->second.location, itr->second.stats));
+        });
+
+        lua_createtable(L, static_cast<int>(hooks.size()), 0);
+        for (size_t i = 0; i < hooks.size(); ++i)
+        {
+            pushStats(hooks[i].second);
+            Eluna::Push(L, hooks[i].first.first);
+            lua_setfield(L, -2, "type");
+            Eluna::Push(L, hooks[i].first.second);
+            lua_setfield(L, -2, "event");
+            lua_rawseti(L, -2, static_cast<int>(i + 1));
+        }
+
+        lua_createtable(L, static_cast<int>(handlers.size()), 0);
+        for (size_t i = 0; i < handlers.size(); ++i)
+        {
+            pushStats(handlers[i].second);
+            Eluna::Push(L, handlers[i].first);
+            lua_setfield(L, -2, "source");
+            lua_rawseti(L, -2, static_cast<int>(i + 1));
+        }
+        return 2;
+    }
+
     /**
      * Returns [Quest] template
      *
@@ -528,17 +650,75 @@ namespace LuaGlobalFunctions
         return 1;
     }
 
+    /*
+     * Reads and removes the optional filter table that Register* functions accept after the function,
+     *   e.g. `{ spell = { 133, 116 }, zone = 1519 }`.
+     */
+    static void PopBindingFilter(lua_State* L, int functionIndex, BindingFilter& filter)
+    {
+        // The security level filter is not available to scripts
+        static const char* const kindNames[BINDING_FILTER_SECURITY] = { "entry", "spell", "zone", "map", "opcode" };
+
+        int index = lua_gettop(L);
+        if (index <= functionIndex || !lua_istable(L, index))
+            return;
+
+        lua_pushnil(L);
+        while (lua_next(L, index) != 0)
+        {
+            // Stack: filter, kind, values
+            int kind = BINDING_FILTER_SECURITY - 1;
+            if (lua_type(L, -2) == LUA_TSTRING)
+                while (kind >= 0 && strcmp(lua_tostring(L, -2), kindNames[kind]) != 0)
+                    --kind;
+            else
+                kind = -1;
+            if (kind < 0)
+                luaL_argerror(L, index, "filter keys must be entry, spell, zone, map or opcode");
+
+            if (lua_istable(L, -1))
+            {
+                for (int i = 1; ; ++i)
+                {
+                    lua_rawgeti(L, -1, i);
+                    if (lua_isnil(L, -1))
+                    {
+                        lua_pop(L, 1);
+                        break;
+                    }
+                    if (!lua_isnumber(L, -1))
+                        luaL_argerror(L, index, "filter values must be numbers");
+                    filter.Add(BindingFilterKind(kind), static_cast<uint32>(lua_tonumber(L, -1)));
+                    lua_pop(L, 1);
+                }
+            }
+            else if (lua_isnumber(L, -1))
+                filter.Add(BindingFilterKind(kind), static_cast<uint32>(lua_tonumber(L, -1)));
+            else
+                luaL_argerror(L, index, "filter values must be numbers");
+
+            lua_pop(L, 1);
+            // Stack: filter, kind
+        }
+
+        lua_settop(L, index - 1);
+    }
+
     static int RegisterEntryHelper(lua_State* L, int regtype)
     {
         uint32 id = Eluna::CHECKVAL<uint32>(L, 1);
         uint32 ev = Eluna::CHECKVAL<uint32>(L, 2);
         luaL_checktype(L, 3, LUA_TFUNCTION);
+        BindingFilter filter;
+        PopBindingFilter(L, 3, filter);
         uint32 shots = Eluna::CHECKVAL<uint32>(L, 4, 0);
+        int32 priority = Eluna::CHECKVAL<int32>(L, 5, 0);
+        bool stopOnResult = Eluna::CHECKVAL<bool>(L, 6, false);
 
         lua_pushvalue(L, 3);
         int functionRef = luaL_ref(L, LUA_REGISTRYINDEX);
         if (functionRef >= 0)
-            return Eluna::GetEluna(L)->Register(L, regtype, id, ObjectGuid(), 0, ev, functionRef, shots);
+            return Eluna::GetEluna(L)->Register(L, regtype, id, ObjectGuid(), 0, ev, functionRef, shots, false, priority, stopOnResult, &filter);
         else
             luaL_argerror(L, 3, "unable to make a ref to function");
         return 0;
@@ -548,12 +728,26 @@ namespace LuaGlobalFunctions
     {
         uint32 ev = Eluna::CHECKVAL<uint32>(L, 1);
         luaL_checktype(L, 2, LUA_TFUNCTION);
+        BindingFilter filter;
+        PopBindingFilter(L, 2, filter);
         uint32 shots = Eluna::CHECKVAL<uint32>(L, 3, 0);
+        bool deferred = false;
+        int32 priority = 0;
+        bool stopOnResult = false;
+
+        // The 4th argument is either `deferred` or `priority`, followed by `stop`
+        if (lua_isboolean(L, 4))
+            deferred = Eluna::CHECKVAL<bool>(L, 4);
+        else
+        {
+            priority = Eluna::CHECKVAL<int32>(L, 4, 0);
+            stopOnResult = Eluna::CHECKVAL<bool>(L, 5, false);
+        }
 
         lua_pushvalue(L, 2);
         int functionRef = luaL_ref(L, LUA_REGISTRYINDEX);
         if (functionRef >= 0)
-            return Eluna::GetEluna(L)->Register(L, regtype, 0, ObjectGuid(), 0, ev, functionRef, shots);
+            return Eluna::GetEluna(L)->Register(L, regtype, 0, ObjectGuid(), 0, ev, functionRef, shots, deferred, priority, stopOnResult, &filter);
         else
             luaL_argerror(L, 2, "unable to make a ref to function");
         return 0;
@@ -565,12 +759,16 @@ namespace LuaGlobalFunctions
         uint32 instanceId = Eluna::CHECKVAL<uint32>(L, 2);
         uint32 ev = Eluna::CHECKVAL<uint32>(L, 3);
         luaL_checktype(L, 4, LUA_TFUNCTION);
+        BindingFilter filter;
+        PopBindingFilter(L, 4, filter);
         uint32 shots = Eluna::CHECKVAL<uint32>(L, 5, 0);
+        int32 priority = Eluna::CHECKVAL<int32>(L, 6, 0);
+        bool stopOnResult = Eluna::CHECKVAL<bool>(L, 7, false);
 
         lua_pushvalue(L, 4);
         int functionRef = luaL_ref(L, LUA_REGISTRYINDEX);
         if (functionRef >= 0)
-            return Eluna::GetEluna(L)->Register(L, regtype, 0, guid, instanceId, ev, functionRef, shots);
+            return Eluna::GetEluna(L)->Register(L, regtype, 0, guid, instanceId, ev, functionRef, shots, false, priority, stopOnResult, &filter);
         else
             luaL_argerror(L, 4, "unable to make a ref to function");
         return 0;
@@ -586,9 +784,9 @@ namespace LuaGlobalFunctions
      *         SERVER_EVENT_ON_NETWORK_STOP            =     2,       // Not Implemented
      *         SERVER_EVENT_ON_SOCKET_OPEN             =     3,       // Not Implemented
      *         SERVER_EVENT_ON_SOCKET_CLOSE            =     4,       // Not Implemented
-     *         SERVER_EVENT_ON_PACKET_RECEIVE          =     5,       // (event, packet, player) - Player only if accessible. Can return false, newPacket
+     *         SERVER_EVENT_ON_PACKET_RECEIVE          =     5,       // (event, packet, player) - Player only if accessible. Can return false, newPacket. Filter: opcode
      *         SERVER_EVENT_ON_PACKET_RECEIVE_UNKNOWN  =     6,       // Not Implemented
-     *         SERVER_EVENT_ON_PACKET_SEND             =     7,       // (event, packet, player) - Player only if accessible. Can return false, newPacket
+     *         SERVER_EVENT_ON_PACKET_SEND             =     7,       // (event, packet, player) - Player only if accessible. Can return false, newPacket. Filter: opcode
      *
      *         // World
      *         WORLD_EVENT_ON_OPEN_STATE_CHANGE        =     8,        // (event, open) - Needs core support on Mangos
@@ -608,12 +806,12 @@ namespace LuaGlobalFunctions
      *         MAP_EVENT_ON_DESTROY                    =     18,       // (event, map)
      *         MAP_EVENT_ON_GRID_LOAD                  =     19,       // Not Implemented
      *         MAP_EVENT_ON_GRID_UNLOAD                =     20,       // Not Implemented
-     *         MAP_EVENT_ON_PLAYER_ENTER               =     21,       // (event, map, player)
-     *         MAP_EVENT_ON_PLAYER_LEAVE               =     22,       // (event, map, player)
+     *         MAP_EVENT_ON_PLAYER_ENTER               =     21,       // (event, map, player) - Can be deferred. Filter: map
+     *         MAP_EVENT_ON_PLAYER_LEAVE               =     22,       // (event, map, player) - Can be deferred. Filter: map
      *         MAP_EVENT_ON_UPDATE                     =     23,       // (event, map, diff)
      *
      *         // Area trigger
-     *         TRIGGER_EVENT_ON_TRIGGER                =     24,       // (event, player, triggerId) - Can return true
+     *         TRIGGER_EVENT_ON_TRIGGER                =     24,       // (event, player, triggerId) - Can return true. Filter: entry, map
      *
      *         // Weather
      *         WEATHER_EVENT_ON_CHANGE                 =     25,       // (event, zoneId, state, grade)
@@ -625,10 +823,10 @@ namespace LuaGlobalFunctions
      *         AUCTION_EVENT_ON_EXPIRE                 =     29,       // (event, auctionId, owner, item, expireTime, buyout, startBid, currentBid, bidderGUIDLow)
      *
      *         // AddOns
-     *         ADDON_EVENT_ON_MESSAGE                  =     30,       // (event, sender, type, prefix, msg, target) - target can be nil/whisper_target/guild/group/channel. Can return false
+     *         ADDON_EVENT_ON_MESSAGE                  =     30,       // (event, sender, type, prefix, msg, target) - target can be nil/whisper_target/guild/group/channel. Can return false. See also [Global:RegisterAddonMessageHandler]
      *
-     *         WORLD_EVENT_ON_DELETE_CREATURE          =     31,       // (event, creature)
-     *         WORLD_EVENT_ON_DELETE_GAMEOBJECT        =     32,       // (event, gameobject)
+     *         WORLD_EVENT_ON_DELETE_CREATURE          =     31,       // (event, creature) - Filter: entry, map
+     *         WORLD_EVENT_ON_DELETE_GAMEOBJECT        =     32,       // (event, gameobject) - Filter: entry, map
      *
      *         // Eluna
      *         ELUNA_EVENT_ON_LUA_STATE_OPEN           =     33,       // (event) - triggers after all scripts are loaded
@@ -637,12 +835,23 @@ namespace LuaGlobalFunctions
      *         GAME_EVENT_STOP                         =     35,       // (event, gameeventid)
      *     };
      *
+     * Events marked "Can be deferred" accept `deferred`, see [Global:RegisterPlayerEvent] for how deferred handlers are called.
+     * Events marked "Filter" accept a `filter` table with the listed keys, see [Global:RegisterPlayerEvent].
+     *
      * @proto cancel = (event, function)
      * @proto cancel = (event, function, shots)
+     * @proto cancel = (event, function, shots, deferred)
+     * @proto cancel = (event, function, shots, priority)
+     * @proto cancel = (event, function, shots, priority, stop)
+     * @proto cancel = (event, function, ..., filter)
      *
      * @param uint32 event : server event ID, refer to ServerEvents above
      * @param function function : function that will be called when the event occurs
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param bool deferred = false : if `true`, the function is called later from a queue instead of inside the hook
+     * @param int32 priority = 0 : handlers with a higher priority are called first
+     * @param bool stop = false : if `true`, no more handlers are called after this one once the event's result is decided
+     * @param table filter : argument values the function is called for, refer to the "Filter" marks above
      *
      * @return function cancel : a function that cancels the binding when called
      */
@@ -651,6 +860,88 @@ namespace LuaGlobalFunctions
         return RegisterEventHelper(L, Hooks::REGTYPE_SERVER);
     }
 
+    /**
+     * Registers a handler for a chat command.
+     *
+     * `path` is the command without the leading dot, e.g. "event start". Commands are matched
+     *   case-insensitively by whole words, and the longest registered command the text starts with is used.
+     *   The remaining words are passed to the handler in `args`.
+     *
+     * The player's security level is checked for each handler, a command whose handlers all need a higher level
+     *   is treated as not registered. Registered commands don't reach the core or PLAYER_EVENT_ON_COMMAND handlers,
+     *   other commands are not seen by these handlers at all.
+     *
+     *     RegisterCommand("event start", function(event, player, args, handler)
+     *         handler:SendSysMessage("Starting event "..(args[1] or "?"))
+     *     end, 2)
+     *
+     * @proto cancel = (path, function)
+     * @proto cancel = (path, function, minSecurity)
+     *
+     * @param string path : the command, a list of words separated by spaces
+     * @param function function : function that will be called with (event, player, args, chatHandler), player is nil if the command is used from the console
+     * @param uint32 minSecurity = 0 : the account security level needed to use the command
+     *
+     * @return function cancel : a function that cancels the binding when called
+     */
+    int RegisterCommand(lua_State* L)
+    {
+        const char* path = Eluna::CHECKVAL<const char*>(L, 1);
+        luaL_checktype(L, 2, LUA_TFUNCTION);
+        uint32 minSecurity = Eluna::CHECKVAL<uint32>(L, 3, 0);
+
+        lua_pushvalue(L, 2);
+        int functionRef = luaL_ref(L, LUA_REGISTRYINDEX);
+        if (functionRef >= 0)
+            return Eluna::GetEluna(L)->RegisterCommand(L, path, functionRef, minSecurity);
+        else
+            luaL_argerror(L, 2, "unable to make a ref to function");
+        return 0;
+    }
+
+    /**
+     * Registers a handler for addon messages with the given prefix.
+     *
+     * The handler is called like an ADDON_EVENT_ON_MESSAGE handler of [Global:RegisterServerEvent],
+     *   but only for messages whose prefix (the text before the first tab) equals `prefix`.
+     *   The handlers of a prefix are found with a single lookup, so scripts don't need to compare the prefix themselves.
+     *
+     * Prefix handlers are called before the ADDON_EVENT_ON_MESSAGE handlers.
+     *
+     *     RegisterAddonMessageHandler("MyAddon", function(event, sender, type, prefix, msg, target)
+     *         print(sender:GetName().." sent "..msg)
+     *     end)
+     *
+     * @proto cancel = (prefix, function)
+     * @proto cancel = (prefix, function, shots)
+     * @proto cancel = (prefix, function, shots, priority, stop)
+     *
+     * @param string prefix : the addon message prefix to handle
+     * @param function function : function that will be called with (event, sender, type, prefix, msg, target), can return false
+     * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param int32 priority = 0 : handlers with a higher priority are called first
+     * @param bool stop = false : if `true`, no more handlers are called after this one once the message is blocked
+     *
+     * @return function cancel : a function that cancels the binding when called
+     */
+    int RegisterAddonMessageHandler(lua_State* L)
+    {
+        size_t length;
+        const char* prefix = luaL_checklstring(L, 1, &length);
+        luaL_checktype(L, 2, LUA_TFUNCTION);
+        uint32 shots = Eluna::CHECKVAL<uint32>(L, 3, 0);
+        int32 priority = Eluna::CHECKVAL<int32>(L, 4, 0);
+        bool stopOnResult = Eluna::CHECKVAL<bool>(L, 5, false);
+
+        lua_pushvalue(L, 2);
+        int functionRef = luaL_ref(L, LUA_REGISTRYINDEX);
+        if (functionRef >= 0)
+            return Eluna::GetEluna(L)->RegisterAddonMessage(L, prefix, length, functionRef, shots, priority, stopOnResult);
+        else
+            luaL_argerror(L, 2, "unable to make a ref to function");
+        return 0;
+    }
+
     /**
      * Registers a [Player] event handler.
      *
@@ -659,17 +950,17 @@ namespace LuaGlobalFunctions
      * {
      *     PLAYER_EVENT_ON_CHARACTER_CREATE        =     1,        // (event, player)
      *     PLAYER_EVENT_ON_CHARACTER_DELETE        =     2,        // (event, guid)
-     *     PLAYER_EVENT_ON_LOGIN                   =     3,        // (event, player)
-     *     PLAYER_EVENT_ON_LOGOUT                  =     4,        // (event, player)
-     *     PLAYER_EVENT_ON_SPELL_CAST              =     5,        // (event, player, spell, skipCheck)
+     *     PLAYER_EVENT_ON_LOGIN                   =     3,        // (event, player) - Can be deferred
+     *     PLAYER_EVENT_ON_LOGOUT                  =     4,        // (event, player) - Can be deferred
+     *     PLAYER_EVENT_ON_SPELL_CAST              =     5,        // (event, player, spell, skipCheck) - Filter: spell, zone, map
      *     PLAYER_EVENT_ON_KILL_PLAYER             =     6,        // (event, killer, killed)
-     *     PLAYER_EVENT_ON_KILL_CREATURE           =     7,        // (event, killer, killed)
-     *     PLAYER_EVENT_ON_KILLED_BY_CREATURE      =     8,        // (event, killer, killed)
+     *     PLAYER_EVENT_ON_KILL_CREATURE           =     7,        // (event, killer, killed) - Filter: entry, zone, map
+     *     PLAYER_EVENT_ON_KILLED_BY_CREATURE      =     8,        // (event, killer, killed) - Filter: entry, zone, map
      *     PLAYER_EVENT_ON_DUEL_REQUEST            =     9,        // (event, target, challenger)
      *     PLAYER_EVENT_ON_DUEL_START              =     10,       // (event, player1, player2)
      *     PLAYER_EVENT_ON_DUEL_END                =     11,       // (event, winner, loser, type)
      *     PLAYER_EVENT_ON_GIVE_XP                 =     12,       // (event, player, amount, victim, source) - Can return new XP amount
-     *     PLAYER_EVENT_ON_LEVEL_CHANGE            =     13,       // (event, player, oldLevel)
+     *     PLAYER_EVENT_ON_LEVEL_CHANGE            =     13,       // (event, player, oldLevel) - Can be deferred
      *     PLAYER_EVENT_ON_MONEY_CHANGE            =     14,       // (event, player, amount) - Can return new money amount
      *     PLAYER_EVENT_ON_REPUTATION_CHANGE       =     15,       // (event, player, factionId, standing, incremental) - Can return new standing -> if standing == -1, it will prevent default action (rep gain)
      *     PLAYER_EVENT_ON_TALENTS_CHANGE          =     16,       // (event, player, points)
@@ -683,27 +974,27 @@ namespace LuaGlobalFunctions
      *     PLAYER_EVENT_ON_TEXT_EMOTE              =     24,       // (event, player, textEmote, emoteNum, guid)
      *     PLAYER_EVENT_ON_SAVE                    =     25,       // (event, player)
      *     PLAYER_EVENT_ON_BIND_TO_INSTANCE        =     26,       // (event, player, difficulty, mapid, permanent)
-     *     PLAYER_EVENT_ON_UPDATE_ZONE             =     27,       // (event, player, newZone, newArea)
-     *     PLAYER_EVENT_ON_MAP_CHANGE              =     28,       // (event, player)
+     *     PLAYER_EVENT_ON_UPDATE_ZONE             =     27,       // (event, player, newZone, newArea) - Filter: zone, map
+     *     PLAYER_EVENT_ON_MAP_CHANGE              =     28,       // (event, player) - Filter: zone, map
      *
      *     // Custom
-     *     PLAYER_EVENT_ON_EQUIP                   =     29,       // (event, player, item, bag, slot)
-     *     PLAYER_EVENT_ON_FIRST_LOGIN             =     30,       // (event, player)
-     *     PLAYER_EVENT_ON_CAN_USE_ITEM            =     31,       // (event, player, itemEntry) - Can return InventoryResult enum value
-     *     PLAYER_EVENT_ON_LOOT_ITEM               =     32,       // (event, player, item, count)
+     *     PLAYER_EVENT_ON_EQUIP                   =     29,       // (event, player, item, bag, slot) - Filter: entry, zone, map
+     *     PLAYER_EVENT_ON_FIRST_LOGIN             =     30,       // (event, player) - Can be deferred
+     *     PLAYER_EVENT_ON_CAN_USE_ITEM            =     31,       // (event, player, itemEntry) - Can return InventoryResult enum value. Filter: entry
+     *     PLAYER_EVENT_ON_LOOT_ITEM               =     32,       // (event, player, item, count) - Can be deferred. Filter: entry, zone, map
      *     PLAYER_EVENT_ON_ENTER_COMBAT            =     33,       // (event, player, enemy)
      *     PLAYER_EVENT_ON_LEAVE_COMBAT            =     34,       // (event, player)
      *     PLAYER_EVENT_ON_REPOP                   =     35,       // (event, player)
      *     PLAYER_EVENT_ON_RESURRECT               =     36,       // (event, player)
-     *     PLAYER_EVENT_ON_LOOT_MONEY              =     37,       // (event, player, amount)
+     *     PLAYER_EVENT_ON_LOOT_MONEY              =     37,       // (event, player, amount) - Can be deferred
      *     PLAYER_EVENT_ON_QUEST_ABANDON           =     38,       // (event, player, questId)
      *     PLAYER_EVENT_ON_LEARN_TALENTS           =     39,       // (event, player, talentId, talentRank, spellid)
      *     // UNUSED                               =     40,       // (event, player)
      *     // UNUSED                               =     41,       // (event, player)
-     *     PLAYER_EVENT_ON_COMMAND                 =     42,       // (event, player, command, chatHandler) - player is nil if command used from console. Can return false
+     *     PLAYER_EVENT_ON_COMMAND                 =     42,       // (event, player, command, chatHandler) - player is nil if command used from console. Can return false. Not called for commands of [Global:RegisterCommand]
      *     PLAYER_EVENT_ON_PET_ADDED_TO_WORLD      =     43,       // (event, player, pet)
-     *     PLAYER_EVENT_ON_LEARN_SPELL             =     44,       // (event, player, spellId)
-     *     PLAYER_EVENT_ON_ACHIEVEMENT_COMPLETE    =     45,       // (event, player, achievement)
+     *     PLAYER_EVENT_ON_LEARN_SPELL             =     44,       // (event, player, spellId) - Can be deferred. Filter: spell
+     *     PLAYER_EVENT_ON_ACHIEVEMENT_COMPLETE    =     45,       // (event, player, achievement) - Can be deferred
      *     PLAYER_EVENT_ON_FFAPVP_CHANGE           =     46,       // (event, player, hasFfaPvp)
      *     PLAYER_EVENT_ON_UPDATE_AREA             =     47,       // (event, player, oldArea, newArea)
      *     PLAYER_EVENT_ON_CAN_INIT_TRADE          =     48,       // (event, player, target) - Can return false to prevent the trade
@@ -716,17 +1007,41 @@ namespace LuaGlobalFunctions
      *     PLAYER_EVENT_ON_CAN_GROUP_INVITE        =     55,       // (event, player, memberName) - Can return false to prevent inviting
      *     PLAYER_EVENT_ON_GROUP_ROLL_REWARD_ITEM  =     56,       // (event, player, item, count, voteType, roll)
      *     PLAYER_EVENT_ON_BG_DESERTION            =     57,       // (event, player, type)
-     *     PLAYER_EVENT_ON_PET_KILL                =     58,       // (event, player, killer)
+     *     PLAYER_EVENT_ON_PET_KILL                =     58,       // (event, player, killer) - Filter: entry, zone, map
      *     PLAYER_EVENT_ON_CAN_RESURRECT           =     59,       // (event, player)
      * };
      * </pre>
      *
+     * Handlers registered with `deferred` set don't run inside the hook.
+     * The hook's arguments are queued and the handlers are called with them later, on the next update of the Lua state.
+     * Return values of deferred handlers are ignored.
+     * Players, items and groups are passed to them as GUIDs, guilds and achievements as IDs, since they may be gone by then.
+     * Only the events marked "Can be deferred" above accept `deferred`.
+     *
+     * Handlers that aren't deferred can be given a `priority` in place of `deferred`. Handlers with a higher priority
+     * are called first, handlers of equal priority newest first. A handler registered with `stop` ends the event
+     * once its result is decided, e.g. after a handler returned false to block a chat message, so that
+     * the handlers after it don't run for an answer that can no longer change.
+     *
+     * Events marked "Filter" accept a `filter` table as the last argument, e.g. `{ spell = { 133, 116 }, zone = 1519 }`.
+     * The handler is then only called if every listed argument has one of the given values, which is checked
+     * before the event enters Lua at all. Keys are `entry` (creature, gameobject or item entry, or area trigger ID),
+     * `spell`, `zone`, `map` and `opcode`, only the ones listed for the event can be used. Deferred handlers can't be filtered.
+     *
      * @proto cancel = (event, function)
      * @proto cancel = (event, function, shots)
+     * @proto cancel = (event, function, shots, deferred)
+     * @proto cancel = (event, function, shots, priority)
+     * @proto cancel = (event, function, shots, priority, stop)
+     * @proto cancel = (event, function, ..., filter)
      *
      * @param uint32 event : [Player] event Id, refer to PlayerEvents above
      * @param function function : function to register
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param bool deferred = false : if `true`, the function is called later from a queue instead of inside the hook
+     * @param int32 priority = 0 : handlers with a higher priority are called first
+     * @param bool stop = false : if `true`, no more handlers are called after this one once the event's result is decided
+     * @param table filter : argument values the function is called for, refer to the "Filter" marks above
      *
      * @return function cancel : a function that cancels the binding when called
      */
@@ -742,28 +1057,36 @@ namespace LuaGlobalFunctions
      * enum GuildEvents
      * {
      *     // Guild
-     *     GUILD_EVENT_ON_ADD_MEMBER               =     1,       // (event, guild, player, rank)
-     *     GUILD_EVENT_ON_REMOVE_MEMBER            =     2,       // (event, guild, player, isDisbanding)
-     *     GUILD_EVENT_ON_MOTD_CHANGE              =     3,       // (event, guild, newMotd)
-     *     GUILD_EVENT_ON_INFO_CHANGE              =     4,       // (event, guild, newInfo)
-     *     GUILD_EVENT_ON_CREATE                   =     5,       // (event, guild, leader, name)  // Not on TC
-     *     GUILD_EVENT_ON_DISBAND                  =     6,       // (event, guild)
+     *     GUILD_EVENT_ON_ADD_MEMBER               =     1,       // (event, guild, player, rank) - Can be deferred
+     *     GUILD_EVENT_ON_REMOVE_MEMBER            =     2,       // (event, guild, player, isDisbanding) - Can be deferred
+     *     GUILD_EVENT_ON_MOTD_CHANGE              =     3,       // (event, guild, newMotd) - Can be deferred
+     *     GUILD_EVENT_ON_INFO_CHANGE              =     4,       // (event, guild, newInfo) - Can be deferred
+     *     GUILD_EVENT_ON_CREATE                   =     5,       // (event, guild, leader, name) - Can be deferred  // Not on TC
+     *     GUILD_EVENT_ON_DISBAND                  =     6,       // (event, guild) - Can be deferred
      *     GUILD_EVENT_ON_MONEY_WITHDRAW           =     7,       // (event, guild, player, amount, isRepair) - Can return new money amount
      *     GUILD_EVENT_ON_MONEY_DEPOSIT            =     8,       // (event, guild, player, amount) - Can return new money amount
      *     GUILD_EVENT_ON_ITEM_MOVE                =     9,       // (event, guild, player, item, isSrcBank, srcContainer, srcSlotId, isDestBank, destContainer, destSlotId)   // TODO
-     *     GUILD_EVENT_ON_EVENT                    =     10,      // (event, guild, eventType, plrGUIDLow1, plrGUIDLow2, newRank)  // TODO
-     *     GUILD_EVENT_ON_BANK_EVENT               =     11,      // (event, guild, eventType, tabId, playerGUIDLow, itemOrMoney, itemStackCount, destTabId)
+     *     GUILD_EVENT_ON_EVENT                    =     10,      // (event, guild, eventType, plrGUIDLow1, plrGUIDLow2, newRank) - Can be deferred  // TODO
+     *     GUILD_EVENT_ON_BANK_EVENT               =     11,      // (event, guild, eventType, tabId, playerGUIDLow, itemOrMoney, itemStackCount, destTabId) - Can be deferred
      *
      *     GUILD_EVENT_COUNT
      * };
      * </pre>
      *
+     * Events marked "Can be deferred" accept `deferred`, see [Global:RegisterPlayerEvent] for how deferred handlers are called.
+     *
      * @proto cancel = (event, function)
      * @proto cancel = (event, function, shots)
+     * @proto cancel = (event, function, shots, deferred)
+     * @proto cancel = (event, function, shots, priority)
+     * @proto cancel = (event, function, shots, priority, stop)
      *
      * @param uint32 event : [Guild] event Id, refer to GuildEvents above
      * @param function function : function to register
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param bool deferred = false : if `true`, the function is called later from a queue instead of inside the hook
+     * @param int32 priority = 0 : handlers with a higher priority are called first
+     * @param bool stop = false : if `true`, no more handlers are called after this one once the event's result is decided
      *
      * @return function cancel : a function that cancels the binding when called
      */
@@ -779,23 +1102,31 @@ namespace LuaGlobalFunctions
      * enum GroupEvents
      * {
      *     // Group
-     *     GROUP_EVENT_ON_MEMBER_ADD               =     1,       // (event, group, guid)
-     *     GROUP_EVENT_ON_MEMBER_INVITE            =     2,       // (event, group, guid)
-     *     GROUP_EVENT_ON_MEMBER_REMOVE            =     3,       // (event, group, guid, method, kicker, reason)
-     *     GROUP_EVENT_ON_LEADER_CHANGE            =     4,       // (event, group, newLeaderGuid, oldLeaderGuid)
-     *     GROUP_EVENT_ON_DISBAND                  =     5,       // (event, group)
-     *     GROUP_EVENT_ON_CREATE                   =     6,       // (event, group, leaderGuid, groupType)
+     *     GROUP_EVENT_ON_MEMBER_ADD               =     1,       // (event, group, guid) - Can be deferred
+     *     GROUP_EVENT_ON_MEMBER_INVITE            =     2,       // (event, group, guid) - Can be deferred
+     *     GROUP_EVENT_ON_MEMBER_REMOVE            =     3,       // (event, group, guid, method, kicker, reason) - Can be deferred
+     *     GROUP_EVENT_ON_LEADER_CHANGE            =     4,       // (event, group, newLeaderGuid, oldLeaderGuid) - Can be deferred
+     *     GROUP_EVENT_ON_DISBAND                  =     5,       // (event, group) - Can be deferred
+     *     GROUP_EVENT_ON_CREATE                   =     6,       // (event, group, leaderGuid, groupType) - Can be deferred
      *
      *     GROUP_EVENT_COUNT
      * };
      * </pre>
      *
+     * Events marked "Can be deferred" accept `deferred`, see [Global:RegisterPlayerEvent] for how deferred handlers are called.
+     *
      * @proto cancel = (event, function)
      * @proto cancel = (event, function, shots)
+     * @proto cancel = (event, function, shots, deferred)
+     * @proto cancel = (event, function, shots, priority)
+     * @proto cancel = (event, function, shots, priority, stop)
      *
      * @param uint32 event : [Group] event Id, refer to GroupEvents above
      * @param function function : function to register
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param bool deferred = false : if `true`, the function is called later from a queue instead of inside the hook
+     * @param int32 priority = 0 : handlers with a higher priority are called first
+     * @param bool stop = false : if `true`, no more handlers are called after this one once the event's result is decided
      *
      * @return function cancel : a function that cancels the binding when called
      */
@@ -820,10 +1151,14 @@ namespace LuaGlobalFunctions
      *
      * @proto cancel = (event, function)
      * @proto cancel = (event, function, shots)
+     * @proto cancel = (event, function, shots, priority)
+     * @proto cancel = (event, function, shots, priority, stop)
      *
      * @param uint32 event : [BattleGround] event Id, refer to BGEvents above
      * @param function function : function to register
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param int32 priority = 0 : handlers with a higher priority are called first
+     * @param bool stop = false : if `true`, no more handlers are called after this one once the event's result is decided
      *
      * @return function cancel : a function that cancels the binding when called
      */
@@ -848,11 +1183,15 @@ namespace LuaGlobalFunctions
      *
      * @proto cancel = (entry, event, function)
      * @proto cancel = (entry, event, function, shots)
+     * @proto cancel = (entry, event, function, shots, priority)
+     * @proto cancel = (entry, event, function, shots, priority, stop)
      *
      * @param uint32 entry : opcode
      * @param uint32 event : packet event Id, refer to PacketEvents above
      * @param function function : function to register
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param int32 priority = 0 : handlers with a higher priority are called first
+     * @param bool stop = false : if `true`, no more handlers are called after this one once the event's result is decided
      *
      * @return function cancel : a function that cancels the binding when called
      */
@@ -875,11 +1214,15 @@ namespace LuaGlobalFunctions
      *
      * @proto cancel = (entry, event, function)
      * @proto cancel = (entry, event, function, shots)
+     * @proto cancel = (entry, event, function, shots, priority)
+     * @proto cancel = (entry, event, function, shots, priority, stop)
      *
      * @param uint32 entry : [Creature] entry Id
      * @param uint32 event : [Creature] gossip event Id, refer to GossipEvents above
      * @param function function : function to register
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param int32 priority = 0 : handlers with a higher priority are called first
+     * @param bool stop = false : if `true`, no more handlers are called after this one once the event's result is decided
      *
      * @return function cancel : a function that cancels the binding when called
      */
@@ -902,11 +1245,15 @@ namespace LuaGlobalFunctions
      *
      * @proto cancel = (entry, event, function)
      * @proto cancel = (entry, event, function, shots)
+     * @proto cancel = (entry, event, function, shots, priority)
+     * @proto cancel = (entry, event, function, shots, priority, stop)
      *
      * @param uint32 entry : [GameObject] entry Id
      * @param uint32 event : [GameObject] gossip event Id, refer to GossipEvents above
      * @param function function : function to register
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param int32 priority = 0 : handlers with a higher priority are called first
+     * @param bool stop = false : if `true`, no more handlers are called after this one once the event's result is decided
      *
      * @return function cancel : a function that cancels the binding when called
      */
@@ -932,11 +1279,15 @@ namespace LuaGlobalFunctions
      *
      * @proto cancel = (entry, event, function)
      * @proto cancel = (entry, event, function, shots)
+     * @proto cancel = (entry, event, function, shots, priority)
+     * @proto cancel = (entry, event, function, shots, priority, stop)
      *
      * @param uint32 entry : [Item] entry Id
      * @param uint32 event : [Item] event Id, refer to ItemEvents above
      * @param function function : function to register
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param int32 priority = 0 : handlers with a higher priority are called first
+     * @param bool stop = false : if `true`, no more handlers are called after this one once the event's result is decided
      *
      * @return function cancel : a function that cancels the binding when called
      */
@@ -959,11 +1310,15 @@ namespace LuaGlobalFunctions
      *
      * @proto cancel = (entry, event, function)
      * @proto cancel = (entry, event, function, shots)
+     * @proto cancel = (entry, event, function, shots, priority)
+     * @proto cancel = (entry, event, function, shots, priority, stop)
      *
      * @param uint32 entry : [Item] entry Id
      * @param uint32 event : [Item] gossip event Id, refer to GossipEvents above
      * @param function function : function to register
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param int32 priority = 0 : handlers with a higher priority are called first
+     * @param bool stop = false : if `true`, no more handlers are called after this one once the event's result is decided
      *
      * @return function cancel : a function that cancels the binding when called
      */
@@ -993,6 +1348,8 @@ namespace LuaGlobalFunctions
      * @param uint32 event : [Map] event ID, refer to MapEvents above
      * @param function function : function to register
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param int32 priority = 0 : handlers with a higher priority are called first
+     * @param bool stop = false : if `true`, no more handlers are called after this one once the event's result is decided
      */
     int RegisterMapEvent(lua_State* L)
     {
@@ -1020,6 +1377,8 @@ namespace LuaGlobalFunctions
      * @param uint32 event : [Map] event ID, refer to MapEvents above
      * @param function function : function to register
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param int32 priority = 0 : handlers with a higher priority are called first
+     * @param bool stop = false : if `true`, no more handlers are called after this one once the event's result is decided
      */
     int RegisterInstanceEvent(lua_State* L)
     {
@@ -1042,11 +1401,15 @@ namespace LuaGlobalFunctions
      *
      * @proto cancel = (menu_id, event, function)
      * @proto cancel = (menu_id, event, function, shots)
+     * @proto cancel = (menu_id, event, function, shots, priority)
+     * @proto cancel = (menu_id, event, function, shots, priority, stop)
      *
      * @param uint32 menu_id : [Player] gossip menu Id
      * @param uint32 event : [Player] gossip event Id, refer to GossipEvents above
      * @param function function : function to register
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param int32 priority = 0 : handlers with a higher priority are called first
+     * @param bool stop = false : if `true`, no more handlers are called after this one once the event's result is decided
      *
      * @return function cancel : a function that cancels the binding when called
      */
@@ -1104,11 +1467,15 @@ namespace LuaGlobalFunctions
      *
      * @proto cancel = (entry, event, function)
      * @proto cancel = (entry, event, function, shots)
+     * @proto cancel = (entry, event, function, shots, priority)
+     * @proto cancel = (entry, event, function, shots, priority, stop)
      *
      * @param uint32 entry : the ID of one or more [Creature]s
      * @param uint32 event : refer to CreatureEvents above
      * @param function function : function that will be called when the event occurs
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param int32 priority = 0 : handlers with a higher priority are called first
+     * @param bool stop = false : if `true`, no more handlers are called after this one once the event's result is decided
      *
      * @return function cancel : a function that cancels the binding when called
      */
@@ -1166,12 +1533,16 @@ namespace LuaGlobalFunctions
      *
      * @proto cancel = (guid, instance_id, event, function)
      * @proto cancel = (guid, instance_id, event, function, shots)
+     * @proto cancel = (guid, instance_id, event, function, shots, priority)
+     * @proto cancel = (guid, instance_id, event, function, shots, priority, stop)
      *
      * @param ObjectGuid guid : the GUID of a single [Creature]
      * @param uint32 instance_id : the instance ID of a single [Creature]
      * @param uint32 event : refer to CreatureEvents above
      * @param function function : function that will be called when the event occurs
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param int32 priority = 0 : handlers with a higher priority are called first
+     * @param bool stop = false : if `true`, no more handlers are called after this one once the event's result is decided
      *
      * @return function cancel : a function that cancels the binding when called
      */
@@ -1206,11 +1577,15 @@ namespace LuaGlobalFunctions
      *
      * @proto cancel = (entry, event, function)
      * @proto cancel = (entry, event, function, shots)
+     * @proto cancel = (entry, event, function, shots, priority)
+     * @proto cancel = (entry, event, function, shots, priority, stop)
      *
      * @param uint32 entry : [GameObject] entry Id
      * @param uint32 event : [GameObject] event Id, refer to GameObjectEvents above
      * @param function function : function to register
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param int32 priority = 0 : handlers with a higher priority are called first
+     * @param bool stop = false : if `true`, no more handlers are called after this one once the event's result is decided
      *
      * @return function cancel : a function that cancels the binding when called
      */
@@ -1237,6 +1612,8 @@ namespace LuaGlobalFunctions
      * @param uint32 event : event ID, refer to UnitEvents above
      * @param function function : function to register
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param int32 priority = 0 : handlers with a higher priority are called first
+     * @param bool stop = false : if `true`, no more handlers are called after this one once the event's result is decided
      */
     int RegisterTicketEvent(lua_State* L)
     {
@@ -1260,6 +1637,8 @@ namespace LuaGlobalFunctions
      * @param uint32 event : event ID, refer to SpellEvents above
      * @param function function : function to register
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param int32 priority = 0 : handlers with a higher priority are called first
+     * @param bool stop = false : if `true`, no more handlers are called after this one once the event's result is decided
      */
     int RegisterSpellEvent(lua_State* L)
     {
@@ -1319,11 +1698,12 @@ namespace LuaGlobalFunctions
             return 0;
         }
 
-        Eluna::GEluna->queryProcessor.AddCallback(db.AsyncQuery(query).WithCallback([L, funcRef](QueryResult result)
+        Eluna* E = Eluna::GetEluna(L);
+        E->queryProcessor.AddCallback(db.AsyncQuery(query).WithCallback([E, L, funcRef](QueryResult result)
             {
                 ElunaQuery* eq = result ? new ElunaQuery(result) : nullptr;
 
-                LOCK_ELUNA;
+                LOCK_ELUNA_STATE(E);
 
                 // Get function
                 lua_rawgeti(L, LUA_REGISTRYINDEX, funcRef);
@@ -1332,7 +1712,7 @@ namespace LuaGlobalFunctions
                 Eluna::Push(L, eq);
 
                 // Call function
-                Eluna::GEluna->ExecuteCall(1, 0);
+                E->ExecuteCall(1, 0);
 
                 luaL_unref(L, LUA_REGISTRYINDEX, funcRef);
             }));
@@ -1822,6 +2202,61 @@ namespace LuaGlobalFunctions
         return 1;
     }
 
+    /**
+     * Creates a [TextMatcher] that finds all of the given words in a text in a single pass.
+     *
+     * Building the matcher takes time, so it should be created once when the script loads and reused.
+     *
+     *     local banned = { "gold seller", "cheap gold", "www." }
+     *     local matcher = CreateTextMatcher(banned, { caseInsensitive = true })
+     *
+     *     RegisterPlayerEvent(18, function(event, player, msg, type, lang)
+     *         if matcher:Test(msg) then
+     *             return matcher:Censor(msg)
+     *         end
+     *     end)
+     *
+     * Supported options:
+     *
+     * <pre>
+     * caseInsensitive : bool, ignore the case of ASCII letters, false by default
+     * </pre>
+     *
+     * @param table words : an array of non-empty strings
+     * @param table options = nil
+     * @return [TextMatcher] matcher
+     */
+    int CreateTextMatcher(lua_State* L)
+    {
+        luaL_checktype(L, 1, LUA_TTABLE);
+        bool caseInsensitive = false;
+        if (!lua_isnoneornil(L, 2))
+        {
+            luaL_checktype(L, 2, LUA_TTABLE);
+            lua_getfield(L, 2, "caseInsensitive");
+            caseInsensitive = lua_toboolean(L, -1) != 0;
+            lua_pop(L, 1);
+        }
+
+        // Pushed before the words are read, so the GC frees the matcher if an invalid word raises an error
+        ElunaTextMatcher* matcher = new ElunaTextMatcher(caseInsensitive);
+        Eluna::Push(L, matcher);
+
+        int count = static_cast<int>(lua_rawlen(L, 1));
+        for (int i = 1; i <= count; ++i)
+        {
+            lua_rawgeti(L, 1, i);
+            size_t length;
+            const char* word = lua_type(L, -1) == LUA_TSTRING ? lua_tolstring(L, -1, &length) : NULL;
+            if (!word || !length)
+                return luaL_argerror(L, 1, "array of non-empty strings expected");
+            matcher->AddWord(word, length);
+            lua_pop(L, 1);
+        }
+        matcher->Build();
+        return 1;
+    }
+
     /**
      * Adds an [Item] to a vendor and updates the world database.
      *
@@ -2533,6 +2968,10 @@ namespace LuaGlobalFunctions
      */
     int HttpRequest(lua_State* L)
     {
+        // Responses are delivered on the world update, so map states can't receive them
+        if (Eluna::GetEluna(L)->GetStateMap())
+            return luaL_error(L, "HttpRequest is only available in the world state");
+
         std::string httpVerb = Eluna::CHECKVAL<std::string>(L, 1);
         std::string url = Eluna::CHECKVAL<std::string>(L, 2);
         std::string body;
@@ -2587,6 +3026,7 @@ namespace LuaGlobalFunctions
      * Returns an object representing a `long long` (64-bit) value.
      *
      * The value by default is 0, but can be initialized to a value by passing a number or long long as a string.
+     * With `Eluna.NativeIntegers` enabled on Lua 5.3 or later the value is a plain Lua integer.
      *
      * @proto value = ()
      * @proto value = (n)
@@ -2619,6 +3059,7 @@ namespace LuaGlobalFunctions
      * Returns an object representing an `unsigned long long` (64-bit) value.
      *
      * The value by default is 0, but can be initialized to a value by passing a number or unsigned long long as a string.
+     * With `Eluna.NativeIntegers` enabled on Lua 5.3 or later the value is a plain Lua integer.
      *
      * @proto value = ()
      * @proto value = (n)
@@ -2872,14 +3313,18 @@ namespace LuaGlobalFunctions
     {
         typedef EventKey<Hooks::GroupEvents> Key;
 
+        Eluna* E = Eluna::GetEluna(L);
+
         if (lua_isnoneornil(L, 1))
         {
-            Eluna::GetEluna(L)->GroupEventBindings->Clear();
+            E->GroupEventBindings->Clear();
+            E->GroupEventDeferredBindings->Clear();
         }
         else
         {
             uint32 event_type = Eluna::CHECKVAL<uint32>(L, 1);
-            Eluna::GetEluna(L)->GroupEventBindings->Clear(Key((Hooks::GroupEvents)event_type));
+            E->GroupEventBindings->Clear(Key((Hooks::GroupEvents)event_type));
+            E->GroupEventDeferredBindings->Clear(Key((Hooks::GroupEvents)event_type));
         }
         return 0;
     }
@@ -2899,14 +3344,18 @@ namespace LuaGlobalFunctions
     {
         typedef EventKey<Hooks::GuildEvents> Key;
 
+        Eluna* E = Eluna::GetEluna(L);
+
         if (lua_isnoneornil(L, 1))
         {
-            Eluna::GetEluna(L)->GuildEventBindings->Clear();
+            E->GuildEventBindings->Clear();
+            E->GuildEventDeferredBindings->Clear();
         }
         else
         {
             uint32 event_type = Eluna::CHECKVAL<uint32>(L, 1);
-            Eluna::GetEluna(L)->GuildEventBindings->Clear(Key((Hooks::GuildEvents)event_type));
+            E->GuildEventBindings->Clear(Key((Hooks::GuildEvents)event_type));
+            E->GuildEventDeferredBindings->Clear(Key((Hooks::GuildEvents)event_type));
         }
         return 0;
     }
@@ -3031,14 +3480,18 @@ namespace LuaGlobalFunctions
     {
         typedef EventKey<Hooks::PlayerEvents> Key;
 
+        Eluna* E = Eluna::GetEluna(L);
+
         if (lua_isnoneornil(L, 1))
         {
-            Eluna::GetEluna(L)->PlayerEventBindings->Clear();
+            E->PlayerEventBindings->Clear();
+            E->PlayerEventDeferredBindings->Clear();
         }
         else
         {
             uint32 event_type = Eluna::CHECKVAL<uint32>(L, 1);
-            Eluna::GetEluna(L)->PlayerEventBindings->Clear(Key((Hooks::PlayerEvents)event_type));
+            E->PlayerEventBindings->Clear(Key((Hooks::PlayerEvents)event_type));
+            E->PlayerEventDeferredBindings->Clear(Key((Hooks::PlayerEvents)event_type));
         }
         return 0;
     }
@@ -3091,14 +3544,46 @@ namespace LuaGlobalFunctions
     {
         typedef EventKey<Hooks::ServerEvents> Key;
 
+        Eluna* E = Eluna::GetEluna(L);
+
         if (lua_isnoneornil(L, 1))
         {
-            Eluna::GetEluna(L)->ServerEventBindings->Clear();
+            E->ServerEventBindings->Clear();
+            E->ServerEventDeferredBindings->Clear();
         }
         else
         {
             uint32 event_type = Eluna::CHECKVAL<uint32>(L, 1);
-            Eluna::GetEluna(L)->ServerEventBindings->Clear(Key((Hooks::ServerEvents)event_type));
+            E->ServerEventBindings->Clear(Key((Hooks::ServerEvents)event_type));
+            E->ServerEventDeferredBindings->Clear(Key((Hooks::ServerEvents)event_type));
+        }
+        return 0;
+    }
+
+    /**
+     * Unbinds addon message handlers for either all prefixes, or one prefix.
+     *
+     * If `prefix` is `nil`, all handlers registered with [Global:RegisterAddonMessageHandler] are cleared.
+     *
+     * Otherwise, only the handlers for `prefix` are cleared.
+     *
+     * @proto ()
+     * @proto (prefix)
+     * @param string prefix : the prefix whose handlers will be cleared
+     */
+    int ClearAddonMessageHandlers(lua_State* L)
+    {
+        typedef PrefixKey<Hooks::ServerEvents> Key;
+
+        Eluna* E = Eluna::GetEluna(L);
+
+        if (lua_isnoneornil(L, 1))
+            E->AddonMessageBindings->Clear();
+        else
+        {
+            size_t length;
+            const char* prefix = luaL_checklstring(L, 1, &length);
+            E->AddonMessageBindings->Clear(Key(Hooks::ADDON_EVENT_ON_MESSAGE, prefix, length));
         }
         return 0;
     }
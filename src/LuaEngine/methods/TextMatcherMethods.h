@@ -0,0 +1,140 @@
+/*
+* Copyright (C) 2010 - 2016 Eluna Lua Engine <http://emudevs.com/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#ifndef TEXTMATCHERMETHODS_H
+#define TEXTMATCHERMETHODS_H
+
+/***
+ * A compiled set of words that texts can be searched for in a single pass, created with [Global:CreateTextMatcher].
+ *
+ * Searching takes time proportional to the length of the text, not to the number of words,
+ *   which makes it suitable for e.g. checking every chat message against a long list of banned phrases.
+ *
+ * Words are identified by their index in the table the matcher was created from.
+ *
+ * Inherits all methods from: none
+ */
+namespace LuaTextMatcher
+{
+    /**
+     * Returns `true` if the text contains any of the words of the [TextMatcher].
+     *
+     * @param string text
+     * @return bool found
+     */
+    int Test(lua_State* L, ElunaTextMatcher* matcher)
+    {
+        size_t length;
+        const char* text = luaL_checklstring(L, 2, &length);
+
+        bool found = false;
+        matcher->Scan(text, length, [&found](uint32 /*index*/, size_t /*start*/, size_t /*end*/)
+        {
+            found = true;
+            return false;
+        });
+
+        Eluna::Push(L, found);
+        return 1;
+    }
+
+    /**
+     * Finds the words of the [TextMatcher] in the text.
+     *
+     * Returns two tables of the same length: the indexes of the found words, and the positions in the text where they start.
+     *   Positions are 1-based like the ones of `string.find`. Overlapping occurrences are all returned, ordered by where they end.
+     *
+     *     local words, positions = matcher:Find(msg)
+     *     for i = 1, #words do
+     *         print(bannedWords[words[i]].." at "..positions[i])
+     *     end
+     *
+     * @param string text
+     * @param uint32 limit = 0 : the most occurrences to return, 0 returns all
+     * @return table words : indexes of the found words
+     * @return table positions : start positions of the found words
+     */
+    int Find(lua_State* L, ElunaTextMatcher* matcher)
+    {
+        size_t length;
+        const char* text = luaL_checklstring(L, 2, &length);
+        uint32 limit = Eluna::CHECKVAL<uint32>(L, 3, 0);
+
+        lua_newtable(L);
+        int words = lua_gettop(L);
+        lua_newtable(L);
+        int positions = lua_gettop(L);
+
+        int count = 0;
+        matcher->Scan(text, length, [&](uint32 index, size_t start, size_t /*end*/)
+        {
+            ++count;
+            Eluna::Push(L, index + 1);
+            lua_rawseti(L, words, count);
+            Eluna::Push(L, static_cast<uint32>(start + 1));
+            lua_rawseti(L, positions, count);
+            return !limit || static_cast<uint32>(count) < limit;
+        });
+
+        return 2;
+    }
+
+    /**
+     * Returns the text with every byte of the found words replaced by `replacement`.
+     *
+     * The result can be returned from chat events to change the message.
+     *
+     * @param string text
+     * @param string replacement = "*" : the character to replace found words with
+     * @return string censored
+     */
+    int Censor(lua_State* L, ElunaTextMatcher* matcher)
+    {
+        size_t length;
+        const char* text = luaL_checklstring(L, 2, &length);
+        const char* replacement = Eluna::CHECKVAL<const char*>(L, 3, "*");
+        if (!*replacement)
+            return luaL_argerror(L, 3, "replacement character expected");
+
+        std::string censored;
+        matcher->Scan(text, length, [&](uint32 /*index*/, size_t start, size_t end)
+        {
+            if (censored.empty())
+                censored.assign(text, length);
+            std::fill(censored.begin() + start, censored.begin() + end, *replacement);
+            return true;
+        });
+
+        if (censored.empty())
+            lua_pushvalue(L, 2);
+        else
+            lua_pushlstring(L, censored.data(), censored.size());
+        return 1;
+    }
+
+    /**
+     * Returns the number of words of the [TextMatcher].
+     *
+     * @return uint32 count
+     */
+    int GetWordCount(lua_State* L, ElunaTextMatcher* matcher)
+    {
+        Eluna::Push(L, matcher->GetWordCount());
+        return 1;
+    }
+
+    /**
+     * Returns `true` if the [TextMatcher] ignores the case of ASCII letters.
+     *
+     * @return bool caseInsensitive
+     */
+    int IsCaseInsensitive(lua_State* L, ElunaTextMatcher* matcher)
+    {
+        Eluna::Push(L, matcher->IsCaseInsensitive());
+        return 1;
+    }
+};
+#endif
@@ -724,6 +724,8 @@ namespace LuaWorldObject
      *
      * Note that for [Creature] and [GameObject] the timed event timer ticks only if the creature is in sight of someone
      * For all [WorldObject]s the timed events are removed when the object is destoryed. This means that for example a [Player]'s events are removed on logout.
+     * With `Eluna.MultiState` the events run in the Lua state of the object's map, and are removed when the object moves to a map with another state,
+     * for example when a [Player] teleports to another map.
      *
      *     local function Timed(eventid, delay, repeats, worldobject)
      *         print(worldobject:GetName())
@@ -763,10 +765,21 @@ namespace LuaWorldObject
         if (min > max)
             return luaL_argerror(L, 3, "min is bigger than max delay");
 
+        // With multiple states the events run in the state of the object's map
+        Eluna* E = Eluna::GetEluna(L);
+        if (Eluna::GetStateFor(obj) != E)
+            return luaL_error(L, "object events can only be registered from the Lua state of the object's map");
+
         lua_pushvalue(L, 2);
         int functionRef = luaL_ref(L, LUA_REGISTRYINDEX);
         if (functionRef != LUA_REFNIL && functionRef != LUA_NOREF)
         {
+            // Most objects never get a timed event, so the processor is only created when needed.
+            // A processor left over from a destroyed state is moved to this one.
+            if (obj->elunaEvents && obj->elunaEvents->GetState() != E)
+                obj->elunaEvents->MoveToState(E);
+            if (!obj->elunaEvents)
+                obj->elunaEvents = new ElunaEventProcessor(E->GetStateHandle(), obj);
             obj->elunaEvents->AddEvent(functionRef, min, max, repeats);
             Eluna::Push(L, functionRef);
         }
@@ -781,7 +794,8 @@ namespace LuaWorldObject
     int RemoveEventById(lua_State* L, WorldObject* obj)
     {
         int eventId = Eluna::CHECKVAL<int>(L, 2);
-        obj->elunaEvents->SetState(eventId, LUAEVENT_STATE_ABORT);
+        if (obj->elunaEvents)
+            obj->elunaEvents->SetState(eventId, LUAEVENT_STATE_ABORT);
         return 0;
     }
 
@@ -791,7 +805,8 @@ namespace LuaWorldObject
      */
     int RemoveEvents(lua_State* /*L*/, WorldObject* obj)
     {
-        obj->elunaEvents->SetStates(LUAEVENT_STATE_ABORT);
+        if (obj->elunaEvents)
+            obj->elunaEvents->SetStates(LUAEVENT_STATE_ABORT);
         return 0;
     }
 
@@ -16,10 +16,98 @@
  *
  * The packet can contain further data, the format of which depends on the opcode.
  *
+ * Packets passed to packet events are read-only views of the server's packet and are only valid during the event.
+ *   Writing to one or setting its opcode turns it into a copy the script owns, the server's packet is not changed.
+ *
  * Inherits all methods from: none
  */
 namespace LuaPacket
 {
+    // Copies a packet view before it is changed, self is at index 1. Returns the packet to change.
+    static WorldPacket* Writable(lua_State* L, WorldPacket* packet)
+    {
+        ElunaObject* obj = static_cast<ElunaObject*>(lua_touserdata(L, 1));
+        if (obj->IsOwner())
+            return packet;
+
+        WorldPacket* copy = new WorldPacket(*packet);
+        obj->Adopt(copy);
+        return copy;
+    }
+
+    // Returns the next field of a Pack/Unpack format at index i, skipping spaces and byte order marks.
+    // Packets are little-endian, so '<' and '=' are accepted and '>' is rejected.
+    static char NextField(lua_State* L, const char* fmt, size_t& i)
+    {
+        for (char c = fmt[i]; c; c = fmt[++i])
+        {
+            switch (c)
+            {
+                case ' ':
+                case '<':
+                case '=':
+                    continue;
+                case 'b': case 'B': case 'h': case 'H': case 'i': case 'I':
+                case 'l': case 'L': case 'f': case 'd': case 'z': case 'G': case 'P':
+                    ++i;
+                    return c;
+                default:
+                    luaL_argerror(L, 2, lua_pushfstring(L, "invalid format option '%c'", c));
+                    return 0;
+            }
+        }
+        return 0;
+    }
+
+    // Checks the value at `arg` and writes it to `packet`, unless that is NULL.
+    template<typename T>
+    static void PackValue(lua_State* L, int arg, WorldPacket* packet)
+    {
+        T value = Eluna::CHECKVAL<T>(L, arg);
+        if (packet)
+            (*packet) << value;
+    }
+
+    // Writes the values of the Pack format `fmt` to `packet`. With a NULL packet the format and values are only checked.
+    static void PackFields(lua_State* L, const char* fmt, WorldPacket* packet)
+    {
+        int arg = 3;
+        size_t i = 0;
+        while (char c = NextField(L, fmt, i))
+        {
+            switch (c)
+            {
+                case 'b': PackValue<int8>(L, arg, packet); break;
+                case 'B': PackValue<uint8>(L, arg, packet); break;
+                case 'h': PackValue<int16>(L, arg, packet); break;
+                case 'H': PackValue<uint16>(L, arg, packet); break;
+                case 'i': PackValue<int32>(L, arg, packet); break;
+                case 'I': PackValue<uint32>(L, arg, packet); break;
+                case 'l': PackValue<int64>(L, arg, packet); break;
+                case 'L': PackValue<uint64>(L, arg, packet); break;
+                case 'f': PackValue<float>(L, arg, packet); break;
+                case 'd': PackValue<double>(L, arg, packet); break;
+                case 'z': PackValue<std::string>(L, arg, packet); break;
+                case 'G': PackValue<ObjectGuid>(L, arg, packet); break;
+                case 'P':
+                {
+                    uint64 guid = Eluna::CHECKVAL<uint64>(L, arg);
+                    if (packet)
+                        packet->appendPackGUID(guid);
+                    break;
+                }
+            }
+            ++arg;
+        }
+    }
+
+    // Raises a Lua error unless n more bytes can be read from the packet.
+    static void CheckReadable(lua_State* L, WorldPacket* packet, size_t n)
+    {
+        if (packet->rpos() > packet->size() || n > packet->size() - packet->rpos())
+            luaL_error(L, "attempt to read %d bytes at position %d of a packet of size %d", (int)n, (int)packet->rpos(), (int)packet->size());
+    }
+
     /**
      * Returns the opcode of the [WorldPacket].
      *
@@ -52,6 +140,7 @@ namespace LuaPacket
         uint32 opcode = Eluna::CHECKVAL<uint32>(L, 2);
         if (opcode >= NUM_MSG_TYPES)
             return luaL_argerror(L, 2, "valid opcode expected");
+        packet = Writable(L, packet);
         packet->SetOpcode((OpcodesList)opcode);
         return 0;
     }
@@ -200,6 +289,96 @@ namespace LuaPacket
         return 1;
     }
 
+    /**
+     * Reads `count` raw bytes from the [WorldPacket] and returns them as a string.
+     *
+     * @param uint32 count : amount of bytes to read
+     * @return string bytes
+     */
+    int ReadBytes(lua_State* L, WorldPacket* packet)
+    {
+        uint32 count = Eluna::CHECKVAL<uint32>(L, 2);
+        CheckReadable(L, packet, count);
+        lua_pushlstring(L, reinterpret_cast<const char*>(packet->contents()) + packet->rpos(), count);
+        packet->read_skip(count);
+        return 1;
+    }
+
+    /**
+     * Reads several values from the [WorldPacket] in one call, as described by the format string, and returns them in order.
+     *
+     * Each character of the format reads one value, spaces are ignored:
+     *
+     * <pre>
+     * b, B : int8, uint8
+     * h, H : int16, uint16
+     * i, I : int32, uint32
+     * l, L : int64, uint64
+     * f, d : float, double
+     * z    : zero terminated string
+     * G    : ObjectGuid
+     * P    : packed GUID, returned as uint64
+     * </pre>
+     *
+     * Packets are little-endian, a leading '<' or '=' is allowed and ignored. An error is raised if the packet is too short.
+     *
+     *     local entry, flags, x, y, z, name = packet:Unpack("<I H f f f z")
+     *
+     * @param string format
+     * @return ... values
+     */
+    int Unpack(lua_State* L, WorldPacket* packet)
+    {
+        const char* fmt = Eluna::CHECKVAL<const char*>(L, 2);
+        int pushed = 0;
+        size_t i = 0;
+        while (char c = NextField(L, fmt, i))
+        {
+            luaL_checkstack(L, 1, "too many values to unpack");
+            switch (c)
+            {
+                case 'b': { int8 v; CheckReadable(L, packet, sizeof(v)); (*packet) >> v; Eluna::Push(L, v); break; }
+                case 'B': { uint8 v; CheckReadable(L, packet, sizeof(v)); (*packet) >> v; Eluna::Push(L, v); break; }
+                case 'h': { int16 v; CheckReadable(L, packet, sizeof(v)); (*packet) >> v; Eluna::Push(L, v); break; }
+                case 'H': { uint16 v; CheckReadable(L, packet, sizeof(v)); (*packet) >> v; Eluna::Push(L, v); break; }
+                case 'i': { int32 v; CheckReadable(L, packet, sizeof(v)); (*packet) >> v; Eluna::Push(L, v); break; }
+                case 'I': { uint32 v; CheckReadable(L, packet, sizeof(v)); (*packet) >> v; Eluna::Push(L, v); break; }
+                case 'l': { int64 v; CheckReadable(L, packet, sizeof(v)); (*packet) >> v; Eluna::Push(L, v); break; }
+                case 'L': { uint64 v; CheckReadable(L, packet, sizeof(v)); (*packet) >> v; Eluna::Push(L, v); break; }
+                case 'f': { float v; CheckReadable(L, packet, sizeof(v)); (*packet) >> v; Eluna::Push(L, v); break; }
+                case 'd': { double v; CheckReadable(L, packet, sizeof(v)); (*packet) >> v; Eluna::Push(L, v); break; }
+                case 'G': { ObjectGuid v; CheckReadable(L, packet, sizeof(uint64)); (*packet) >> v; Eluna::Push(L, v); break; }
+                case 'z':
+                {
+                    CheckReadable(L, packet, 1);
+                    const char* start = reinterpret_cast<const char*>(packet->contents()) + packet->rpos();
+                    const void* end = memchr(start, 0, packet->size() - packet->rpos());
+                    if (!end)
+                        return luaL_error(L, "unterminated string at position %d of the packet", (int)packet->rpos());
+                    size_t len = static_cast<const char*>(end) - start;
+                    lua_pushlstring(L, start, len);
+                    packet->read_skip(len + 1);
+                    break;
+                }
+                case 'P':
+                {
+                    CheckReadable(L, packet, 1);
+                    uint8 mask = packet->contents()[packet->rpos()];
+                    size_t len = 1;
+                    for (uint8 bits = mask; bits; bits >>= 1)
+                        len += bits & 1;
+                    CheckReadable(L, packet, len);
+                    uint64 v;
+                    packet->readPackGUID(v);
+                    Eluna::Push(L, v);
+                    break;
+                }
+            }
+            ++pushed;
+        }
+        return pushed;
+    }
+
     /**
      * Writes an unsigned 64-bit integer value to the [WorldPacket].
      *
@@ -208,6 +387,7 @@ namespace LuaPacket
     int WriteGUID(lua_State* L, WorldPacket* packet)
     {
         ObjectGuid guid = Eluna::CHECKVAL<ObjectGuid>(L, 2);
+        packet = Writable(L, packet);
         (*packet) << guid;
         return 0;
     }
@@ -220,6 +400,7 @@ namespace LuaPacket
     int WriteString(lua_State* L, WorldPacket* packet)
     {
         std::string _val = Eluna::CHECKVAL<std::string>(L, 2);
+        packet = Writable(L, packet);
         (*packet) << _val;
         return 0;
     }
@@ -232,6 +413,7 @@ namespace LuaPacket
     int WriteByte(lua_State* L, WorldPacket* packet)
     {
         int8 byte = Eluna::CHECKVAL<int8>(L, 2);
+        packet = Writable(L, packet);
         (*packet) << byte;
         return 0;
     }
@@ -244,6 +426,7 @@ namespace LuaPacket
     int WriteUByte(lua_State* L, WorldPacket* packet)
     {
         uint8 byte = Eluna::CHECKVAL<uint8>(L, 2);
+        packet = Writable(L, packet);
         (*packet) << byte;
         return 0;
     }
@@ -256,6 +439,7 @@ namespace LuaPacket
     int WriteShort(lua_State* L, WorldPacket* packet)
     {
         int16 _short = Eluna::CHECKVAL<int16>(L, 2);
+        packet = Writable(L, packet);
         (*packet) << _short;
         return 0;
     }
@@ -268,6 +452,7 @@ namespace LuaPacket
     int WriteUShort(lua_State* L, WorldPacket* packet)
     {
         uint16 _ushort = Eluna::CHECKVAL<uint16>(L, 2);
+        packet = Writable(L, packet);
         (*packet) << _ushort;
         return 0;
     }
@@ -280,6 +465,7 @@ namespace LuaPacket
     int WriteLong(lua_State* L, WorldPacket* packet)
     {
         int32 _long = Eluna::CHECKVAL<int32>(L, 2);
+        packet = Writable(L, packet);
         (*packet) << _long;
         return 0;
     }
@@ -292,6 +478,7 @@ namespace LuaPacket
     int WriteULong(lua_State* L, WorldPacket* packet)
     {
         uint32 _ulong = Eluna::CHECKVAL<uint32>(L, 2);
+        packet = Writable(L, packet);
         (*packet) << _ulong;
         return 0;
     }
@@ -304,6 +491,7 @@ namespace LuaPacket
     int WriteFloat(lua_State* L, WorldPacket* packet)
     {
         float _val = Eluna::CHECKVAL<float>(L, 2);
+        packet = Writable(L, packet);
         (*packet) << _val;
         return 0;
     }
@@ -316,9 +504,45 @@ namespace LuaPacket
     int WriteDouble(lua_State* L, WorldPacket* packet)
     {
         double _val = Eluna::CHECKVAL<double>(L, 2);
+        packet = Writable(L, packet);
         (*packet) << _val;
         return 0;
     }
+
+    /**
+     * Writes the raw bytes of a string to the [WorldPacket], without a terminating zero.
+     *
+     * @param string bytes : the bytes to be written to the [WorldPacket]
+     */
+    int WriteBytes(lua_State* L, WorldPacket* packet)
+    {
+        size_t len;
+        const char* bytes = luaL_checklstring(L, 2, &len);
+        packet = Writable(L, packet);
+        if (len)
+            packet->append(reinterpret_cast<const uint8*>(bytes), len);
+        return 0;
+    }
+
+    /**
+     * Writes several values to the [WorldPacket] in one call, as described by the format string.
+     *
+     * Uses the same format as [WorldPacket:Unpack], with one value argument for each format character.
+     *
+     *     packet:Pack("<I H f f f z", entry, flags, x, y, z, name)
+     *
+     * @param string format
+     * @param ... values : the values to be written to the [WorldPacket]
+     */
+    int Pack(lua_State* L, WorldPacket* packet)
+    {
+        const char* fmt = Eluna::CHECKVAL<const char*>(L, 2);
+
+        // Every field is checked before anything is written, an error must not leave the packet half-written
+        PackFields(L, fmt, NULL);
+        PackFields(L, fmt, Writable(L, packet));
+        return 0;
+    }
 };
 
 #endif